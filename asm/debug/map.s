@@ -10,8 +10,12 @@ glabel gMapStrings
 .incbin "bin/name.bin"
 glabel gMapStringsEnd
 
+.balign 16
+glabel gMapBuckets
+.incbin "bin/bucket.bin"
+
 .balign 16
 glabel gMapEntrySize
-.word (gMapEntryEnd - gMapEntries) / 4
+.word (gMapEntryEnd - gMapEntries) / 8
 glabel gMapStringSize
 .word (gMapStringsEnd - gMapStrings)
@@ -50,3 +50,12 @@
  * Reverb presets can be configured in audio/data.c to meet desired aesthetic/performance needs. More detailed usage info can also be found on the HackerSM64 Wiki page.
  */
 // #define BETTER_REVERB
+
+/**
+ * Runs the BETTER_REVERB filters on the RSP, with a command added to the audio microcode, rather than on the CPU.
+ * Only used with presets that aren't lightweight, have a downsample rate of 1 and delays that are multiples of 4 larger than 64,
+ * and only on console and on emulators that run the audio microcode itself (ares, simple64, CEN64), since HLE audio doesn't know the command.
+ * Presets with a gain index outside 1-255 or a reverb index outside 0-255 also stay on the CPU, as the command can't represent them.
+ * Everything else keeps running on the CPU. This hasn't been tested on console or in an LLE emulator yet, so it's disabled by default.
+ */
+// #define BETTER_REVERB_RSP
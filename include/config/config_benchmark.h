@@ -15,3 +15,23 @@
     #define ENABLE_VANILLA_LEVEL_SPECIFIC_CHECKS
     #define TEST_LEVEL LEVEL_CASTLE_GROUNDS
 #endif
+
+/**
+ * Records player 1's controller input every frame from boot, with the analog stick as read from the controller (before the deadzone).
+ * Hold L + R + Z to stop recording, which prints the recording over ISV/UNF as the contents of src/game/input_replay/recording.inc.c.
+ * Set TEST_LEVEL to record from a level, and start from a fresh save file so the replay can start from the same one.
+ * Requires building with ISVPRINT=1 or UNF=1.
+ */
+// #define ENABLE_INPUT_RECORDING
+
+/**
+ * Replays src/game/input_replay/recording.inc.c from boot, with the same TEST_LEVEL and random seed it was recorded with.
+ * Once the recording ends, the CPU, RSP and RDP time of every frame is printed over ISV/UNF as CSV.
+ * Requires building with ISVPRINT=1 or UNF=1.
+ */
+// #define ENABLE_INPUT_REPLAY_BENCHMARK
+
+/**
+ * The random seed the game starts with when recording inputs.
+ */
+#define INPUT_RECORDING_SEED 0x0000
@@ -26,6 +26,65 @@
  */
 #define MAX_REFERENCED_WALLS 4
 
+/**
+ * Uses a per-frame broadphase for object hitbox detection, so that only objects whose hitboxes share a slice of
+ * the level on both the X and Z axes are tested against each other. The pair order is identical to vanilla.
+ * OBJECT_COLLISION_BROADPHASE_SLICES is the number of slices per axis across the level boundaries.
+ */
+// #define OBJECT_COLLISION_BROADPHASE
+#define OBJECT_COLLISION_BROADPHASE_SLICES 64
+
+/**
+ * Static collision cells that hold more than this many surfaces of one kind (floors, walls, ceilings or water) are split
+ * into a grid of STATIC_SURFACE_SUBDIVISIONS x STATIC_SURFACE_SUBDIVISIONS smaller cells when the area loads.
+ * Collision queries that fit inside one of the smaller cells only walk its surfaces.
+ * STATIC_SURFACE_SUBDIVISIONS must divide CELL_SIZE evenly.
+ */
+// #define STATIC_SURFACE_SUBDIVISION_THRESHOLD 24
+#define STATIC_SURFACE_SUBDIVISIONS 4
+
+/**
+ * Static floor, ceiling and wall lists (of a cell or subcell) that hold more than this many surfaces are split into
+ * horizontal bands of STATIC_SURFACE_BAND_HEIGHT units when the area loads, so that a query only walks the surfaces
+ * that can reach its height. Floors and ceilings start their walk past the surfaces that are out of reach, walls
+ * get a list of their own for each band. Helps the most in tall levels, where surfaces at unrelated heights share
+ * cells. The collision page of puppyprint shows how many surfaces were skipped.
+ */
+// #define STATIC_SURFACE_BAND_THRESHOLD 16
+#define STATIC_SURFACE_BAND_HEIGHT 512
+
+/**
+ * Areas whose level script provides TERRAIN_BAKED load their static collision from an image baked at build time by
+ * tools/collision_baker.py, so surfaces no longer have to be computed and sorted into the cells when the area loads.
+ * The images are kept in ROM and DMA'd straight into the static surface pool, so they take no RAM of their own.
+ * Images baked for different collision settings are ignored, and the area is loaded from its TERRAIN data as usual.
+ */
+// #define BAKED_STATIC_COLLISION
+
+/**
+ * Areas whose level script provides ROOM_VISIBILITY use a table of which rooms can be seen from each room, generated
+ * from the level's collision and room data by tools/room_pvs.py. Rooms that can't be seen from Mario's room are skipped
+ * when rendering (see GEO_ROOM_NODE_START), and the objects in them aren't updated.
+ */
+// #define ROOM_VISIBILITY
+
+/**
+ * Keeps the surfaces of objects with collision between frames instead of rebuilding them all every frame.
+ * An object's surfaces are only recomputed and relinked when its transform, scale or collision model changes,
+ * and are removed once it stops loading its collision, e.g. when Mario leaves its collision distance.
+ * Saves a lot of collision time in levels with many idle platforms, but costs about 23 KB of RAM for the cache.
+ * The collision page of puppyprint shows how many objects were rebuilt and reused each frame.
+ */
+// #define PERSISTENT_DYNAMIC_SURFACES
+
+/**
+ * Objects with OBJ_FLAG_LOCAL_SPACE_COLLISION keep their collision model in model space, built once per model and scale,
+ * instead of transforming every vertex into the dynamic partition each frame. Floor, ceiling, wall and ray queries
+ * move the query into the space of each of those objects whose bounds it overlaps. Meant for large rotating platforms.
+ * Only objects that are upright (rotated about the Y axis alone) are handled this way, others are loaded as usual.
+ */
+// #define LOCAL_SPACE_OBJECT_COLLISION
+
 /**
  * Collision data is the type that the collision system uses. All data by default is stored as an s16, but you may change it to s32.
  * Naturally, that would double the size of all collision data, but would allow you to use 32 bit values instead of 16.
@@ -24,6 +24,28 @@
  */
 #define USE_PROFILER
 
+/**
+ * Streams the profiler's samples of every frame over ISV/UNF, along with the object count and graphics pool usage.
+ * Records are sent in batches of PROFILER_EXPORT_BATCH_FRAMES frames, decode them with tools/profiler_export.py.
+ * Sending a batch over ISV takes long enough to show up in the frame it's sent on.
+ * Requires USE_PROFILER, and building with ISVPRINT=1 or UNF=1.
+ */
+// #define PROFILER_EXPORT
+#define PROFILER_EXPORT_BATCH_FRAMES 30
+
+/**
+ * Times the code between PROFILER_ZONE_BEGIN/PROFILER_ZONE_END (or in a PROFILER_ZONE scope) as nested, named zones.
+ * The Zones page in PUPPYPRINT_DEBUG shows the zones with the highest self and inclusive time. Requires USE_PROFILER.
+ */
+// #define PROFILER_ZONES
+
+/**
+ * Times cur_obj_update for every behavior, and counts how many objects with that behavior were updated.
+ * The Behaviors page in PUPPYPRINT_DEBUG shows the behaviors that took the most time, and PROFILER_EXPORT sends them with each batch.
+ * Requires USE_PROFILER.
+ */
+// #define PROFILER_BEHAVIORS
+
 /**
  * -- TEST LEVEL --
  * Uncomment this define and set a test level in order to boot straight into said level.
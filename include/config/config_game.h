@@ -98,3 +98,23 @@
  * The levelscript needs to have a MARIO_POS command for this to work.
  */
 #define START_LEVEL LEVEL_CASTLE_GROUNDS
+
+/**
+ * Decodes each behavior script into an array of handlers with their arguments the first time an object runs it,
+ * instead of decoding every command each frame. Scripts that can't be decoded (too long, or too many for the
+ * buffers in behavior_script.c) are interpreted as usual. Both run the exact same behavior.
+ */
+// #define PREDECODE_BEHAVIORS
+
+/**
+ * Updates objects far from Mario less often: every other frame past OBJECT_UPDATE_LOD_HALF_DIST, and every fourth
+ * frame past OBJECT_UPDATE_LOD_QUARTER_DIST, with their updates spread out across frames.
+ * A throttled update covers all the frames since the last one: oTimer advances by that many frames, and the common
+ * object movement functions move that many frames' worth. Behaviors that check oTimer for exact values, or move in
+ * their own code, should set OBJ_FLAG_UPDATE_EVERY_FRAME.
+ * Only objects that compute their distance to Mario are throttled. Mario, held objects, objects with collision
+ * and objects with OBJ_FLAG_ACTIVE_FROM_AFAR are always updated every frame.
+ */
+// #define OBJECT_UPDATE_LOD
+#define OBJECT_UPDATE_LOD_HALF_DIST    4000.0f
+#define OBJECT_UPDATE_LOD_QUARTER_DIST 8000.0f
@@ -146,6 +146,34 @@
  */
 // #define POLISHED_TRANSITIONS
 
+/**
+ * Decodes each (animation, frame) pair at most once per rendered frame and reuses the joint rotations
+ * for every other object playing the same animation on the same frame (crowds of enemies, coins, etc.).
+ * Hits and misses are shown on the Puppyprint "Rendering" page.
+ */
+// #define ANIMATION_POSE_CACHE
+
+/**
+ * Sorts the display lists of the z-buffered opaque and alpha layers by display list before they're emitted,
+ * so instances of the same model are drawn back to back and the RDP reloads textures and combiners less often.
+ * Matrix loads are also skipped when consecutive nodes share a transform.
+ * NOTE: Display lists on these layers must not leave the modelview matrix changed (push/pop is fine).
+ */
+// #define SORT_DISPLAY_LISTS
+
+/**
+ * Lets geo layouts mark level geometry as static with GEO_STATIC_NODE_START. Translation, rotation and scale
+ * nodes inside such a subtree build their matrices once when the geo layout is loaded instead of every frame.
+ */
+// #define STATIC_GEO_MATRICES
+
+/**
+ * Culls display list nodes of area geo layouts (GEO_DISPLAY_LIST under a GEO_CAMERA) against the view frustum,
+ * like objects are. Each node's bounding sphere is computed from its vertices when the geo layout is loaded.
+ * Follows the same emulator rules as object culling (see CULLING_ON_EMULATOR).
+ */
+// #define LEVEL_GEOMETRY_CULLING
+
 /**
  * Uses frustratio of 2 instead of 1.
  * Can improve performance in some circumstances, though it can also cause large tris to warp if cut off from the camera.
@@ -49,6 +49,10 @@
     #undef BETTER_REVERB
 #endif
 
+#ifndef BETTER_REVERB
+    #undef BETTER_REVERB_RSP
+#endif
+
 /*****************
  * config_debug.h
  */
@@ -56,6 +60,9 @@
 #ifdef DISABLE_ALL
     #undef DEBUG_ALL
     #undef USE_PROFILER
+    #undef PROFILER_EXPORT
+    #undef PROFILER_ZONES
+    #undef PROFILER_BEHAVIORS
     #undef TEST_LEVEL
     #undef DEBUG_LEVEL_SELECT
     #undef ENABLE_DEBUG_FREE_MOVE
@@ -117,6 +124,24 @@
     #define DEBUG_ASSERTIONS
 #endif // DEBUG
 
+#ifndef USE_PROFILER
+    #undef PROFILER_EXPORT
+    #undef PROFILER_ZONES
+    #undef PROFILER_BEHAVIORS
+#endif // !USE_PROFILER
+
+
+/*****************
+ * config_benchmark.h
+ */
+
+#ifdef ENABLE_INPUT_REPLAY_BENCHMARK
+    #undef ENABLE_INPUT_RECORDING // Replaying overrides the inputs that would be recorded.
+
+    #undef USE_PROFILER
+    #define USE_PROFILER
+#endif // ENABLE_INPUT_REPLAY_BENCHMARK
+
 
 /*****************
  * config_camera.h
@@ -170,6 +170,30 @@ enum GeoLayoutCommands {
 #define GEO_NODE_START() \
     CMD_BBH(GEO_CMD_NODE_START, 0x00, 0x0000)
 
+enum GeoStartFlags {
+    GEO_START_FLAG_STATIC = (1 << 0),
+    GEO_START_FLAG_ROOM   = (1 << 1),
+};
+
+/**
+ * 0x0B: Create a start node whose subtree never moves relative to the camera node (level geometry)
+ *   0x01: GEO_START_FLAG_STATIC
+ *   0x02-0x03: unused
+ * Translation, rotation and scale nodes inside it precompute their matrices at load (see STATIC_GEO_MATRICES).
+ * Must not be used inside objects, or below any node that moves its children.
+ */
+#define GEO_STATIC_NODE_START() \
+    CMD_BBH(GEO_CMD_NODE_START, GEO_START_FLAG_STATIC, 0x0000)
+
+/**
+ * 0x0B: Create a start node whose children belong to a surface room
+ *   0x01: GEO_START_FLAG_ROOM
+ *   0x02: s16 room
+ * The children are skipped while the room can't be seen from Mario's room (see ROOM_VISIBILITY).
+ */
+#define GEO_ROOM_NODE_START(room) \
+    CMD_BBH(GEO_CMD_NODE_START, GEO_START_FLAG_ROOM, room)
+
 /**
  * 0x0C: Create zbuffer-toggling scene graph node
  *   0x01: u8 enableZBuffer (1 = on, 0 = off)
@@ -54,6 +54,7 @@ extern int	flush_window(void);
 //
 //
 u32   expand_gzip(u8 *src_addr, u8 *dst_addr, u32 size, u32 outbytes_limit);
+s32   expand_gzip_stream(u8 *(*read_func)(u32 *length), u8 *dst_addr, u32 outbytes_limit);
 
 
 #endif
@@ -50,7 +50,7 @@
 #define A_SAVEBUFF              6
 #define A_SEGMENT               7
 #define A_SETVOL                9
-#define A_POLEF                 14
+#define A_REVERB                14
 
 #else
 
@@ -353,14 +353,20 @@ typedef short ENVMIX_STATE[40];
 }
 
 /*
- * Not used in SM64.
+ * Runs the BETTER_REVERB all-pass filters over a part of a reverb ring buffer.
+ * Not in the original microcode; replaces the unused pole filter command.
+ *
+ * s is the address of a 0x90 byte parameter block, see struct ReverbRspParams
+ * in src/audio/synthesis.c. It holds the sample count, the gain and multiplier
+ * coefficients, and the RDRAM buffer, position and size of the ring buffer and
+ * every delay line. The block is only read, so the CPU advances the delay
+ * line positions itself, but it must be left alone until the task has run.
  */
-#define aPoleFilter(pkt, f, g, s)                                       \
+#define aReverb(pkt, s)                                                 \
 {                                                                       \
         Acmd *_a = (Acmd *)pkt;                                         \
                                                                         \
-        _a->words.w0 = (_SHIFTL(A_POLEF, 24, 8) | _SHIFTL(f, 16, 8) |   \
-                        _SHIFTL(g, 0, 16));                             \
+        _a->words.w0 = _SHIFTL(A_REVERB, 24, 8);                        \
         _a->words.w1 = (uintptr_t)(s);                                  \
 }
 
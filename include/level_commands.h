@@ -71,6 +71,8 @@ enum LevelCommands {
     /*0x3D*/ LEVEL_CMD_PUPPYVOLUME,
     /*0x3E*/ LEVEL_CMD_CHANGE_AREA_SKYBOX,
     /*0x3F*/ LEVEL_CMD_SET_ECHO,
+    /*0x40*/ LEVEL_CMD_SET_BAKED_TERRAIN_DATA,
+    /*0x41*/ LEVEL_CMD_SET_ROOM_VISIBILITY,
 };
 
 enum LevelActs {
@@ -395,10 +397,28 @@ enum GoddardScene {
     CMD_BBH(LEVEL_CMD_SET_TERRAIN_DATA, 0x08, 0x0000), \
     CMD_PTR(terrainData)
 
+#ifdef BAKED_STATIC_COLLISION
+#define TERRAIN_BAKED(bakedTerrain) \
+    CMD_BBH(LEVEL_CMD_SET_BAKED_TERRAIN_DATA, 0x08, 0x0000), \
+    CMD_PTR(bakedTerrain)
+#else
+#define TERRAIN_BAKED(bakedTerrain) \
+    CMD_BBH(LEVEL_CMD_NOP, 0x04, 0x0000)
+#endif
+
 #define ROOMS(surfaceRooms) \
     CMD_BBH(LEVEL_CMD_SET_ROOMS, 0x08, 0x0000), \
     CMD_PTR(surfaceRooms)
 
+#ifdef ROOM_VISIBILITY
+#define ROOM_VISIBILITY_TABLE(roomVisibility) \
+    CMD_BBH(LEVEL_CMD_SET_ROOM_VISIBILITY, 0x08, 0x0000), \
+    CMD_PTR(roomVisibility)
+#else
+#define ROOM_VISIBILITY_TABLE(roomVisibility) \
+    CMD_BBH(LEVEL_CMD_NOP, 0x04, 0x0000)
+#endif
+
 #define SHOW_DIALOG(index, dialogId) \
     CMD_BBBB(LEVEL_CMD_SHOW_DIALOG, 0x04, index, dialogId)
 
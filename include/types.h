@@ -260,6 +260,15 @@ struct ObjectNode {
 // whether some of these pointers point to ObjectNode or Object.
 #define MAX_OBJECT_FIELDS 0x50
 
+/**
+ * Remembers the static floor a caller found last, see find_floor_cached.
+ * Zeroed handles are empty, and handles are emptied by loading another area.
+ */
+struct FloorCache {
+    /*0x00*/ s16 index; // The floor's index in gStaticFloorLinks
+    /*0x02*/ u16 generation; // gStaticFloorLinksGeneration when the floor was found
+};
+
 struct Object {
     /*0x000*/ struct ObjectNode header;
     /*0x068*/ struct Object *parentObj;
@@ -300,7 +309,7 @@ struct Object {
         const void *asConstVoidPtr[MAX_OBJECT_FIELDS];
     } ptrData;
 #endif
-    /*0x1C8*/ u32 unused1;
+    /*0x1C8*/ const struct BhvInstr *curBhvInstr; // Pre-decoded curBhvCommand, see PREDECODE_BEHAVIORS
     /*0x1CC*/ const BehaviorScript *curBhvCommand;
     /*0x1D0*/ u32 bhvStackIndex;
     /*0x1D4*/ uintptr_t bhvStack[8];
@@ -312,11 +321,12 @@ struct Object {
     /*0x204*/ f32 hurtboxHeight;
     /*0x208*/ f32 hitboxDownOffset;
     /*0x20C*/ const BehaviorScript *behavior;
-    /*0x210*/ u32 unused2;
+    /*0x210*/ u32 lastUpdateTimer; // gGlobalTimer of the object's last update, see OBJECT_UPDATE_LOD
     /*0x214*/ struct Object *platform;
     /*0x218*/ void *collisionData;
     /*0x21C*/ Mat4 transform;
     /*0x25C*/ void *respawnInfo;
+    /*0x260*/ struct FloorCache floorCache;
 };
 
 struct ObjectHitbox {
@@ -357,6 +367,51 @@ struct Surface {
     /*0x2C*/ struct Object *object;
 };
 
+/**
+ * Static collision prebaked by tools/collision_baker.py, see BAKED_STATIC_COLLISION.
+ * Each list is a run of entries in nodes, which are indices into surfaces.
+ * Images are linked into the bakedCollision segment, so the header and every pointer in it are ROM addresses.
+ */
+#define BAKED_COLLISION_VERSION 1
+
+enum BakedCollisionFlags {
+    BAKED_COLLISION_FLAG_NEEDS_SURFACE_FORCE = (1 << 0), // Only loads correctly with ALL_SURFACES_HAVE_FORCE
+    BAKED_COLLISION_FLAG_HAS_DEGENERATE_TRIS = (1 << 1), // Only loads correctly with ENABLE_VANILLA_LEVEL_SPECIFIC_CHECKS
+};
+
+struct BakedSurfaceList {
+    /*0x00*/ u8 cellX;
+    /*0x01*/ u8 cellZ;
+    /*0x02*/ u8 partition;
+    /*0x04*/ u16 numNodes;
+    /*0x08*/ u32 firstNode;
+};
+
+struct BakedCollision {
+    /*0x00*/ u16 version;
+    /*0x02*/ u16 flags;
+    /*0x04*/ s16 cellSize;
+    /*0x06*/ s16 numCells;
+    /*0x08*/ u16 numTris;
+    /*0x0A*/ u16 numSurfaces;
+    /*0x0C*/ u32 numLists;
+    /*0x10*/ u32 numNodes;
+    /*0x14*/ const struct Surface *surfaces;
+    /*0x18*/ const u16 *surfaceTris; // Triangle index of each surface, for looking up its room
+    /*0x1C*/ const struct BakedSurfaceList *lists;
+    /*0x20*/ const u16 *nodes;
+};
+
+/**
+ * Potentially visible set of a roomed area, generated by tools/room_pvs.py, see ROOM_VISIBILITY.
+ * Row n of masks has a bit set for every room visible from room n. Row 0 is for no room and has every bit set.
+ */
+struct RoomVisibility {
+    /*0x00*/ u16 numRooms;
+    /*0x02*/ u16 wordsPerRoom;
+    /*0x04*/ const u32 *masks;
+};
+
 #define PUNCH_STATE_TIMER_MASK          0b00111111
 #define PUNCH_STATE_TYPES_MASK          0b11000000
 
@@ -459,6 +514,7 @@ struct MarioState {
              s16 moveYaw;
              s16 ceilYaw;
              s16 wallYaw;
+    struct FloorCache floorCache;
     // -- HackerSM64 MarioState fields end --
 };
 
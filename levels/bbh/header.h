@@ -96,7 +96,9 @@ extern const Gfx bbh_seg7_dl_0701FFE8[];
 extern const Gfx bbh_seg7_dl_070202F0[];
 extern const Gfx bbh_seg7_dl_070206F0[];
 extern const Collision bbh_seg7_collision_level[];
+extern const struct BakedCollision bbh_seg7_collision_level_baked;
 extern const RoomData bbh_seg7_rooms[];
+extern const struct RoomVisibility bbh_seg7_rooms_visibility;
 extern const MacroObject bbh_seg7_macro_objs[];
 extern const Collision bbh_seg7_collision_staircase_step[];
 extern const Collision bbh_seg7_collision_tilt_floor_platform[];
@@ -59,6 +59,7 @@
 #include "levels/bbh/coffin/model.inc.c"
 #include "levels/bbh/areas/1/collision.inc.c"
 #include "levels/bbh/areas/1/room.inc.c"
+#include "levels/bbh/areas/1/room.pvs.inc.c"
 #include "levels/bbh/areas/1/macro.inc.c"
 #include "levels/bbh/staircase_step/collision.inc.c"
 #include "levels/bbh/tilting_trap_platform/collision.inc.c"
@@ -112,8 +112,10 @@ const LevelScript level_bbh_entry[] = {
         WARP_NODE(/*id*/ 0xF0, /*destLevel*/ LEVEL_CASTLE_COURTYARD, /*destArea*/ 0x01, /*destNode*/ 0x0A, /*flags*/ WARP_NO_CHECKPOINT),
         WARP_NODE(/*id*/ 0xF1, /*destLevel*/ LEVEL_CASTLE_COURTYARD, /*destArea*/ 0x01, /*destNode*/ 0x0B, /*flags*/ WARP_NO_CHECKPOINT),
         TERRAIN(/*terrainData*/ bbh_seg7_collision_level),
+        TERRAIN_BAKED(/*bakedTerrain*/ &bbh_seg7_collision_level_baked),
         MACRO_OBJECTS(/*objList*/ bbh_seg7_macro_objs),
         ROOMS(/*surfaceRooms*/ bbh_seg7_rooms),
+        ROOM_VISIBILITY_TABLE(/*roomVisibility*/ &bbh_seg7_rooms_visibility),
         SHOW_DIALOG(/*index*/ 0x00, DIALOG_098),
         SET_BACKGROUND_MUSIC(/*settingsPreset*/ 0x0006, /*seq*/ SEQ_LEVEL_SPOOKY),
         TERRAIN_TYPE(/*terrainType*/ TERRAIN_SPOOKY),
@@ -59,6 +59,7 @@ extern const Gfx bitdw_seg7_dl_0700CC00[];
 extern const Gfx bitdw_seg7_dl_0700D190[];
 extern const Gfx bitdw_seg7_dl_0700D3E8[];
 extern const Collision bitdw_seg7_collision_level[];
+extern const struct BakedCollision bitdw_seg7_collision_level_baked;
 extern const MacroObject bitdw_seg7_macro_objs[];
 extern const Collision bitdw_seg7_collision_0700F688[];
 extern const Collision bitdw_seg7_collision_0700F70C[];
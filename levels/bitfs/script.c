@@ -111,6 +111,7 @@ const LevelScript level_bitfs_entry[] = {
         JUMP_LINK(script_func_local_2),
         JUMP_LINK(script_func_local_3),
         TERRAIN(/*terrainData*/ bitfs_seg7_collision_level),
+        TERRAIN_BAKED(/*bakedTerrain*/ &bitfs_seg7_collision_level_baked),
         MACRO_OBJECTS(/*objList*/ bitfs_seg7_macro_objs),
         SET_BACKGROUND_MUSIC(/*settingsPreset*/ 0x0000, /*seq*/ SEQ_LEVEL_KOOPA_ROAD),
         TERRAIN_TYPE(/*terrainType*/ TERRAIN_STONE),
@@ -100,6 +100,7 @@ const LevelScript level_bits_entry[] = {
         JUMP_LINK(script_func_local_1),
         JUMP_LINK(script_func_local_2),
         TERRAIN(/*terrainData*/ bits_seg7_collision_level),
+        TERRAIN_BAKED(/*bakedTerrain*/ &bits_seg7_collision_level_baked),
         MACRO_OBJECTS(/*objList*/ bits_seg7_macro_objs),
         SET_BACKGROUND_MUSIC(/*settingsPreset*/ 0x0000, /*seq*/ SEQ_LEVEL_KOOPA_ROAD),
         TERRAIN_TYPE(/*terrainType*/ TERRAIN_STONE),
@@ -20,6 +20,7 @@ extern const Gfx bob_seg7_dl_0700E458[];
 extern const Gfx bob_seg7_dl_0700E768[];
 extern const Gfx bob_seg7_dl_0700E8A0[];
 extern const Collision bob_seg7_collision_level[];
+extern const struct BakedCollision bob_seg7_collision_level_baked;
 extern const MacroObject bob_seg7_macro_objs[];
 extern const Collision bob_seg7_collision_chain_chomp_gate[];
 extern const Collision bob_seg7_collision_bridge[];
@@ -12,6 +12,7 @@ extern const Gfx bowser_2_seg7_dl_07000D30[];
 extern const Gfx bowser_2_seg7_dl_07000FE0[];
 extern const Gfx bowser_2_seg7_dl_07001930[];
 extern const Collision bowser_2_seg7_collision_lava[];
+extern const struct BakedCollision bowser_2_seg7_collision_lava_baked;
 extern const Collision bowser_2_seg7_collision_tilting_platform[];
 
 // script
@@ -44,6 +44,7 @@ const LevelScript level_bowser_2_entry[] = {
         WARP_NODE(/*id*/ 0xF1, /*destLevel*/ LEVEL_BITFS, /*destArea*/ 0x01, /*destNode*/ 0x0C, /*flags*/ WARP_NO_CHECKPOINT),
         JUMP_LINK(script_func_local_1),
         TERRAIN(/*terrainData*/ bowser_2_seg7_collision_lava),
+        TERRAIN_BAKED(/*bakedTerrain*/ &bowser_2_seg7_collision_lava_baked),
         SET_BACKGROUND_MUSIC(/*settingsPreset*/ 0x0002, /*seq*/ SEQ_LEVEL_BOSS_KOOPA),
         TERRAIN_TYPE(/*terrainType*/ TERRAIN_STONE),
     END_AREA(),
@@ -31,6 +31,7 @@ extern const Gfx bowser_3_seg7_dl_07003FA0[];
 extern const Gfx bowser_3_seg7_dl_070046B0[];
 extern const Gfx bowser_3_seg7_dl_07004958[];
 extern const Collision bowser_3_seg7_collision_level[];
+extern const struct BakedCollision bowser_3_seg7_collision_level_baked;
 extern const Collision bowser_3_seg7_collision_07004B94[];
 extern const Collision bowser_3_seg7_collision_07004C18[];
 extern const Collision bowser_3_seg7_collision_07004C9C[];
@@ -14,6 +14,7 @@ extern const Gfx castle_courtyard_seg7_dl_07005078[];
 extern const Gfx castle_courtyard_seg7_dl_07005698[];
 extern const Gfx castle_courtyard_seg7_dl_07005938[];
 extern const Collision castle_courtyard_seg7_collision[];
+extern const struct BakedCollision castle_courtyard_seg7_collision_baked;
 extern const MacroObject castle_courtyard_seg7_macro_objs[];
 extern const struct MovtexQuadCollection castle_courtyard_movtex_star_statue_water[];
 
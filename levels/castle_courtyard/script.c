@@ -58,6 +58,7 @@ const LevelScript level_castle_courtyard_entry[] = {
         JUMP_LINK(script_func_local_1),
         JUMP_LINK(script_func_local_2),
         TERRAIN(/*terrainData*/ castle_courtyard_seg7_collision),
+        TERRAIN_BAKED(/*bakedTerrain*/ &castle_courtyard_seg7_collision_baked),
         MACRO_OBJECTS(/*objList*/ castle_courtyard_seg7_macro_objs),
         SET_BACKGROUND_MUSIC(/*settingsPreset*/ 0x0000, /*seq*/ SEQ_SOUND_PLAYER),
         TERRAIN_TYPE(/*terrainType*/ TERRAIN_STONE),
@@ -31,6 +31,7 @@ extern const struct Animation *const castle_grounds_seg7_anims_flags[];
 extern const Gfx castle_grounds_seg7_dl_0700EA58[];
 extern const Gfx castle_grounds_seg7_us_dl_0700F2E8[];
 extern const Collision castle_grounds_seg7_collision_level[];
+extern const struct BakedCollision castle_grounds_seg7_collision_level_baked;
 extern const MacroObject castle_grounds_seg7_macro_objs[];
 extern const Collision castle_grounds_seg7_collision_moat_grills[];
 extern const Collision castle_grounds_seg7_collision_cannon_grill[];
@@ -124,6 +124,7 @@ const LevelScript level_castle_grounds_entry[] = {
         JUMP_LINK(script_func_local_3),
         JUMP_LINK(script_func_local_4),
         TERRAIN(/*terrainData*/ castle_grounds_seg7_collision_level),
+        TERRAIN_BAKED(/*bakedTerrain*/ &castle_grounds_seg7_collision_level_baked),
         MACRO_OBJECTS(/*objList*/ castle_grounds_seg7_macro_objs),
         SET_BACKGROUND_MUSIC(/*settingsPreset*/ 0x0000, /*seq*/ SEQ_SOUND_PLAYER),
         TERRAIN_TYPE(/*terrainType*/ TERRAIN_GRASS),
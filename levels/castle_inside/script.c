@@ -263,6 +263,7 @@ const LevelScript level_castle_inside_entry[] = {
         JUMP_LINK(script_func_local_1),
         WARP_NODE(/*id*/ 0xF1, /*destLevel*/ LEVEL_CASTLE_GROUNDS, /*destArea*/ 0x01, /*destNode*/ 0x03, /*flags*/ WARP_NO_CHECKPOINT),
         TERRAIN(/*terrainData*/ inside_castle_seg7_area_1_collision),
+        TERRAIN_BAKED(/*bakedTerrain*/ &inside_castle_seg7_area_1_collision_baked),
         ROOMS(/*surfaceRooms*/ inside_castle_seg7_area_1_rooms),
         MACRO_OBJECTS(/*objList*/ inside_castle_seg7_area_1_macro_objs),
         SET_BACKGROUND_MUSIC(/*settingsPreset*/ 0x0001, /*seq*/ SEQ_LEVEL_INSIDE_CASTLE),
@@ -280,6 +281,7 @@ const LevelScript level_castle_inside_entry[] = {
         JUMP_LINK(script_func_local_2),
         WARP_NODE(/*id*/ 0xF1, /*destLevel*/ LEVEL_CASTLE_GROUNDS, /*destArea*/ 0x01, /*destNode*/ 0x03, /*flags*/ WARP_NO_CHECKPOINT),
         TERRAIN(/*terrainData*/ inside_castle_seg7_area_2_collision),
+        TERRAIN_BAKED(/*bakedTerrain*/ &inside_castle_seg7_area_2_collision_baked),
         ROOMS(/*surfaceRooms*/ inside_castle_seg7_area_2_rooms),
         MACRO_OBJECTS(/*objList*/ inside_castle_seg7_area_2_macro_objs),
         INSTANT_WARP(/*index*/ 0, /*destArea*/ 2, /*displace*/ 0, -205, 410),
@@ -298,6 +300,7 @@ const LevelScript level_castle_inside_entry[] = {
         JUMP_LINK(script_func_local_4),
         WARP_NODE(/*id*/ 0xF1, /*destLevel*/ LEVEL_CASTLE_GROUNDS, /*destArea*/ 0x01, /*destNode*/ 0x03, /*flags*/ WARP_NO_CHECKPOINT),
         TERRAIN(/*terrainData*/ inside_castle_seg7_area_3_collision),
+        TERRAIN_BAKED(/*bakedTerrain*/ &inside_castle_seg7_area_3_collision_baked),
         ROOMS(/*surfaceRooms*/ inside_castle_seg7_area_3_rooms),
         MACRO_OBJECTS(/*objList*/ inside_castle_seg7_area_3_macro_objs),
         SET_BACKGROUND_MUSIC(/*settingsPreset*/ 0x0001, /*seq*/ SEQ_LEVEL_INSIDE_CASTLE),
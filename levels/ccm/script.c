@@ -91,6 +91,7 @@ const LevelScript level_ccm_entry[] = {
         JUMP_LINK(script_func_local_2),
         JUMP_LINK(script_func_local_3),
         TERRAIN(/*terrainData*/ ccm_seg7_area_1_collision),
+        TERRAIN_BAKED(/*bakedTerrain*/ &ccm_seg7_area_1_collision_baked),
         MACRO_OBJECTS(/*objList*/ ccm_seg7_area_1_macro_objs),
         SHOW_DIALOG(/*index*/ 0x00, DIALOG_048),
         SET_BACKGROUND_MUSIC(/*settingsPreset*/ 0x0000, /*seq*/ SEQ_LEVEL_SNOW),
@@ -105,6 +106,7 @@ const LevelScript level_ccm_entry[] = {
         WARP_NODE(/*id*/ 0xF1, /*destLevel*/ LEVEL_CASTLE, /*destArea*/ 0x01, /*destNode*/ 0x65, /*flags*/ WARP_NO_CHECKPOINT),
         JUMP_LINK(script_func_local_4),
         TERRAIN(/*terrainData*/ ccm_seg7_area_2_collision),
+        TERRAIN_BAKED(/*bakedTerrain*/ &ccm_seg7_area_2_collision_baked),
         MACRO_OBJECTS(/*objList*/ ccm_seg7_area_2_macro_objs),
         SET_BACKGROUND_MUSIC(/*settingsPreset*/ 0x0001, /*seq*/ SEQ_LEVEL_SLIDE),
         TERRAIN_TYPE(/*terrainType*/ TERRAIN_SLIDE),
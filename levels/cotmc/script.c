@@ -53,6 +53,7 @@ const LevelScript level_cotmc_entry[] = {
         JUMP_LINK(script_func_local_2),
         JUMP_LINK(script_func_local_1),
         TERRAIN(/*terrainData*/ cotmc_seg7_collision_level),
+        TERRAIN_BAKED(/*bakedTerrain*/ &cotmc_seg7_collision_level_baked),
         MACRO_OBJECTS(/*objList*/ cotmc_seg7_macro_objs),
         SHOW_DIALOG(/*index*/ 0x00, DIALOG_130),
         SET_BACKGROUND_MUSIC(/*settingsPreset*/ 0x0004, /*seq*/ SEQ_LEVEL_UNDERGROUND),
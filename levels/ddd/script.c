@@ -91,6 +91,7 @@ const LevelScript level_ddd_entry[] = {
         JUMP_LINK(script_func_local_2),
         INSTANT_WARP(/*index*/ 3, /*destArea*/ 2, /*displace*/ -8192, 0, 0),
         TERRAIN(/*terrainData*/ ddd_seg7_area_1_collision),
+        TERRAIN_BAKED(/*bakedTerrain*/ &ddd_seg7_area_1_collision_baked),
         MACRO_OBJECTS(/*objList*/ ddd_seg7_area_1_macro_objs),
         SET_BACKGROUND_MUSIC(/*settingsPreset*/ 0x0003, /*seq*/ SEQ_LEVEL_WATER),
         TERRAIN_TYPE(/*terrainType*/ TERRAIN_WATER),
@@ -107,6 +108,7 @@ const LevelScript level_ddd_entry[] = {
         JUMP_LINK(script_func_local_5),
         INSTANT_WARP(/*index*/ 2, /*destArea*/ 1, /*displace*/ 8192, 0, 0),
         TERRAIN(/*terrainData*/ ddd_seg7_area_2_collision),
+        TERRAIN_BAKED(/*bakedTerrain*/ &ddd_seg7_area_2_collision_baked),
         MACRO_OBJECTS(/*objList*/ ddd_seg7_area_2_macro_objs),
         SET_BACKGROUND_MUSIC(/*settingsPreset*/ 0x0003, /*seq*/ SEQ_LEVEL_WATER),
         TERRAIN_TYPE(/*terrainType*/ TERRAIN_WATER),
@@ -106,6 +106,7 @@ const LevelScript level_hmc_entry[] = {
         JUMP_LINK(script_func_local_3),
         JUMP_LINK(script_func_local_4),
         TERRAIN(/*terrainData*/ hmc_seg7_collision_level),
+        TERRAIN_BAKED(/*bakedTerrain*/ &hmc_seg7_collision_level_baked),
         MACRO_OBJECTS(/*objList*/ hmc_seg7_macro_objs),
         ROOMS(/*surfaceRooms*/ hmc_seg7_rooms),
         SET_BACKGROUND_MUSIC(/*settingsPreset*/ 0x0004, /*seq*/ SEQ_LEVEL_UNDERGROUND),
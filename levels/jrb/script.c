@@ -151,6 +151,7 @@ const LevelScript level_jrb_entry[] = {
         JUMP_LINK(script_func_local_2),
         JUMP_LINK(script_func_local_3),
         TERRAIN(/*terrainData*/ jrb_seg7_area_1_collision),
+        TERRAIN_BAKED(/*bakedTerrain*/ &jrb_seg7_area_1_collision_baked),
         MACRO_OBJECTS(/*objList*/ jrb_seg7_area_1_macro_objs),
         SET_BACKGROUND_MUSIC(/*settingsPreset*/ 0x0003, /*seq*/ SEQ_LEVEL_WATER),
         TERRAIN_TYPE(/*terrainType*/ TERRAIN_WATER),
@@ -164,6 +165,7 @@ const LevelScript level_jrb_entry[] = {
         JUMP_LINK(script_func_local_4),
         JUMP_LINK(script_func_local_5),
         TERRAIN(/*terrainData*/ jrb_seg7_area_2_collision),
+        TERRAIN_BAKED(/*bakedTerrain*/ &jrb_seg7_area_2_collision_baked),
         MACRO_OBJECTS(/*objList*/ jrb_seg7_area_2_macro_objs),
         SET_BACKGROUND_MUSIC(/*settingsPreset*/ 0x0003, /*seq*/ SEQ_LEVEL_WATER),
         TERRAIN_TYPE(/*terrainType*/ TERRAIN_WATER),
@@ -94,6 +94,7 @@ extern const Gfx lll_seg7_dl_bowser_puzzle_piece_shadow[];
 extern const Gfx lll_seg7_dl_0701A878[];
 extern const Gfx lll_seg7_dl_0701AD70[];
 extern const Collision lll_seg7_area_1_collision[];
+extern const struct BakedCollision lll_seg7_area_1_collision_baked;
 extern const MacroObject lll_seg7_area_1_macro_objs[];
 extern const Collision lll_seg7_collision_octagonal_moving_platform[];
 extern const Collision lll_seg7_collision_drawbridge[];
@@ -115,6 +116,7 @@ extern const Gfx lll_seg7_dl_07025A48[];
 extern const Gfx lll_seg7_dl_07025BD8[];
 extern const Gfx lll_seg7_dl_07025EC0[];
 extern const Collision lll_seg7_area_2_collision[];
+extern const struct BakedCollision lll_seg7_area_2_collision_baked;
 extern const MacroObject lll_seg7_area_2_macro_objs[];
 extern const Collision lll_seg7_collision_falling_wall[];
 extern const Trajectory lll_seg7_trajectory_0702856C[];
@@ -188,6 +188,7 @@ const LevelScript level_lll_entry[] = {
         JUMP_LINK(script_func_local_4),
         JUMP_LINK(script_func_local_5),
         TERRAIN(/*terrainData*/ lll_seg7_area_1_collision),
+        TERRAIN_BAKED(/*bakedTerrain*/ &lll_seg7_area_1_collision_baked),
         MACRO_OBJECTS(/*objList*/ lll_seg7_area_1_macro_objs),
         SHOW_DIALOG(/*index*/ 0x00, DIALOG_097),
         SET_BACKGROUND_MUSIC(/*settingsPreset*/ 0x0000, /*seq*/ SEQ_LEVEL_HOT),
@@ -202,6 +203,7 @@ const LevelScript level_lll_entry[] = {
         JUMP_LINK(script_func_local_6),
         JUMP_LINK(script_func_local_7),
         TERRAIN(/*terrainData*/ lll_seg7_area_2_collision),
+        TERRAIN_BAKED(/*bakedTerrain*/ &lll_seg7_area_2_collision_baked),
         MACRO_OBJECTS(/*objList*/ lll_seg7_area_2_macro_objs),
         SET_BACKGROUND_MUSIC(/*settingsPreset*/ 0x0004, /*seq*/ SEQ_LEVEL_HOT),
         TERRAIN_TYPE(/*terrainType*/ TERRAIN_STONE),
@@ -15,6 +15,7 @@ extern const Gfx pss_seg7_dl_0700DAD8[];
 extern const Gfx pss_seg7_dl_0700E2B0[];
 extern const Gfx pss_seg7_dl_0700E3E8[];
 extern const Collision pss_seg7_collision[];
+extern const struct BakedCollision pss_seg7_collision_baked;
 extern const MacroObject pss_seg7_macro_objs[];
 
 // script
@@ -131,6 +131,7 @@ const LevelScript level_rr_entry[] = {
         JUMP_LINK(script_func_local_2),
         JUMP_LINK(script_func_local_3),
         TERRAIN(/*terrainData*/ rr_seg7_collision_level),
+        TERRAIN_BAKED(/*bakedTerrain*/ &rr_seg7_collision_level_baked),
         MACRO_OBJECTS(/*objList*/ rr_seg7_macro_objs),
         SET_BACKGROUND_MUSIC(/*settingsPreset*/ 0x0000, /*seq*/ SEQ_LEVEL_SLIDE),
         TERRAIN_TYPE(/*terrainType*/ TERRAIN_STONE),
@@ -10,6 +10,7 @@ extern const GeoLayout sa_geo_000170[];
 extern const Gfx sa_seg7_dl_07002DE8[];
 extern const Gfx sa_seg7_dl_07002FD0[];
 extern const Collision sa_seg7_collision[];
+extern const struct BakedCollision sa_seg7_collision_baked;
 extern const MacroObject sa_seg7_macro_objs[];
 
 // script
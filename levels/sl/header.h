@@ -27,10 +27,12 @@ extern const Gfx sl_seg7_dl_0700BCF8[];
 extern const Gfx sl_seg7_dl_0700C9E8[];
 extern const Gfx sl_seg7_dl_0700CB58[];
 extern const Collision sl_seg7_area_1_collision[];
+extern const struct BakedCollision sl_seg7_area_1_collision_baked;
 extern const MacroObject sl_seg7_area_1_macro_objs[];
 extern const Collision sl_seg7_collision_sliding_snow_mound[];
 extern const Collision sl_seg7_collision_pound_explodes[];
 extern const Collision sl_seg7_area_2_collision[];
+extern const struct BakedCollision sl_seg7_area_2_collision_baked;
 extern const MacroObject sl_seg7_area_2_macro_objs[];
 extern const struct MovtexQuadCollection sl_movtex_water[];
 
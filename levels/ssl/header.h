@@ -35,6 +35,7 @@ extern const Gfx ssl_seg7_dl_0700BD00[];
 extern const Gfx ssl_seg7_dl_0700BF18[];
 extern const Gfx ssl_seg7_dl_0700FCE0[];
 extern const Collision ssl_seg7_area_1_collision[];
+extern const struct BakedCollision ssl_seg7_area_1_collision_baked;
 extern const MacroObject ssl_seg7_area_1_macro_objs[];
 extern const Collision ssl_seg7_collision_pyramid_top[];
 extern const Collision ssl_seg7_collision_tox_box[];
@@ -61,7 +62,9 @@ extern const Gfx ssl_seg7_dl_07022CF8[];
 extern const Gfx ssl_seg7_dl_070233A8[];
 extern const Gfx ssl_seg7_dl_070235C0[];
 extern const Collision ssl_seg7_area_2_collision[];
+extern const struct BakedCollision ssl_seg7_area_2_collision_baked;
 extern const Collision ssl_seg7_area_3_collision[];
+extern const struct BakedCollision ssl_seg7_area_3_collision_baked;
 extern const MacroObject ssl_seg7_area_2_macro_objs[];
 extern const MacroObject ssl_seg7_area_3_macro_objs[];
 extern const Collision ssl_seg7_collision_grindel[];
@@ -107,6 +107,7 @@ const LevelScript level_ssl_entry[] = {
         JUMP_LINK(script_func_local_2),
         JUMP_LINK(script_func_local_3),
         TERRAIN(/*terrainData*/ ssl_seg7_area_1_collision),
+        TERRAIN_BAKED(/*bakedTerrain*/ &ssl_seg7_area_1_collision_baked),
         MACRO_OBJECTS(/*objList*/ ssl_seg7_area_1_macro_objs),
         SET_BACKGROUND_MUSIC(/*settingsPreset*/ 0x0000, /*seq*/ SEQ_LEVEL_HOT),
         TERRAIN_TYPE(/*terrainType*/ TERRAIN_SAND),
@@ -127,6 +128,7 @@ const LevelScript level_ssl_entry[] = {
         JUMP_LINK(script_func_local_5),
         INSTANT_WARP(/*index*/ 3, /*destArea*/ 3, /*displace*/ 0, 0, 0),
         TERRAIN(/*terrainData*/ ssl_seg7_area_2_collision),
+        TERRAIN_BAKED(/*bakedTerrain*/ &ssl_seg7_area_2_collision_baked),
         MACRO_OBJECTS(/*objList*/ ssl_seg7_area_2_macro_objs),
         SET_BACKGROUND_MUSIC(/*settingsPreset*/ 0x0004, /*seq*/ SEQ_LEVEL_UNDERGROUND),
         TERRAIN_TYPE(/*terrainType*/ TERRAIN_STONE),
@@ -137,6 +139,7 @@ const LevelScript level_ssl_entry[] = {
         WARP_NODE(/*id*/ 0xF1, /*destLevel*/ LEVEL_CASTLE, /*destArea*/ 0x03, /*destNode*/ 0x65, /*flags*/ WARP_NO_CHECKPOINT),
         JUMP_LINK(script_func_local_6),
         TERRAIN(/*terrainData*/ ssl_seg7_area_3_collision),
+        TERRAIN_BAKED(/*bakedTerrain*/ &ssl_seg7_area_3_collision_baked),
         MACRO_OBJECTS(/*objList*/ ssl_seg7_area_3_macro_objs),
         INSTANT_WARP(/*index*/ 2, /*destArea*/ 2, /*displace*/ 0, 0, 0),
         SET_BACKGROUND_MUSIC(/*settingsPreset*/ 0x0004, /*seq*/ SEQ_LEVEL_UNDERGROUND),
@@ -17,12 +17,15 @@ const GeoLayout thi_geo_0006D4[] = {
          GEO_OPEN_NODE(),
             GEO_CAMERA(CAMERA_MODE_RADIAL, 0, 2000, 6000, 0, 0, 0, geo_camera_main),
             GEO_OPEN_NODE(),
-               GEO_SCALE(0x00, 19660),
+               GEO_STATIC_NODE_START(),
                GEO_OPEN_NODE(),
-                  GEO_DISPLAY_LIST(LAYER_OPAQUE,         thi_seg7_dl_07005260),
-                  GEO_DISPLAY_LIST(LAYER_OPAQUE,         thi_seg7_dl_07006968),
-                  GEO_DISPLAY_LIST(LAYER_ALPHA,          thi_seg7_dl_07007008),
-                  GEO_DISPLAY_LIST(LAYER_TRANSPARENT,    thi_seg7_dl_070072E8),
+                  GEO_SCALE(0x00, 19660),
+                  GEO_OPEN_NODE(),
+                     GEO_DISPLAY_LIST(LAYER_OPAQUE,         thi_seg7_dl_07005260),
+                     GEO_DISPLAY_LIST(LAYER_OPAQUE,         thi_seg7_dl_07006968),
+                     GEO_DISPLAY_LIST(LAYER_ALPHA,          thi_seg7_dl_07007008),
+                     GEO_DISPLAY_LIST(LAYER_TRANSPARENT,    thi_seg7_dl_070072E8),
+                  GEO_CLOSE_NODE(),
                GEO_CLOSE_NODE(),
                GEO_DISPLAY_LIST(LAYER_TRANSPARENT_DECAL, thi_seg7_dl_07007538),
                GEO_ASM(0,                      geo_movtex_pause_control),
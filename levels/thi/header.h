@@ -26,8 +26,11 @@ extern const Gfx thi_seg7_dl_07009670[];
 extern const Gfx thi_seg7_dl_07009D50[];
 extern const Gfx thi_seg7_dl_07009F58[];
 extern const Collision thi_seg7_area_1_collision[];
+extern const struct BakedCollision thi_seg7_area_1_collision_baked;
 extern const Collision thi_seg7_area_2_collision[];
+extern const struct BakedCollision thi_seg7_area_2_collision_baked;
 extern const Collision thi_seg7_area_3_collision[];
+extern const struct BakedCollision thi_seg7_area_3_collision_baked;
 extern const MacroObject thi_seg7_area_1_macro_objs[];
 extern const MacroObject thi_seg7_area_2_macro_objs[];
 extern const MacroObject thi_seg7_area_3_macro_objs[];
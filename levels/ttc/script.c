@@ -67,6 +67,7 @@ const LevelScript level_ttc_entry[] = {
         JUMP_LINK(script_func_local_1),
         JUMP_LINK(script_func_local_2),
         TERRAIN(/*terrainData*/ ttc_seg7_collision_level),
+        TERRAIN_BAKED(/*bakedTerrain*/ &ttc_seg7_collision_level_baked),
         MACRO_OBJECTS(/*objList*/ ttc_seg7_macro_objs),
         SET_BACKGROUND_MUSIC(/*settingsPreset*/ 0x0001, /*seq*/ SEQ_LEVEL_SLIDE),
         TERRAIN_TYPE(/*terrainType*/ TERRAIN_STONE),
@@ -138,6 +138,7 @@ const LevelScript level_ttm_entry[] = {
         JUMP_LINK(script_func_local_2),
         JUMP_LINK(script_func_local_3),
         TERRAIN(/*terrainData*/ ttm_seg7_area_1_collision),
+        TERRAIN_BAKED(/*bakedTerrain*/ &ttm_seg7_area_1_collision_baked),
         MACRO_OBJECTS(/*objList*/ ttm_seg7_area_1_macro_objs),
         SET_BACKGROUND_MUSIC(/*settingsPreset*/ 0x0000, /*seq*/ SEQ_LEVEL_GRASS),
         TERRAIN_TYPE(/*terrainType*/ TERRAIN_STONE),
@@ -150,6 +151,7 @@ const LevelScript level_ttm_entry[] = {
         WARP_NODE(/*id*/ 0xF1, /*destLevel*/ LEVEL_CASTLE, /*destArea*/ 0x02, /*destNode*/ 0x66, /*flags*/ WARP_NO_CHECKPOINT),
         JUMP_LINK(script_func_local_4),
         TERRAIN(/*terrainData*/ ttm_seg7_area_2_collision),
+        TERRAIN_BAKED(/*bakedTerrain*/ &ttm_seg7_area_2_collision_baked),
         MACRO_OBJECTS(/*objList*/ ttm_seg7_area_2_macro_objs),
         INSTANT_WARP(/*index*/ 2, /*destArea*/ 3, /*displace*/ 10240, 7168, 10240),
         SET_BACKGROUND_MUSIC(/*settingsPreset*/ 0x0001, /*seq*/ SEQ_LEVEL_SLIDE),
@@ -161,6 +163,7 @@ const LevelScript level_ttm_entry[] = {
         WARP_NODE(/*id*/ 0xF1, /*destLevel*/ LEVEL_CASTLE, /*destArea*/ 0x02, /*destNode*/ 0x66, /*flags*/ WARP_NO_CHECKPOINT),
         JUMP_LINK(script_func_local_5),
         TERRAIN(/*terrainData*/ ttm_seg7_area_3_collision),
+        TERRAIN_BAKED(/*bakedTerrain*/ &ttm_seg7_area_3_collision_baked),
         MACRO_OBJECTS(/*objList*/ ttm_seg7_area_3_macro_objs),
         INSTANT_WARP(/*index*/ 3, /*destArea*/ 4, /*displace*/ -11264, 13312, 3072),
         SET_BACKGROUND_MUSIC(/*settingsPreset*/ 0x0001, /*seq*/ SEQ_LEVEL_SLIDE),
@@ -175,6 +178,7 @@ const LevelScript level_ttm_entry[] = {
         JUMP_LINK(script_func_local_6),
         JUMP_LINK(script_func_local_7),
         TERRAIN(/*terrainData*/ ttm_seg7_area_4_collision),
+        TERRAIN_BAKED(/*bakedTerrain*/ &ttm_seg7_area_4_collision_baked),
         MACRO_OBJECTS(/*objList*/ ttm_seg7_area_4_macro_objs),
         SET_BACKGROUND_MUSIC(/*settingsPreset*/ 0x0001, /*seq*/ SEQ_LEVEL_SLIDE),
         TERRAIN_TYPE(/*terrainType*/ TERRAIN_SLIDE),
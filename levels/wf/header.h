@@ -93,6 +93,7 @@ extern const Collision wf_seg7_collision_rotating_platform[];
 extern const Collision wf_seg7_collision_tower[];
 extern const Collision wf_seg7_collision_bullet_bill_cannon[];
 extern const Collision wf_seg7_collision_070102D8[];
+extern const struct BakedCollision wf_seg7_collision_070102D8_baked;
 extern const MacroObject wf_seg7_macro_objs[];
 extern const struct MovtexQuadCollection wf_movtex_water[];
 
@@ -153,6 +153,7 @@ const LevelScript level_wf_entry[] = {
         JUMP_LINK(script_func_local_3),
         JUMP_LINK(script_func_local_4),
         TERRAIN(/*terrainData*/ wf_seg7_collision_070102D8),
+        TERRAIN_BAKED(/*bakedTerrain*/ &wf_seg7_collision_070102D8_baked),
         MACRO_OBJECTS(/*objList*/ wf_seg7_macro_objs),
         SHOW_DIALOG(/*index*/ 0x00, DIALOG_030),
         SET_BACKGROUND_MUSIC(/*settingsPreset*/ 0x0005, /*seq*/ SEQ_LEVEL_GRASS),
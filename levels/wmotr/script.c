@@ -56,6 +56,7 @@ const LevelScript level_wmotr_entry[] = {
         JUMP_LINK(script_func_local_1),
         JUMP_LINK(script_func_local_2),
         TERRAIN(/*terrainData*/ wmotr_seg7_collision),
+        TERRAIN_BAKED(/*bakedTerrain*/ &wmotr_seg7_collision_baked),
         MACRO_OBJECTS(/*objList*/ wmotr_seg7_macro_objs),
         SET_BACKGROUND_MUSIC(/*settingsPreset*/ 0x0000, /*seq*/ SEQ_LEVEL_SLIDE),
         TERRAIN_TYPE(/*terrainType*/ TERRAIN_SNOW),
@@ -84,7 +84,7 @@ dispatchTable:
   jumpTableEntry cmd_LOADADPCM
   jumpTableEntry cmd_MIXER
   jumpTableEntry cmd_INTERLEAVE
-  jumpTableEntry cmd_POLEF
+  jumpTableEntry cmd_REVERB
   jumpTableEntry cmd_SETLOOP
 .endif
 
@@ -180,6 +180,16 @@ audio_wet_gain      equ 0x1e // 0x37e
 .definelabel dmemBase,      0x5c0 // all samples stored that is transferred to DMEM
 .definelabel tmpData,       0xF90 // temporary area
 
+// cmd_REVERB
+REVERB_BLOCK_SIZE  equ 64 // samples per block, must match BETTER_REVERB_RSP_BLOCK_SIZE in src/audio/synthesis.c
+REVERB_SLOT_SIZE   equ (REVERB_BLOCK_SIZE * 2 + 8)
+REVERB_PARAMS_SIZE equ 0x90
+.definelabel reverbParams,  dmemBase
+.definelabel reverbWindows, reverbParams + 0x20 // buffer, position and size of each window
+.definelabel reverbPtrs,    reverbParams + 0x90 // first sample of each window in reverbSlots
+.definelabel reverbTerms,   reverbParams + 0xb0 // history * -gain >> 8 of each filter, or the history of the last of a group
+.definelabel reverbSlots,   reverbParams + 0x170
+
 .close // DATA_FILE
 
 
@@ -753,115 +763,197 @@ cmd_ADPCM:
     j     cmd_SPNOOP
      mtc0  $zero, SP_SEMAPHORE
 
-cmd_POLEF: // unused by SM64
+// Runs the BETTER_REVERB filters over the ring buffer of one channel, like reverb_samples_block in
+// src/audio/better_reverb_kernel.h. w1 is the address of the parameters (struct ReverbRspParams in
+// src/audio/synthesis.c). Each window is a ring buffer or delay line, of which the samples of a block are
+// DMA'd in, filtered 8 at a time through every filter, and DMA'd back out.
 .ifndef VERSION_SH
-    lqv   $v31[0], 0x0000($zero)
-    vxor  $v28, $v28, $v28
-    lhu   $21, (audio_in_buf)($24)
-    vxor  $v17, $v17, $v17
-    lhu   $20, (audio_out_buf)($24)
-    vxor  $v18, $v18, $v18
-    lhu   $19, (audio_count)($24)
-    vxor  $v19, $v19, $v19
-    beqz  $19, @@audio_04001874
-     andi  $14, $26, 0xffff
-    mtc2  $14, $v31[10]
-    sll   $14, $14, 2
-    mtc2  $14, $v16[0]
-    lui   $1, 0x00ff
-    vxor  $v20, $v20, $v20
-    ori   $1, $1, 0xffff
-    vxor  $v21, $v21, $v21
-    and   $18, $25, $1
-    vxor  $v22, $v22, $v22
-    srl   $2, $25, 24
-    vxor  $v23, $v23, $v23
-    sll   $2, $2, 2
-    lw    $3, (segmentTable)($2)
-    add   $18, $18, $3
-    slv   $v28[0], 0x00($23)
-    srl   $1, $26, 16
-    andi  $1, $1, 0x0001
-    bgtz  $1, @@audio_040017a0
-     nop
-    addi  $1, $23, 0x0000
-    addi  $2, $18, 0x0000
+cmd_REVERB:
+    sll   $2, $25, 8
+    srl   $2, $2, 8
+    srl   $4, $25, 24
+    sll   $4, $4, 2
+    lw    $5, (segmentTable)($4)
+    add   $2, $2, $5
+    addi  $1, $zero, reverbParams
     jal   dma_read_start
-     addi  $3, $zero, 7
-.endif
+     addi  $3, $zero, REVERB_PARAMS_SIZE - 1
 @@dma_read_busy:
-.ifndef VERSION_SH
     mfc0  $5, SP_DMA_BUSY
     bnez  $5, @@dma_read_busy
      nop
     mtc0  $zero, SP_SEMAPHORE
-.endif
-@@audio_040017a0:
-.ifndef VERSION_SH
-    addi  $13, $zero, adpcmTable
-    addi  $1, $zero, 0x0004
-    mtc2  $1, $v14[0]
-    lqv   $v24[0], 0x0010($13)
-    vmudm $v16, $v24, $v16[0]
-    ldv   $v28[8], 0x00($23)
-    sqv   $v16[0], 0x10($13)
-    lqv   $v25[0], 0x00($13)
-    addi  $13, $13, -2
-    lrv   $v23[0], 0x20($13)
-    addi  $13, $13, -2
-    lrv   $v22[0], 0x20($13)
-    addi  $13, $13, -2
-    lrv   $v21[0], 0x20($13)
-    addi  $13, $13, -2
-    lrv   $v20[0], 0x20($13)
-    addi  $13, $13, -2
-    lrv   $v19[0], 0x20($13)
-    addi  $13, $13, -2
-    lrv   $v18[0], 0x20($13)
-    addi  $13, $13, -2
-    lrv   $v17[0], 0x20($13)
-    ldv   $v30[0], 0x00($21)
-    ldv   $v30[8], 0x08($21)
-.endif
-@@audio_04001800:
-.ifndef VERSION_SH
-    vmudh $v16, $v25, $v28[6]
-    addi  $21, $21, 0x10
-    vmadh $v16, $v24, $v28[7]
-    addi  $19, $19, -0x10
-    vmadh $v16, $v23, $v30[0]
-    vmadh $v16, $v22, $v30[1]
-    vmadh $v16, $v21, $v30[2]
-    vmadh $v16, $v20, $v30[3]
-    vmadh $v28, $v19, $v30[4]
-    vmadh $v16, $v18, $v30[5]
-    vmadh $v16, $v17, $v30[6]
-    vmadh $v16, $v30, $v31[5]
-    ldv   $v30[0], 0x00($21)
-    vsar  $v26, $v15, $v28[1]
-    ldv   $v30[8], 0x08($21)
-    vsar  $v28, $v15, $v28[0]
-    vmudn $v16, $v26, $v14[0]
-    vmadh $v28, $v28, $v14[0]
-    sdv   $v28[0], 0x00($20)
-    sdv   $v28[8], 0x08($20)
-    bgtz  $19, @@audio_04001800
-     addi  $20, $20, 0x10
-    addi  $1, $20, -8
-    addi  $2, $18, 0x00
-    jal   dma_write_start
-     addi  $3, $zero, 7
-.endif
-@@dma_write_busy:
-.ifndef VERSION_SH
-    mfc0  $5, SP_DMA_BUSY
-    bnez  $5, @@dma_write_busy
+    lqv   $v31[0], 0x0000($zero)
+    addi  $1, $zero, reverbParams
+    lqv   $v30[0], 0x10($1)      // gain and multipliers
+    lhu   $19, 0x00($1)          // bytes left
+    lhu   $15, 0x02($1)          // filter count
+    lhu   $18, 0x04($1)          // mono
+    sll   $15, $15, 1
+    addi  $16, $15, reverbPtrs + 2
+    sll   $17, $15, 2
+    sll   $1, $18, 3
+    add   $17, $17, $1
+    addi  $17, $17, reverbWindows + 8
+@@block:
+    addi  $10, $zero, REVERB_BLOCK_SIZE * 2
+    sub   $1, $19, $10
+    bgez  $1, @@full_block
+     addi  $12, $zero, 0
+    addi  $10, $19, 0
+@@full_block:
+    jal   reverb_windows
+     addi  $11, $zero, dma_read_start & 0xffff
+@@windows_read_busy:
+    mfc0  $1, SP_DMA_BUSY
+    bnez  $1, @@windows_read_busy
+     addi  $14, $zero, 0
+@@vector:
+    lhu   $2, (reverbPtrs)($zero)
+    add   $2, $2, $14
+    lqv   $v6[0], 0x00($2)
+    beqz  $18, @@stereo
+     lrv   $v6[0], 0x10($2)
+    lhu   $3, 0x00($16)
+    add   $3, $3, $14
+    lqv   $v7[0], 0x00($3)
+    lrv   $v7[0], 0x10($3)
+    vmudm $v6, $v6, $v30[7]
+    vmadm $v6, $v7, $v30[7]      // (left + right) >> 1
+@@stereo:
+    addi  $13, $zero, reverbPtrs + 2
+    addi  $3, $zero, reverbTerms
+    addi  $9, $zero, 2
+@@term:
+    lhu   $1, 0x00($13)
+    addi  $13, $13, 2
+    add   $1, $1, $14
+    lqv   $v0[0], 0x00($1)
+    lrv   $v0[0], 0x10($1)
+    addi  $9, $9, -1
+    vmudm $v1, $v0, $v30[0]
+    bgez  $9, @@gain_term
+     vmadh $v1, $v0, $v31[3]     // history * -gain >> 8
+    vor   $v1, $v0, $v0          // the last filter of each group keeps its history for the output
+    addi  $9, $zero, 2
+@@gain_term:
+    sqv   $v1[0], 0x00($3)
+    bne   $13, $16, @@term
+     addi  $3, $3, 0x10
+    addi  $3, $zero, reverbTerms
+    lqv   $v8[0], 0x20($3)
+    lqv   $v9[0], 0x50($3)
+    lqv   $v10[0], 0x80($3)
+    lqv   $v11[0], 0xb0($3)
+    vmudm $v8, $v8, $v30[3]
+    vmudm $v9, $v9, $v30[4]
+    vmudm $v10, $v10, $v30[5]
+    vmudm $v11, $v11, $v30[6]
+    vmudh $v2, $v8, $v31[1]
+    vmadh $v2, $v9, $v31[1]
+    vmadh $v2, $v10, $v31[1]
+    vmadh $v2, $v11, $v31[1]
+    sqv   $v2[0], 0x00($2)
+    srv   $v2[0], 0x10($2)
+    lhu   $1, -2($16)
+    add   $1, $1, $14
+    lqv   $v0[0], 0x00($1)
+    lrv   $v0[0], 0x10($1)
+    vmudm $v5, $v0, $v30[2]
+    vmadh $v5, $v6, $v31[1]      // carry = (last history * reverb >> 8) + input
+    addi  $13, $zero, reverbPtrs + 2
+    addi  $9, $zero, 2
+@@filter:
+    lhu   $1, 0x00($13)
+    addi  $13, $13, 2
+    add   $1, $1, $14
+    lqv   $v0[0], 0x00($1)
+    lrv   $v0[0], 0x10($1)
+    addi  $9, $9, -1
+    bltz  $9, @@group_end
+     lqv   $v1[0], 0x00($3)
+    vmadh $v2, $v1, $v31[1]
+    sqv   $v2[0], 0x00($1)
+    srv   $v2[0], 0x10($1)
+    vsar  $v3, $v3, $v3[1]
+    vsar  $v4, $v4, $v4[0]
+    vmudn $v5, $v3, $v30[1]
+    vmadn $v5, $v3, $v30[1]
+    vmadh $v5, $v4, $v30[1]
+    vmadh $v5, $v4, $v30[1]
+    vmadh $v5, $v0, $v31[1]      // carry = (carry * gain >> 8) + history
+    j     @@filter
+     addi  $3, $3, 0x10
+@@group_end:
+    vmadh $v2, $v31, $v31[0]
+    addi  $9, $zero, 2
+    sqv   $v2[0], 0x00($1)
+    srv   $v2[0], 0x10($1)
+    addi  $3, $3, 0x10
+    bne   $13, $16, @@filter
+     vmudm $v5, $v0, $v30[2]     // carry = history * reverb >> 8
+    addi  $14, $14, 0x10
+    bne   $14, $10, @@vector
+     addi  $12, $10, 0
+    jal   reverb_windows
+     addi  $11, $zero, dma_write_start & 0xffff
+    sub   $19, $19, $10
+    bgtz  $19, @@block
+     nop
+@@windows_write_busy:
+    mfc0  $1, SP_DMA_BUSY
+    bnez  $1, @@windows_write_busy
      nop
-.endif
-@@audio_04001874:
-.ifndef VERSION_SH
     j     cmd_SPNOOP
-     mtc0  $zero, SP_SEMAPHORE
+     nop
+
+// Starts the DMA ($11) of the current block of every window, split in two where its buffer wraps around,
+// records where its first sample is in reverbPtrs and moves it on by $12 bytes.
+reverb_windows:
+    addi  $21, $ra, 0
+    addi  $8, $zero, reverbWindows
+    addi  $9, $zero, reverbSlots
+    addi  $13, $zero, reverbPtrs
+@@window:
+    lw    $2, 0x00($8)           // buffer
+    lhu   $5, 0x04($8)           // position
+    lhu   $6, 0x06($8)           // size
+    andi  $7, $5, 7
+    sub   $5, $5, $7
+    add   $1, $9, $7
+    sh    $1, 0x00($13)
+    add   $3, $10, $7
+    addi  $3, $3, 7
+    andi  $3, $3, 0xfff8
+    sub   $6, $6, $5
+    add   $2, $2, $5
+    sub   $7, $3, $6
+    blez  $7, @@one_piece
+     addi  $1, $9, 0
+    jalr  $11
+     addi  $3, $6, -1
+    mtc0  $zero, SP_SEMAPHORE
+    lw    $2, 0x00($8)
+    add   $1, $9, $6
+    addi  $3, $7, 0
+@@one_piece:
+    jalr  $11
+     addi  $3, $3, -1
+    mtc0  $zero, SP_SEMAPHORE
+    lhu   $5, 0x04($8)
+    lhu   $6, 0x06($8)
+    add   $5, $5, $12
+    sub   $7, $5, $6
+    bltz  $7, @@no_wrap
+     addi  $8, $8, 8
+    addi  $5, $7, 0
+@@no_wrap:
+    sh    $5, -4($8)
+    addi  $9, $9, REVERB_SLOT_SIZE
+    bne   $8, $17, @@window
+     addi  $13, $13, 2
+    jr    $21
+     nop
 .endif
 
 cmd_RESAMPLE:
@@ -0,0 +1,157 @@
+// BETTER_REVERB filter kernels, shared by synthesis.c and the host benchmark in tools/better_reverb_bench.c.
+// The includer provides s16/s32, MIN, CLAMP_S16 and the BETTER_REVERB_*_LIGHT parameters.
+
+#ifndef BETTER_REVERB_KERNEL_H
+#define BETTER_REVERB_KERNEL_H
+
+// Number of samples each filter processes at a time in reverb_samples_block.
+#define BETTER_REVERB_BLOCK_SIZE 32
+
+struct ReverbRun {
+    s16 *samples;
+    s32 count;
+};
+
+/**
+ * Splits the next count samples of a delay line, starting at idx, into the runs before and after it wraps around.
+ * Returns the number of runs; count must not be larger than the delay.
+ */
+static s32 reverb_get_runs(s16 *delayBuf, s32 idx, s32 delay, s32 count, struct ReverbRun runs[2]) {
+    runs[0].samples = &delayBuf[idx];
+    runs[0].count = MIN(count, delay - idx);
+    if (runs[0].count == count) {
+        return 1;
+    }
+
+    runs[1].samples = delayBuf;
+    runs[1].count = count - runs[0].count;
+    return 2;
+}
+
+static void reverb_advance_idx(s32 *idx, s32 delay, s32 count) {
+    *idx += count;
+    if (*idx >= delay) {
+        *idx -= delay;
+    }
+}
+
+/**
+ * Same output as mixing every sample through every filter in turn, but runs each filter over a block of samples.
+ * A filter only reads back what it wrote one delay ago, so this is exact as long as no block is longer than the shortest delay.
+ * Filters come in groups of three, where the third one feeds the output and restarts the chain.
+ */
+static void reverb_samples_block(s16 *start, s16 *end, s16 *downsampleBuffer, s32 downsampleIncrement,
+                                 s16 **delayBufs, s32 *allpassIdx, s32 *delays, s32 *reverbMults,
+                                 s32 lastFilterIndex, s32 revIndex, s32 gainIndex) {
+    s32 carry[BETTER_REVERB_BLOCK_SIZE];
+    s32 outSampleTotal[BETTER_REVERB_BLOCK_SIZE];
+    struct ReverbRun runs[2];
+    s32 maxBlockSize = BETTER_REVERB_BLOCK_SIZE;
+    s32 blockSize, numRuns;
+    s32 historySample;
+    s32 tmpCarryover;
+    s32 i, n, r, pos;
+    s32 *carryRun;
+    s32 *outRun;
+    s16 *delayRun;
+
+    for (i = 0; i <= lastFilterIndex; i++) {
+        maxBlockSize = MIN(maxBlockSize, delays[i]);
+    }
+
+    for (; start < end; start += blockSize, downsampleBuffer += blockSize * downsampleIncrement) {
+        blockSize = MIN(end - start, maxBlockSize);
+
+        // Mix the very last filter output with new incoming samples
+        numRuns = reverb_get_runs(delayBufs[lastFilterIndex], allpassIdx[lastFilterIndex], delays[lastFilterIndex], blockSize, runs);
+        for (r = 0, pos = 0; r < numRuns; pos += runs[r].count, r++) {
+            delayRun = runs[r].samples;
+            for (n = 0; n < runs[r].count; n++) {
+                carry[pos + n] = ((delayRun[n] * revIndex) >> 8) + downsampleBuffer[(pos + n) * downsampleIncrement];
+            }
+        }
+
+        for (n = 0; n < blockSize; n++) {
+            outSampleTotal[n] = 0;
+        }
+
+        for (i = 0; i <= lastFilterIndex; i++) {
+            numRuns = reverb_get_runs(delayBufs[i], allpassIdx[i], delays[i], blockSize, runs);
+
+            for (r = 0, pos = 0; r < numRuns; pos += runs[r].count, r++) {
+                delayRun = runs[r].samples;
+                carryRun = &carry[pos];
+                outRun = &outSampleTotal[pos];
+
+                if (i % 3 == 2) {
+                    s32 reverbMult = reverbMults[i / 3];
+                    for (n = 0; n < runs[r].count; n++) {
+                        historySample = delayRun[n];
+                        outRun[n] += ((historySample * reverbMult) >> 8);
+                        delayRun[n] = CLAMP_S16(carryRun[n]);
+                        // Unused after the last filter, which is cheaper than checking for it.
+                        carryRun[n] = ((historySample * revIndex) >> 8);
+                    }
+                } else {
+                    for (n = 0; n < runs[r].count; n++) {
+                        historySample = delayRun[n];
+                        tmpCarryover = carryRun[n] + ((historySample * (-gainIndex)) >> 8);
+                        delayRun[n] = CLAMP_S16(tmpCarryover);
+                        carryRun[n] = ((tmpCarryover * gainIndex) >> 8) + historySample;
+                    }
+                }
+            }
+
+            reverb_advance_idx(&allpassIdx[i], delays[i], blockSize);
+        }
+
+        for (n = 0; n < blockSize; n++) {
+            start[n] = CLAMP_S16(outSampleTotal[n]);
+        }
+    }
+}
+
+/**
+ * The lightweight chain feeds each output sample back into the next one, so it has to run sample by sample.
+ * Samples are processed in runs that end where the first delay line wraps around, so the inner loop doesn't check for it.
+ * Returns the carried over sample to pass in for the next call.
+ */
+static s32 reverb_samples_light_block(s16 *start, s16 *end, s16 *downsampleBuffer, s32 downsampleIncrement,
+                                      s16 **delayBufs, s32 *allpassIdx, s32 *delays, s32 tmpCarryover) {
+    s16 *delayPtrs[BETTER_REVERB_FILTER_COUNT_LIGHT];
+    s32 historySample;
+    s32 runSize;
+    s32 i, n;
+
+    for (; start < end; start += runSize, downsampleBuffer += runSize * downsampleIncrement) {
+        runSize = end - start;
+        for (i = 0; i < BETTER_REVERB_FILTER_COUNT_LIGHT; i++) {
+            runSize = MIN(runSize, delays[i] - allpassIdx[i]);
+            delayPtrs[i] = &delayBufs[i][allpassIdx[i]];
+        }
+
+        for (n = 0; n < runSize; n++) {
+            // Mix previous sample with new incoming sample
+            tmpCarryover = ((tmpCarryover * BETTER_REVERB_REVERB_INDEX_LIGHT) >> 8) + downsampleBuffer[n * downsampleIncrement];
+
+            for (i = 0; i < BETTER_REVERB_FILTER_COUNT_LIGHT; i++) {
+                historySample = delayPtrs[i][n];
+
+                tmpCarryover += ((historySample * (-BETTER_REVERB_GAIN_INDEX_LIGHT)) >> 8);
+                delayPtrs[i][n] = CLAMP_S16(tmpCarryover);
+                tmpCarryover = ((tmpCarryover * BETTER_REVERB_GAIN_INDEX_LIGHT) >> 8) + historySample;
+            }
+
+            // Lightweight does not use the final filter type at all, unlike standard reverb processing
+            start[n] = CLAMP_S16(tmpCarryover);
+        }
+
+        for (i = 0; i < BETTER_REVERB_FILTER_COUNT_LIGHT; i++) {
+            reverb_advance_idx(&allpassIdx[i], delays[i], runSize);
+        }
+    }
+
+    return tmpCarryover;
+}
+
+#endif // BETTER_REVERB_KERNEL_H
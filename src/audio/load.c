@@ -14,9 +14,32 @@ struct SharedDma {
     /*0x4*/ uintptr_t source; // device address
     /*0x8*/ u32 bufSize;      // size of buffer (converted from u16 for intentional padding to size 0x10)
     /*0xC*/ u8 reuseIndex;    // position in sSampleDmaReuseQueue1/2, if ttl == 0
-    /*   */ // u8 pad[3];
+    /*0xD*/ u8 hashNext;      // next DMA in the same sSampleDmaHashBuckets bucket (list 2 only)
+    /*0xE*/ u8 ttlPrev;       // neighbors in the sSampleDmaTtlQueues queue it expires from
+    /*0xF*/ u8 ttlNext;
 };                            // size = 0x10
 
+#define SAMPLE_DMA_NONE 0xFF
+
+// List 2 DMAs are indexed by the ROM chunk their source lies in. A chunk is at least as large as a
+// list 2 buffer, so any buffer that covers an address starts in that address' chunk or the one before it.
+#define SAMPLE_DMA_CHUNK_SHIFT 11
+#define SAMPLE_DMA_HASH_SIZE 64
+#define SAMPLE_DMA_HASH(source) (((source) >> SAMPLE_DMA_CHUNK_SHIFT) & (SAMPLE_DMA_HASH_SIZE - 1))
+
+STATIC_ASSERT((1 << SAMPLE_DMA_CHUNK_SHIFT) >= DMA_BUF_SIZE_1, "Sample DMA chunks must be at least as large as list 2 buffers!");
+STATIC_ASSERT(MAX_SIMULTANEOUS_NOTES * 4 < SAMPLE_DMA_NONE, "Too many sample DMAs to index with a u8!");
+
+// Active DMAs expire in the order their TTL was last refreshed, and since every refresh uses one of
+// two fixed TTLs, keeping one queue per TTL keeps each queue sorted by expiry.
+enum SampleDmaTtlQueues {
+    SAMPLE_DMA_TTL_SHORT,
+    SAMPLE_DMA_TTL_LONG,
+    SAMPLE_DMA_TTL_COUNT
+};
+
+static const u8 sSampleDmaTtlLengths[SAMPLE_DMA_TTL_COUNT] = { 2, 60 };
+
 // EU only
 void port_eu_init(void);
 
@@ -41,7 +64,16 @@ OSMesg gAudioDmaMesg;
 OSIoMesg gAudioDmaIoMesg;
 
 struct SharedDma sSampleDmas[MAX_SIMULTANEOUS_NOTES * 4];
-u8 sSampleTTLs[MAX_SIMULTANEOUS_NOTES * 4];
+u8 sSampleTTLs[MAX_SIMULTANEOUS_NOTES * 4]; // Audio frame each DMA expires on, if it's in a TTL queue
+u8 sSampleDmaTtlQueueIds[MAX_SIMULTANEOUS_NOTES * 4]; // SAMPLE_DMA_NONE while the DMA is in a reuse queue
+u8 sSampleDmaTtlQueueHeads[SAMPLE_DMA_TTL_COUNT];
+u8 sSampleDmaTtlQueueTails[SAMPLE_DMA_TTL_COUNT];
+u8 sSampleDmaHashBuckets[SAMPLE_DMA_HASH_SIZE];
+u8 sSampleDmaFrame;
+#ifdef PUPPYPRINT_DEBUG
+struct SampleDmaStats gSampleDmaStats;
+static struct SampleDmaStats sSampleDmaStatsCounting;
+#endif
 u32 gSampleDmaNumListItems; // sh: 0x803503D4
 u32 sSampleDmaListSize1; // sh: 0x803503D8
 
@@ -152,28 +184,115 @@ void audio_dma_partial_copy_async(uintptr_t *devAddr, u8 **vAddr, ssize_t *remai
     *vAddr += transfer;
 }
 
-void decrease_sample_dma_ttls() {
+static void sample_dma_unlink_ttl(u32 index) {
+    struct SharedDma *dma = &sSampleDmas[index];
+    u32 queue = sSampleDmaTtlQueueIds[index];
+
+    if (dma->ttlPrev != SAMPLE_DMA_NONE) {
+        sSampleDmas[dma->ttlPrev].ttlNext = dma->ttlNext;
+    } else {
+        sSampleDmaTtlQueueHeads[queue] = dma->ttlNext;
+    }
+    if (dma->ttlNext != SAMPLE_DMA_NONE) {
+        sSampleDmas[dma->ttlNext].ttlPrev = dma->ttlPrev;
+    } else {
+        sSampleDmaTtlQueueTails[queue] = dma->ttlPrev;
+    }
+    sSampleDmaTtlQueueIds[index] = SAMPLE_DMA_NONE;
+}
+
+/**
+ * (Re)starts the TTL of a DMA, moving it to the back of the queue for that TTL.
+ */
+static void sample_dma_set_ttl(u32 index, u32 queue) {
+    struct SharedDma *dma = &sSampleDmas[index];
+
+    if (sSampleDmaTtlQueueIds[index] != SAMPLE_DMA_NONE) {
+        sample_dma_unlink_ttl(index);
+    }
+
+    sSampleTTLs[index] = sSampleDmaFrame + sSampleDmaTtlLengths[queue];
+    sSampleDmaTtlQueueIds[index] = queue;
+    dma->ttlPrev = sSampleDmaTtlQueueTails[queue];
+    dma->ttlNext = SAMPLE_DMA_NONE;
+    if (dma->ttlPrev != SAMPLE_DMA_NONE) {
+        sSampleDmas[dma->ttlPrev].ttlNext = index;
+    } else {
+        sSampleDmaTtlQueueHeads[queue] = index;
+    }
+    sSampleDmaTtlQueueTails[queue] = index;
+}
+
+/**
+ * Points a list 2 DMA at a new source, moving it to the hash bucket of that source.
+ */
+static void sample_dma_rehash(u32 index, uintptr_t source) {
+    struct SharedDma *dma = &sSampleDmas[index];
+    u8 *link;
+
+    if (dma->source != 0) {
+        link = &sSampleDmaHashBuckets[SAMPLE_DMA_HASH(dma->source)];
+        while (*link != index) {
+            link = &sSampleDmas[*link].hashNext;
+        }
+        *link = dma->hashNext;
+    }
+
+    dma->source = source;
+    dma->hashNext = sSampleDmaHashBuckets[SAMPLE_DMA_HASH(source)];
+    sSampleDmaHashBuckets[SAMPLE_DMA_HASH(source)] = index;
+}
+
+/**
+ * Returns the list 2 DMA whose buffer holds [devAddr, devAddr + size), or SAMPLE_DMA_NONE.
+ */
+static u32 sample_dma_find(uintptr_t devAddr, u32 size) {
+    struct SharedDma *dma;
+    ssize_t bufferPos;
+    u32 chunk;
     u32 i;
 
-    for (i = 0; i < sSampleDmaListSize1; i++) {
-        if (sSampleTTLs[i] != 0) {
-            sSampleTTLs[i]--;
-            if (sSampleTTLs[i] == 0) {
-                sSampleDmas[i].reuseIndex = sSampleDmaReuseQueueHead1;
-                sSampleDmaReuseQueue1[sSampleDmaReuseQueueHead1++] = (u8) i;
+    for (chunk = 0; chunk < 2; chunk++) {
+        i = sSampleDmaHashBuckets[SAMPLE_DMA_HASH(devAddr - (chunk << SAMPLE_DMA_CHUNK_SHIFT))];
+        while (i != SAMPLE_DMA_NONE) {
+            dma = &sSampleDmas[i];
+            bufferPos = devAddr - dma->source;
+            if (0 <= bufferPos && (size_t) bufferPos <= dma->bufSize - size) {
+                return i;
             }
+            i = dma->hashNext;
         }
     }
 
-    for (i = sSampleDmaListSize1; i < gSampleDmaNumListItems; i++) {
-        if (sSampleTTLs[i] != 0) {
-            sSampleTTLs[i]--;
-            if (sSampleTTLs[i] == 0) {
+    return SAMPLE_DMA_NONE;
+}
+
+/**
+ * Moves every DMA whose TTL ran out this audio frame to its reuse queue, least recently used first.
+ */
+void decrease_sample_dma_ttls() {
+    u32 queue;
+    u32 i;
+
+    sSampleDmaFrame++;
+
+    for (queue = 0; queue < SAMPLE_DMA_TTL_COUNT; queue++) {
+        while ((i = sSampleDmaTtlQueueHeads[queue]) != SAMPLE_DMA_NONE && (s8)(sSampleTTLs[i] - sSampleDmaFrame) <= 0) {
+            sample_dma_unlink_ttl(i);
+            if (i < sSampleDmaListSize1) {
+                sSampleDmas[i].reuseIndex = sSampleDmaReuseQueueHead1;
+                sSampleDmaReuseQueue1[sSampleDmaReuseQueueHead1++] = (u8) i;
+            } else {
                 sSampleDmas[i].reuseIndex = sSampleDmaReuseQueueHead2;
                 sSampleDmaReuseQueue2[sSampleDmaReuseQueueHead2++] = (u8) i;
             }
         }
     }
+
+#ifdef PUPPYPRINT_DEBUG
+    gSampleDmaStats = sSampleDmaStatsCounting;
+    bzero(&sSampleDmaStatsCounting, sizeof(sSampleDmaStatsCounting));
+#endif
 }
 
 void *dma_sample_data(uintptr_t devAddr, u32 size, s32 arg2, u8 *dmaIndexRef) {
@@ -186,26 +305,27 @@ void *dma_sample_data(uintptr_t devAddr, u32 size, s32 arg2, u8 *dmaIndexRef) {
     ssize_t bufferPos;
 
     if (arg2 != 0 || *dmaIndexRef >= sSampleDmaListSize1) {
-        for (i = sSampleDmaListSize1; i < gSampleDmaNumListItems; i++) {
+        i = sample_dma_find(devAddr, size);
+        if (i != SAMPLE_DMA_NONE) {
             dma = &sSampleDmas[i];
-            bufferPos = devAddr - dma->source;
-            if (0 <= bufferPos && (size_t) bufferPos <= dma->bufSize - size) {
-                // We already have a DMA request for this memory range.
-                if (sSampleTTLs[i] == 0 && sSampleDmaReuseQueueTail2 != sSampleDmaReuseQueueHead2) {
-                    // Move the DMA out of the reuse queue, by swapping it with the
-                    // tail, and then incrementing the tail.
-                    if (dma->reuseIndex != sSampleDmaReuseQueueTail2) {
-                        sSampleDmaReuseQueue2[dma->reuseIndex] =
-                            sSampleDmaReuseQueue2[sSampleDmaReuseQueueTail2];
-                        sSampleDmas[sSampleDmaReuseQueue2[sSampleDmaReuseQueueTail2]].reuseIndex =
-                            dma->reuseIndex;
-                    }
-                    sSampleDmaReuseQueueTail2++;
+            // We already have a DMA request for this memory range.
+            if (sSampleDmaTtlQueueIds[i] == SAMPLE_DMA_NONE && sSampleDmaReuseQueueTail2 != sSampleDmaReuseQueueHead2) {
+                // Move the DMA out of the reuse queue, by swapping it with the
+                // tail, and then incrementing the tail.
+                if (dma->reuseIndex != sSampleDmaReuseQueueTail2) {
+                    sSampleDmaReuseQueue2[dma->reuseIndex] =
+                        sSampleDmaReuseQueue2[sSampleDmaReuseQueueTail2];
+                    sSampleDmas[sSampleDmaReuseQueue2[sSampleDmaReuseQueueTail2]].reuseIndex =
+                        dma->reuseIndex;
                 }
-                sSampleTTLs[i] = 60;
-                *dmaIndexRef = (u8) i;
-                return (devAddr - dma->source) + dma->buffer;
+                sSampleDmaReuseQueueTail2++;
             }
+            sample_dma_set_ttl(i, SAMPLE_DMA_TTL_LONG);
+            *dmaIndexRef = (u8) i;
+#ifdef PUPPYPRINT_DEBUG
+            sSampleDmaStatsCounting.hits++;
+#endif
+            return (devAddr - dma->source) + dma->buffer;
         }
 
         if (sSampleDmaReuseQueueTail2 != sSampleDmaReuseQueueHead2 && arg2 != 0) {
@@ -214,7 +334,7 @@ void *dma_sample_data(uintptr_t devAddr, u32 size, s32 arg2, u8 *dmaIndexRef) {
             dmaIndex = sSampleDmaReuseQueue2[sSampleDmaReuseQueueTail2];
             sSampleDmaReuseQueueTail2++;
             dma = sSampleDmas + dmaIndex;
-            sSampleTTLs[dmaIndex] = 2;
+            sample_dma_set_ttl(dmaIndex, SAMPLE_DMA_TTL_SHORT);
             hasDma = TRUE;
         }
     } else {
@@ -222,7 +342,7 @@ void *dma_sample_data(uintptr_t devAddr, u32 size, s32 arg2, u8 *dmaIndexRef) {
         bufferPos = devAddr - dma->source;
         if (0 <= bufferPos && (size_t) bufferPos <= dma->bufSize - size) {
             // We already have DMA for this memory range.
-            if (sSampleTTLs[*dmaIndexRef] == 0) {
+            if (sSampleDmaTtlQueueIds[*dmaIndexRef] == SAMPLE_DMA_NONE) {
                 // Move the DMA out of the reuse queue, by swapping it with the
                 // tail, and then incrementing the tail.
                 if (dma->reuseIndex != sSampleDmaReuseQueueTail1) {
@@ -233,7 +353,10 @@ void *dma_sample_data(uintptr_t devAddr, u32 size, s32 arg2, u8 *dmaIndexRef) {
                 }
                 sSampleDmaReuseQueueTail1++;
             }
-            sSampleTTLs[*dmaIndexRef] = 2;
+            sample_dma_set_ttl(*dmaIndexRef, SAMPLE_DMA_TTL_SHORT);
+#ifdef PUPPYPRINT_DEBUG
+            sSampleDmaStatsCounting.hits++;
+#endif
             return dma->buffer + (devAddr - dma->source);
         }
     }
@@ -243,13 +366,24 @@ void *dma_sample_data(uintptr_t devAddr, u32 size, s32 arg2, u8 *dmaIndexRef) {
         // be empty, since TTL 2 is so small.
         dmaIndex = sSampleDmaReuseQueue1[sSampleDmaReuseQueueTail1++];
         dma = sSampleDmas + dmaIndex;
-        sSampleTTLs[dmaIndex] = 2;
+        sample_dma_set_ttl(dmaIndex, SAMPLE_DMA_TTL_SHORT);
         hasDma = TRUE;
     }
 
+#ifdef PUPPYPRINT_DEBUG
+    sSampleDmaStatsCounting.misses++;
+    if (dma->source != 0) {
+        sSampleDmaStatsCounting.evictions++;
+    }
+#endif
+
     transfer = dma->bufSize;
     dmaDevAddr = devAddr & ~0xF;
-    dma->source = dmaDevAddr;
+    if (dmaIndex >= sSampleDmaListSize1) {
+        sample_dma_rehash(dmaIndex, dmaDevAddr);
+    } else {
+        dma->source = dmaDevAddr;
+    }
 #ifdef VERSION_US // TODO: Is there a reason this only exists in US?
     osInvalDCache(dma->buffer, transfer);
 #endif
@@ -278,9 +412,19 @@ void init_sample_dma_buffers() {
         sSampleDmas[gSampleDmaNumListItems].bufSize = sDmaBufSize;
         sSampleDmas[gSampleDmaNumListItems].source = 0;
         sSampleTTLs[gSampleDmaNumListItems] = 0;
+        sSampleDmaTtlQueueIds[gSampleDmaNumListItems] = SAMPLE_DMA_NONE;
         gSampleDmaNumListItems++;
     }
 
+    for (i = 0; i < SAMPLE_DMA_TTL_COUNT; i++) {
+        sSampleDmaTtlQueueHeads[i] = SAMPLE_DMA_NONE;
+        sSampleDmaTtlQueueTails[i] = SAMPLE_DMA_NONE;
+    }
+
+    for (i = 0; i < SAMPLE_DMA_HASH_SIZE; i++) {
+        sSampleDmaHashBuckets[i] = SAMPLE_DMA_NONE;
+    }
+
     for (i = 0; (u32) i < gSampleDmaNumListItems; i++) {
         sSampleDmaReuseQueue1[i] = (u8) i;
         sSampleDmas[i].reuseIndex = (u8) i;
@@ -304,6 +448,7 @@ void init_sample_dma_buffers() {
         sSampleDmas[gSampleDmaNumListItems].bufSize = sDmaBufSize;
         sSampleDmas[gSampleDmaNumListItems].source = 0;
         sSampleTTLs[gSampleDmaNumListItems] = 0;
+        sSampleDmaTtlQueueIds[gSampleDmaNumListItems] = SAMPLE_DMA_NONE;
         gSampleDmaNumListItems++;
     }
 
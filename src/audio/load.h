@@ -80,6 +80,17 @@ struct PatchStruct {
 extern struct UnkStructSH8034EC88 D_SH_8034EC88[0x80];
 #endif
 
+#if defined(PUPPYPRINT_DEBUG) && !defined(VERSION_SH)
+// Sample DMA cache lookups during the last audio frame
+struct SampleDmaStats {
+    u16 hits;
+    u16 misses;
+    u16 evictions;
+};
+
+extern struct SampleDmaStats gSampleDmaStats;
+#endif
+
 void audio_dma_partial_copy_async(uintptr_t *devAddr, u8 **vAddr, ssize_t *remaining, OSMesgQueue *queue, OSIoMesg *mesg);
 void decrease_sample_dma_ttls(void);
 #ifdef VERSION_SH
@@ -10,6 +10,7 @@
 #include "external.h"
 #include "game/game_init.h"
 #include "game/debug.h"
+#include "game/emutest.h"
 #include "engine/math_util.h"
 
 #define DMEM_ADDR_TEMP 0x0
@@ -25,11 +26,11 @@
 #define DMEM_ADDR_WET_LEFT_CH 0x740
 #define DMEM_ADDR_WET_RIGHT_CH 0x880
 
-#define aSetLoadBufferPair(pkt, c, off)                                                                \
+#define aSetLoadBufferPair(pkt, c, off, right)                                                         \
     aSetBuffer(pkt, 0, c + DMEM_ADDR_WET_LEFT_CH, 0, DEFAULT_LEN_1CH - c);                             \
     aLoadBuffer(pkt, VIRTUAL_TO_PHYSICAL2(gSynthesisReverb.ringBuffer.left + (off)));                  \
     aSetBuffer(pkt, 0, c + DMEM_ADDR_WET_RIGHT_CH, 0, DEFAULT_LEN_1CH - c);                            \
-    aLoadBuffer(pkt, VIRTUAL_TO_PHYSICAL2(gSynthesisReverb.ringBuffer.right + (off)));
+    aLoadBuffer(pkt, VIRTUAL_TO_PHYSICAL2((right) + (off)));
 
 #define aSetSaveBufferPair(pkt, c, d, off)                                                             \
     aSetBuffer(pkt, 0, 0, c + DMEM_ADDR_WET_LEFT_CH, d);                                               \
@@ -56,8 +57,37 @@ u8 *gReverbMults[SYNTH_CHANNEL_STEREO_COUNT];
 s32 reverbLastFilterIndex;
 s32 reverbFilterCount;
 s32 betterReverbWindowsSize;
-s32 betterReverbRevIndex; // This one is okay to adjust whenever
-s32 betterReverbGainIndex; // This one is okay to adjust whenever
+s32 betterReverbRevIndex; // This one is okay to adjust whenever (within 0-255 with BETTER_REVERB_RSP)
+s32 betterReverbGainIndex; // This one is okay to adjust whenever (within 1-255 with BETTER_REVERB_RSP)
+static u8 betterReverbMono = FALSE; // Latched once per frame, since the sound mode can change while a frame is being built
+
+#ifdef BETTER_REVERB_RSP
+// Samples per block of the A_REVERB command, must match REVERB_BLOCK_SIZE in rsp/audio.s.
+#define BETTER_REVERB_RSP_BLOCK_SIZE 64
+
+struct ReverbRspWindow {
+    u32 addr; // Physical address of the buffer
+    u16 pos;  // Offset of the first sample to process, in bytes
+    u16 size; // Size of the buffer, in bytes
+};
+
+// Parameters of an aReverb command, laid out as the RSP reads them.
+struct ReverbRspParams {
+    u16 count; // Bytes to process, a multiple of 16
+    u16 filterCount;
+    u16 mono; // Mixes the right ring buffer into the input, which is then given after the delay lines
+    u16 pad[5];
+    u16 coefs[8]; // (256 - gain) << 8, gain << 7, reverb << 8, the four reverb multipliers << 8, 0x8000
+    struct ReverbRspWindow windows[1 + NUM_ALLPASS + 1]; // Ring buffer, delay lines, right ring buffer
+};
+
+STATIC_ASSERT(sizeof(struct ReverbRspParams) == 0x90, "struct ReverbRspParams must match REVERB_PARAMS_SIZE in rsp/audio.s!");
+
+// The RSP may still be reading the last frame's parameters while the next frame is built, so there are two sets.
+static struct ReverbRspParams reverbRspParams[2][MAX_UPDATES_PER_FRAME][SYNTH_CHANNEL_STEREO_COUNT] ALIGNED16;
+static s32 reverbRspCmdCount;
+static u8 betterReverbOnRsp = FALSE;
+#endif
 #endif
 
 struct VolumeChange {
@@ -83,93 +113,145 @@ f32 *currentRampingTableLeft;
 f32 *currentRampingTableRight;
 
 #ifdef BETTER_REVERB
-static void reverb_samples(s16 *start, s16 *end, s16 *downsampleBuffer, s32 channel) {
-    s16 *curDelaySample;
-    s32 historySample;
-    s32 tmpCarryover;
-    s32 outSampleTotal;
-    s32 i;
-    s32 j;
-    s32 k;
-
-    s32 downsampleIncrement = gReverbDownsampleRate;
-    s32 *delaysLocal = betterReverbDelays[channel];
-    s32 *reverbMultsLocal = reverbMults[channel];
-    s32 *allpassIdxLocal = allpassIdx[channel];
-    s16 **delayBufsLocal = delayBufs[channel];
-
-    s32 lastFilterIndex = reverbLastFilterIndex;
-    s32 revIndex = betterReverbRevIndex;
-    s32 gainIndex = betterReverbGainIndex;
-
-    // Set j outside of the loop only. Because we're forcing filter count to always be a multiple of 3, we can count on j always being 0 when exiting the second for loop.
-    j = 0;
-
-    for (; start < end; start++, downsampleBuffer += downsampleIncrement) {
-        // Mix the very last filter output with new incoming sample
-        tmpCarryover = ((delayBufsLocal[lastFilterIndex][allpassIdxLocal[lastFilterIndex]] * revIndex) >> 8) + *downsampleBuffer;
-        outSampleTotal = 0;
-        i = 0;
-        k = 0;
-
-        for (; i <= lastFilterIndex; ++i, ++j) {
-            curDelaySample = &delayBufsLocal[i][allpassIdxLocal[i]];
-            historySample = *curDelaySample;
-
-            if (j == 2) {
-                j = -1;
-                outSampleTotal += ((historySample * reverbMultsLocal[k++]) >> 8);
-                *curDelaySample = CLAMP_S16(tmpCarryover);
-                if (i != lastFilterIndex)
-                    tmpCarryover = ((historySample * revIndex) >> 8)/* + *downsampleBuffer*/;
-            } else {
-                tmpCarryover += (historySample * (-gainIndex)) >> 8;
-                *curDelaySample = CLAMP_S16(tmpCarryover);
-                tmpCarryover = ((tmpCarryover * gainIndex) >> 8) + historySample;
-            }
+#include "better_reverb_kernel.h"
 
-            if (++allpassIdxLocal[i] == delaysLocal[i]) allpassIdxLocal[i] = 0;
-        }
+static s32 better_reverb_is_mono(void) {
+    return toggleBetterReverb && (gSoundMode == SOUND_MODE_MONO || monoReverb);
+}
 
-        *start = CLAMP_S16(outSampleTotal);
-    }
+static void reverb_samples(s16 *start, s16 *end, s16 *downsampleBuffer, s32 channel) {
+    reverb_samples_block(start, end, downsampleBuffer, gReverbDownsampleRate,
+                         delayBufs[channel], allpassIdx[channel], betterReverbDelays[channel], reverbMults[channel],
+                         reverbLastFilterIndex, betterReverbRevIndex, betterReverbGainIndex);
 }
 
 static void reverb_samples_light(s16 *start, s16 *end, s16 *downsampleBuffer, s32 channel) {
-    s16 *curDelaySample;
-    s32 historySample;
-    s32 tmpCarryover;
-    s32 i;
+    // Carry the history sample over from the last processing tick
+    historySamplesLight[channel] = reverb_samples_light_block(start, end, downsampleBuffer, gReverbDownsampleRate,
+                                                              delayBufs[channel], allpassIdx[channel], betterReverbDelays[channel],
+                                                              historySamplesLight[channel]);
+}
+
+#ifdef BETTER_REVERB_RSP
+/**
+ * The aReverb command takes the gain and reverb indices as 8 bit fractions, so it only matches the CPU within these ranges.
+ */
+static s32 better_reverb_rsp_indices_supported(void) {
+    return (betterReverbGainIndex >= 1 && betterReverbGainIndex <= 0xFF && betterReverbRevIndex >= 0 && betterReverbRevIndex <= 0xFF);
+}
+
+/**
+ * Whether the current preset can run in the aReverb command. The RSP moves every buffer in 8 byte aligned DMAs,
+ * so their sizes have to be multiples of 4 samples, and each delay line has to hold more than a whole block.
+ * HLE audio plugins replace the microcode with their own and don't know the command, so only LLE emulators are trusted.
+ */
+static s32 better_reverb_rsp_supported(s32 filterCount) {
+    if (!(gEmulator & (EMU_CONSOLE | EMU_ARES | EMU_SIMPLE64 | EMU_CEN64)) || betterReverbLightweight || gReverbDownsampleRate != 1) {
+        return FALSE;
+    }
+
+    if ((gSynthesisReverb.bufSizePerChannel % 4) != 0 || gSynthesisReverb.bufSizePerChannel <= BETTER_REVERB_RSP_BLOCK_SIZE) {
+        return FALSE;
+    }
 
-    s32 downsampleIncrement = gReverbDownsampleRate;
-    s32 *delaysLocal = betterReverbDelays[channel];
-    s32 *allpassIdxLocal = allpassIdx[channel];
-    s16 **delayBufsLocal = delayBufs[channel];
+    for (s32 channel = 0; channel < SYNTH_CHANNEL_STEREO_COUNT; channel++) {
+        for (s32 filter = 0; filter < filterCount; filter++) {
+            s32 delay = betterReverbDelays[channel][filter];
+            if ((delay % 4) != 0 || delay <= BETTER_REVERB_RSP_BLOCK_SIZE) {
+                return FALSE;
+            }
+        }
+    }
+
+    return better_reverb_rsp_indices_supported();
+}
 
-    // Get history sample from last processing tick
-    tmpCarryover = historySamplesLight[channel];
+static void set_reverb_rsp_window(struct ReverbRspWindow *window, s16 *buf, s32 pos, s32 size) {
+    window->addr = (uintptr_t) VIRTUAL_TO_PHYSICAL2(buf);
+    window->pos = pos * sizeof(s16);
+    window->size = size * sizeof(s16);
+}
 
-    for (; start < end; start++, downsampleBuffer += downsampleIncrement) {
-        // Mix previous sample with new incoming sample
-        tmpCarryover = ((tmpCarryover * BETTER_REVERB_REVERB_INDEX_LIGHT) >> 8) + *downsampleBuffer;
+/**
+ * Fills in the aReverb commands for the samples of an item, which synthesis_do_one_audio_update runs at the start of the update.
+ * The RSP only reads the delay line positions, so they're moved on here.
+ */
+static void prepare_reverb_rsp_params(struct ReverbRingBufferItem *item, u32 updateIndex) {
+    s16 *ringBuffers[SYNTH_CHANNEL_STEREO_COUNT] = {
+        [SYNTH_CHANNEL_LEFT]  = gSynthesisReverb.ringBuffer.left,
+        [SYNTH_CHANNEL_RIGHT] = gSynthesisReverb.ringBuffer.right,
+    };
+    s32 numSamples = (item->lengthA + item->lengthB) / sizeof(s16);
+    s32 filter;
 
-        for (i = 0; i < BETTER_REVERB_FILTER_COUNT_LIGHT; ++i) {
-            curDelaySample = &delayBufsLocal[i][allpassIdxLocal[i]];
-            historySample = *curDelaySample;
+    // The path is only chosen along with the preset, so indices adjusted out of range afterwards skip the filters instead.
+    if (!better_reverb_rsp_indices_supported()) {
+        assert(FALSE, "BETTER_REVERB gain or reverb index adjusted out of range while running on the RSP!");
+        return;
+    }
 
-            tmpCarryover += ((historySample * (-BETTER_REVERB_GAIN_INDEX_LIGHT)) >> 8);
-            *curDelaySample = CLAMP_S16(tmpCarryover);
-            tmpCarryover = ((tmpCarryover * BETTER_REVERB_GAIN_INDEX_LIGHT) >> 8) + historySample;
+    // Mono reverb only processes the left channel, with the right ring buffer as an extra window to mix in.
+    reverbRspCmdCount = (betterReverbMono ? 1 : SYNTH_CHANNEL_STEREO_COUNT);
+
+    for (s32 channel = 0; channel < reverbRspCmdCount; channel++) {
+        struct ReverbRspParams *params = &reverbRspParams[gSynthesisReverb.curFrame][updateIndex][channel];
+        struct ReverbRspWindow *window = params->windows;
+
+        params->count = numSamples * sizeof(s16);
+        params->filterCount = reverbFilterCount;
+        params->mono = betterReverbMono;
+        params->coefs[0] = (0x100 - betterReverbGainIndex) << 8;
+        params->coefs[1] = betterReverbGainIndex << 7;
+        params->coefs[2] = betterReverbRevIndex << 8;
+        for (filter = 0; filter < NUM_ALLPASS / 3; filter++) {
+            params->coefs[3 + filter] = ((filter < reverbFilterCount / 3) ? (reverbMults[channel][filter] << 8) : 0);
+        }
+        params->coefs[7] = 0x8000;
 
-            if (++allpassIdxLocal[i] == delaysLocal[i]) allpassIdxLocal[i] = 0;
+        set_reverb_rsp_window(window++, ringBuffers[channel], item->startPos, gSynthesisReverb.bufSizePerChannel);
+        for (filter = 0; filter < reverbFilterCount; filter++) {
+            set_reverb_rsp_window(window++, delayBufs[channel][filter], allpassIdx[channel][filter], betterReverbDelays[channel][filter]);
+            allpassIdx[channel][filter] = (allpassIdx[channel][filter] + numSamples) % betterReverbDelays[channel][filter];
+        }
+        if (betterReverbMono) {
+            set_reverb_rsp_window(window, ringBuffers[SYNTH_CHANNEL_RIGHT], item->startPos, gSynthesisReverb.bufSizePerChannel);
         }
+    }
+}
+#endif
+
+// Everything below the wet channels is free at the start of a frame.
+#define REVERB_COPY_CHUNK_SIZE DMEM_ADDR_WET_LEFT_CH
+
+/**
+ * Mono reverb is only processed into the left ring buffer, which leaves dry samples in the right one.
+ * When reverb turns back to stereo, copy the processed samples that haven't been played yet over to the right ring buffer,
+ * so that the dry ones aren't heard. The samples of the last two frames haven't been processed yet and are left alone.
+ */
+static u64 *copy_mono_reverb_to_right(u64 *cmd) {
+    s32 size = gSynthesisReverb.bufSizePerChannel * sizeof(s16);
+    s32 pos = (gSynthesisReverb.nextRingBufferPos * sizeof(s16)) & ~7;
+    s32 end = (gSynthesisReverb.items[gSynthesisReverb.curFrame][0].startPos * sizeof(s16)) & ~7;
+    s32 count = end - pos;
+    s32 chunkSize;
+
+    if (count < 0) {
+        count += size;
+    }
 
-        // Lightweight does not use the final filter type at all, unlike standard reverb processing
-        *start = CLAMP_S16(tmpCarryover);
+    while (count > 0) {
+        chunkSize = MIN(count, MIN(size - pos, REVERB_COPY_CHUNK_SIZE));
+        aSetBuffer(cmd++, 0, DMEM_ADDR_TEMP, DMEM_ADDR_TEMP, chunkSize);
+        aLoadBuffer(cmd++, VIRTUAL_TO_PHYSICAL2((u8 *) gSynthesisReverb.ringBuffer.left + pos));
+        aSaveBuffer(cmd++, VIRTUAL_TO_PHYSICAL2((u8 *) gSynthesisReverb.ringBuffer.right + pos));
+        count -= chunkSize;
+        pos += chunkSize;
+        if (pos >= size) {
+            pos = 0;
+        }
     }
-    
-    // Copy history sample to temporary buffer for processing next tick
-    historySamplesLight[channel] = tmpCarryover;
+
+    return cmd;
 }
 
 void initialize_better_reverb_buffers(void) {
@@ -189,6 +271,9 @@ void set_better_reverb_buffers(u32 *inputDelaysL, u32 *inputDelaysR) {
         filterCount = BETTER_REVERB_FILTER_COUNT_LIGHT;
 
     gBetterReverbPool.cur = gBetterReverbPool.start + BETTER_REVERB_PTR_SIZE; // Reset reverb data pool
+#ifdef BETTER_REVERB_RSP
+    betterReverbOnRsp = FALSE;
+#endif
 
     // Don't bother setting any buffers if BETTER_REVERB is disabled
     if (!toggleBetterReverb)
@@ -208,6 +293,12 @@ void set_better_reverb_buffers(u32 *inputDelaysL, u32 *inputDelaysR) {
     aggress(bufOffset * sizeof(s16) <= BETTER_REVERB_SIZE - BETTER_REVERB_PTR_SIZE, "BETTER_REVERB_SIZE is too small for this preset!");
 
     bzero(allpassIdx, sizeof(allpassIdx));
+
+#ifdef BETTER_REVERB_RSP
+    // Only decided here, while no audio task is running. The RSP may still be working on the last frame when the next one
+    // is built, so switching between the CPU and the RSP any later could have both of them run the filters at once.
+    betterReverbOnRsp = better_reverb_rsp_supported(filterCount);
+#endif
 }
 #endif
 
@@ -217,6 +308,10 @@ void prepare_reverb_ring_buffer(s32 chunkLen, u32 updateIndex) {
     s32 nSamples;
     s32 excessiveSamples;
 
+#ifdef BETTER_REVERB_RSP
+    reverbRspCmdCount = 0;
+#endif
+
     if (gSynthesisReverb.framesLeftToIgnore == 0) {
 #ifdef BETTER_REVERB
         if (!toggleBetterReverb && gReverbDownsampleRate != 1) {
@@ -241,6 +336,11 @@ void prepare_reverb_ring_buffer(s32 chunkLen, u32 updateIndex) {
             }
         }
 #ifdef BETTER_REVERB
+#ifdef BETTER_REVERB_RSP
+        else if (toggleBetterReverb && betterReverbOnRsp) {
+            prepare_reverb_rsp_params(&gSynthesisReverb.items[gSynthesisReverb.curFrame][updateIndex], updateIndex);
+        }
+#endif
         else if (toggleBetterReverb) {
             s32 loopCounts[2];
 
@@ -275,18 +375,19 @@ void prepare_reverb_ring_buffer(s32 chunkLen, u32 updateIndex) {
                 betterReverbDownsampleBuffers[SYNTH_CHANNEL_RIGHT][1] = betterReverbSampleBuffers[SYNTH_CHANNEL_RIGHT][1];
             }
 
-            if (gSoundMode == SOUND_MODE_MONO || monoReverb) {
+            if (betterReverbMono) {
                 for (srcPos = 0; srcPos < ARRAY_COUNT(loopCounts); srcPos++) { // LengthA and LengthB processing
                     s16 *downsampleBufferL = betterReverbDownsampleBuffers[SYNTH_CHANNEL_LEFT][srcPos];
                     s16 *downsampleBufferR = betterReverbDownsampleBuffers[SYNTH_CHANNEL_RIGHT][srcPos];
-                    for (dstPos = 0; dstPos < loopCounts[srcPos]; dstPos += gReverbDownsampleRate) { // Individual sample processing
+                    // The filters read every gReverbDownsampleRate-th sample of the downsample buffers, loopCounts[srcPos] times.
+                    for (dstPos = 0; dstPos < loopCounts[srcPos] * gReverbDownsampleRate; dstPos += gReverbDownsampleRate) { // Individual sample processing
                         downsampleBufferL[dstPos] = ((s32) downsampleBufferL[dstPos] + (s32) downsampleBufferR[dstPos]) >> 1; // Merge stereo samples into left channel
                     }
                 }
                 for (srcPos = 0; srcPos < ARRAY_COUNT(loopCounts); srcPos++) { // LengthA and LengthB processing
                     // Call core reverb processing function, either reverb_samples() or reverb_samples_light()
                     (*reverbFunc)(betterReverbSampleBuffers[SYNTH_CHANNEL_LEFT][srcPos], betterReverbSampleBuffers[SYNTH_CHANNEL_LEFT][srcPos] + loopCounts[srcPos], betterReverbDownsampleBuffers[SYNTH_CHANNEL_LEFT][srcPos], SYNTH_CHANNEL_LEFT);
-                    bcopy(betterReverbSampleBuffers[SYNTH_CHANNEL_LEFT][srcPos], betterReverbSampleBuffers[SYNTH_CHANNEL_RIGHT][srcPos], loopCounts[srcPos] * sizeof(s16));
+                    // The RSP loads the left ring buffer into both wet channels, so the right one isn't written.
                 }
             } else {
                 for (dstPos = 0; dstPos < SYNTH_CHANNEL_STEREO_COUNT; dstPos++) { // left and right channels
@@ -358,6 +459,12 @@ u64 *synthesis_execute(u64 *cmdBuf, s32 *writtenCmds, s16 *aiBuf, s32 bufLen) {
         reverbMults[SYNTH_CHANNEL_LEFT][0] = (reverbMults[SYNTH_CHANNEL_RIGHT][0] + reverbMults[SYNTH_CHANNEL_LEFT][0]) / 2;
         reverbMults[SYNTH_CHANNEL_RIGHT][0] = reverbMults[SYNTH_CHANNEL_LEFT][0];
     }
+
+    s32 wasMono = betterReverbMono;
+    betterReverbMono = better_reverb_is_mono();
+    if (wasMono && !betterReverbMono && gSynthesisReverb.useReverb && gSynthesisReverb.framesLeftToIgnore == 0) {
+        cmd = copy_mono_reverb_to_right(cmd);
+    }
 #endif
 
     for (i = gAudioUpdatesPerFrame; i > 0; i--) {
@@ -404,9 +511,17 @@ u64 *synthesis_do_one_audio_update(s16 *aiBuf, u32 bufLen, u64 *cmd, s32 updateI
     s16 ra;
     s16 t4;
     struct ReverbRingBufferItem *v1;
+    s16 *ringBufferRight = gSynthesisReverb.ringBuffer.right;
 
     v1 = &gSynthesisReverb.items[gSynthesisReverb.curFrame][updateIndex];
 
+#ifdef BETTER_REVERB
+    // Mono reverb is only processed into the left ring buffer, and loaded into both wet channels from there.
+    if (betterReverbMono) {
+        ringBufferRight = gSynthesisReverb.ringBuffer.left;
+    }
+#endif
+
     if (!gSynthesisReverb.useReverb) {
         aClearBuffer(cmd++, DMEM_ADDR_LEFT_CH, DEFAULT_LEN_2CH);
 
@@ -414,12 +529,18 @@ u64 *synthesis_do_one_audio_update(s16 *aiBuf, u32 bufLen, u64 *cmd, s32 updateI
         cmd = synthesis_process_notes(aiBuf, bufLen, cmd);
         AUDIO_PROFILER_SWITCH(PROFILER_TIME_SUB_AUDIO_SYNTHESIS_PROCESSING, PROFILER_TIME_SUB_AUDIO_SYNTHESIS_ENVELOPE_REVERB);
     } else {
+#ifdef BETTER_REVERB_RSP
+        // Run the filters over the samples saved two frames ago, as set up by prepare_reverb_ring_buffer.
+        for (s32 channel = 0; channel < reverbRspCmdCount; channel++) {
+            aReverb(cmd++, VIRTUAL_TO_PHYSICAL2(&reverbRspParams[gSynthesisReverb.curFrame][updateIndex][channel]));
+        }
+#endif
         if (gReverbDownsampleRate == 1) {
             // Put the oldest samples in the ring buffer into the wet channels
-            aSetLoadBufferPair(cmd++, 0, v1->startPos);
+            aSetLoadBufferPair(cmd++, 0, v1->startPos, ringBufferRight);
             if (v1->lengthB != 0) {
                 // Ring buffer wrapped
-                aSetLoadBufferPair(cmd++, v1->lengthA, 0);
+                aSetLoadBufferPair(cmd++, v1->lengthA, 0, ringBufferRight);
             }
 
             // Use the reverb sound as initial sound for this audio update
@@ -435,10 +556,10 @@ u64 *synthesis_do_one_audio_update(s16 *aiBuf, u32 bufLen, u64 *cmd, s32 updateI
             // Same as above but upsample the previously downsampled samples used for reverb first
             t4 = (v1->startPos & 7) * 2;
             ra = ALIGN16(v1->lengthA + t4);
-            aSetLoadBufferPair(cmd++, 0, v1->startPos - t4 / 2);
+            aSetLoadBufferPair(cmd++, 0, v1->startPos - t4 / 2, ringBufferRight);
             if (v1->lengthB != 0) {
                 // Ring buffer wrapped
-                aSetLoadBufferPair(cmd++, ra, 0);
+                aSetLoadBufferPair(cmd++, ra, 0, ringBufferRight);
             }
             aSetBuffer(cmd++, 0, t4 + DMEM_ADDR_WET_LEFT_CH, DMEM_ADDR_LEFT_CH, bufLen);
             aResample(cmd++, gSynthesisReverb.resampleFlags, (u16) gSynthesisReverb.resampleRate, VIRTUAL_TO_PHYSICAL2(gSynthesisReverb.resampleStateLeft));
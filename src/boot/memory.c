@@ -367,6 +367,117 @@ void *load_to_fixed_pool_addr(u8 *destAddr, u8 *srcStart, u8 *srcEnd) {
     return dest;
 }
 
+#ifdef STREAM_DECOMPRESS
+#define STREAM_BLOCK_SIZE 0x1000 // Size of each DMA into the ring buffer.
+#define STREAM_NUM_BLOCKS 4      // Number of blocks in the ring buffer, all but one of them are being read while the last is decompressed.
+
+/**
+ * State of the ring buffer that compressed data is streamed through.
+ * Block n of the segment is read into ring slot (n % STREAM_NUM_BLOCKS).
+ */
+static struct {
+    u8 *ring;
+    u8 *srcStart;
+    u8 *srcEnd;
+    s32 nextRead;  // Next block of the segment to start reading
+    s32 nextBlock; // Next block of the segment to hand to the decompressor
+    s32 numBlocks;
+} sStream;
+
+static OSIoMesg sStreamIoMesgs[STREAM_NUM_BLOCKS];
+static OSMesg sStreamMesgBuf[STREAM_NUM_BLOCKS];
+static OSMesgQueue sStreamMesgQueue;
+
+/**
+ * Start reading the next block of the segment into its ring slot, without waiting for it.
+ */
+static void stream_start_read(void) {
+    s32 slot = (sStream.nextRead % STREAM_NUM_BLOCKS);
+    u8 *src = (sStream.srcStart + (sStream.nextRead * STREAM_BLOCK_SIZE));
+    u8 *dest = (sStream.ring + (slot * STREAM_BLOCK_SIZE));
+    u32 size = MIN(STREAM_BLOCK_SIZE, ALIGN16(sStream.srcEnd - src));
+
+    osInvalDCache(dest, size);
+    osPiStartDma(&sStreamIoMesgs[slot], OS_MESG_PRI_NORMAL, OS_READ, (uintptr_t) src, dest, size, &sStreamMesgQueue);
+    sStream.nextRead++;
+}
+
+/**
+ * Hands the decompressor the next block once it has arrived. The block it was using
+ * before is finished with at this point, so its slot starts reading the next block
+ * that isn't in the ring yet.
+ */
+static u8 *stream_read_block(u32 *length) {
+    if (sStream.nextBlock >= sStream.numBlocks) {
+        *length = 0;
+        return NULL;
+    }
+
+    if (sStream.nextBlock > 0 && sStream.nextRead < sStream.numBlocks) {
+        stream_start_read();
+    }
+
+    // Reads complete in the order they were started.
+    osRecvMesg(&sStreamMesgQueue, NULL, OS_MESG_BLOCK);
+
+    u8 *src = (sStream.srcStart + (sStream.nextBlock * STREAM_BLOCK_SIZE));
+    u8 *block = (sStream.ring + ((sStream.nextBlock % STREAM_NUM_BLOCKS) * STREAM_BLOCK_SIZE));
+    *length = MIN(STREAM_BLOCK_SIZE, (u32)(sStream.srcEnd - src));
+    sStream.nextBlock++;
+
+    return block;
+}
+
+/**
+ * Decompress the block of ROM data from srcStart to srcEnd while it is being read, instead of
+ * reading it into a buffer first. Only a small ring buffer is needed for the compressed data,
+ * and the reads overlap with decompression. Set the base address of segment to the result.
+ */
+void *load_segment_decompress(s32 segment, u8 *srcStart, u8 *srcEnd) {
+    void *dest = NULL;
+    u32 size = 0;
+    s32 i;
+
+    sStream.ring = main_pool_alloc((STREAM_BLOCK_SIZE * STREAM_NUM_BLOCKS), MEMORY_POOL_RIGHT);
+    if (sStream.ring != NULL) {
+        // Decompressed size from end of gzip
+        dma_read(sStream.ring, (srcEnd - 16), srcEnd);
+        size = *(u32 *) (sStream.ring + 16 - 4);
+
+        dest = main_pool_alloc(size, MEMORY_POOL_LEFT);
+        if (dest != NULL) {
+            sStream.srcStart = srcStart;
+            sStream.srcEnd = (srcEnd - 4);
+            sStream.nextRead = 0;
+            sStream.nextBlock = 0;
+            sStream.numBlocks = (((sStream.srcEnd - srcStart) + STREAM_BLOCK_SIZE - 1) / STREAM_BLOCK_SIZE);
+
+            osCreateMesgQueue(&sStreamMesgQueue, sStreamMesgBuf, STREAM_NUM_BLOCKS);
+            for (i = 0; i < STREAM_NUM_BLOCKS && i < sStream.numBlocks; i++) {
+                stream_start_read();
+            }
+
+            osSyncPrintf("start decompress\n");
+            expand_gzip_stream(stream_read_block, dest, size);
+            osSyncPrintf("end decompress\n");
+
+            // The decompressor stops at the end of the deflate stream, so the trailer may still be in flight.
+            while (sStream.nextBlock < sStream.nextRead) {
+                osRecvMesg(&sStreamMesgQueue, NULL, OS_MESG_BLOCK);
+                sStream.nextBlock++;
+            }
+
+            set_segment_base_addr(segment, dest);
+        }
+        main_pool_free(sStream.ring);
+    }
+#ifdef PUPPYPRINT_DEBUG
+    u32 ppSize = ALIGN16(size) + 16;
+    set_segment_memory_printout(segment, ppSize);
+#endif
+    return dest;
+}
+#else
 /**
  * Decompress the block of ROM data from srcStart to srcEnd and return a
  * pointer to an allocated buffer holding the decompressed data. Set the
@@ -420,6 +531,7 @@ void *load_segment_decompress(s32 segment, u8 *srcStart, u8 *srcEnd) {
 #endif
     return dest;
 }
+#endif
 
 void load_engine_code_segment(void) {
     void *startAddr = (void *) _engineSegmentStart;
@@ -14,6 +14,7 @@
 #include "math_util.h"
 #include "graph_node.h"
 #include "surface_collision.h"
+#include "game/profiling.h"
 
 // Macros for retrieving arguments from behavior scripts.
 #define BHV_CMD_GET_1ST_U8(index)     (u8)((gCurBhvCommand[index] >> 24) & 0xFF) // unused
@@ -812,8 +813,519 @@ static BhvCommandProc BehaviorCmdTable[] = {
     /*BHV_CMD_SPAWN_WATER_DROPLET   */ bhv_cmd_spawn_water_droplet,
 };
 
+#ifdef PREDECODE_BEHAVIORS
+// Length of each behavior command in words.
+static const u8 BehaviorCmdLengths[] = {
+    /*BHV_CMD_BEGIN                 */ 1,
+    /*BHV_CMD_DELAY                 */ 1,
+    /*BHV_CMD_CALL                  */ 2,
+    /*BHV_CMD_RETURN                */ 1,
+    /*BHV_CMD_GOTO                  */ 2,
+    /*BHV_CMD_BEGIN_REPEAT          */ 1,
+    /*BHV_CMD_END_REPEAT            */ 1,
+    /*BHV_CMD_END_REPEAT_CONTINUE   */ 1,
+    /*BHV_CMD_BEGIN_LOOP            */ 1,
+    /*BHV_CMD_END_LOOP              */ 1,
+    /*BHV_CMD_BREAK                 */ 1,
+    /*BHV_CMD_BREAK_UNUSED          */ 1,
+    /*BHV_CMD_CALL_NATIVE           */ 1,
+    /*BHV_CMD_ADD_FLOAT             */ 1,
+    /*BHV_CMD_SET_FLOAT             */ 1,
+    /*BHV_CMD_ADD_INT               */ 1,
+    /*BHV_CMD_SET_INT               */ 1,
+    /*BHV_CMD_OR_INT                */ 1,
+    /*BHV_CMD_OR_LONG               */ 2,
+    /*BHV_CMD_BIT_CLEAR             */ 1,
+    /*BHV_CMD_SET_INT_RAND_RSHIFT   */ 2,
+    /*BHV_CMD_SET_RANDOM_FLOAT      */ 2,
+    /*BHV_CMD_SET_RANDOM_INT        */ 2,
+    /*BHV_CMD_ADD_RANDOM_FLOAT      */ 2,
+    /*BHV_CMD_ADD_INT_RAND_RSHIFT   */ 2,
+    /*BHV_CMD_NOP_1                 */ 1,
+    /*BHV_CMD_NOP_2                 */ 1,
+    /*BHV_CMD_SET_MODEL             */ 1,
+    /*BHV_CMD_SPAWN_CHILD           */ 3,
+    /*BHV_CMD_DEACTIVATE            */ 1,
+    /*BHV_CMD_DROP_TO_FLOOR         */ 1,
+    /*BHV_CMD_SUM_FLOAT             */ 1,
+    /*BHV_CMD_SUM_INT               */ 1,
+    /*BHV_CMD_BILLBOARD             */ 1,
+    /*BHV_CMD_HIDE                  */ 1,
+    /*BHV_CMD_SET_HITBOX            */ 2,
+    /*BHV_CMD_NOP_4                 */ 1,
+    /*BHV_CMD_DELAY_VAR             */ 1,
+    /*BHV_CMD_BEGIN_REPEAT_UNUSED   */ 1,
+    /*BHV_CMD_LOAD_ANIMATIONS       */ 2,
+    /*BHV_CMD_ANIMATE               */ 1,
+    /*BHV_CMD_SPAWN_CHILD_WITH_PA   */ 3,
+    /*BHV_CMD_LOAD_COLLISION_DATA   */ 2,
+    /*BHV_CMD_SET_HITBOX_WITH_OFF   */ 3,
+    /*BHV_CMD_SPAWN_OBJ             */ 3,
+    /*BHV_CMD_SET_HOME              */ 1,
+    /*BHV_CMD_SET_HURTBOX           */ 2,
+    /*BHV_CMD_SET_INTERACT_TYPE     */ 2,
+    /*BHV_CMD_SET_OBJ_PHYSICS       */ 5,
+    /*BHV_CMD_SET_INTERACT_SUBTYPE  */ 2,
+    /*BHV_CMD_SCALE                 */ 1,
+    /*BHV_CMD_PARENT_BIT_CLEAR      */ 2,
+    /*BHV_CMD_ANIMATE_TEXTURE       */ 1,
+    /*BHV_CMD_DISABLE_RENDERING     */ 1,
+    /*BHV_CMD_SET_INT_UNUSED        */ 2,
+    /*BHV_CMD_SPAWN_WATER_DROPLET   */ 1,
+};
+STATIC_ASSERT(ARRAY_COUNT(BehaviorCmdLengths) == ARRAY_COUNT(BehaviorCmdTable), "Every behavior command needs a length!");
+
+// Instructions that can be decoded at once, shared by all scripts. Cleared when the level's objects are.
+#define BHV_INSTR_POOL_SIZE 1024
+// Scripts that can be decoded at once, including the ones jumped to with CALL or GOTO. Must be a power of two.
+#define BHV_SCRIPT_CACHE_SIZE 256
+// Longest script that will be decoded, in commands.
+#define BHV_SCRIPT_MAX_LENGTH 64
+// How deep CALL and GOTO targets are decoded before giving up.
+#define BHV_SCRIPT_MAX_DEPTH 8
+
+typedef s32 (*BhvInstrProc)(void);
+
+union BhvInstrArg {
+    s32 i;
+    f32 f;
+    const void *ptr;
+};
+
+/**
+ * A pre-decoded behavior command. A script is decoded into an array of these that's run in order,
+ * except where a command jumps, so every command that doesn't jump moves on to the next instruction.
+ * The behavior stack holds instruction addresses instead of command addresses while a script is run this way.
+ */
+struct BhvInstr {
+    BhvInstrProc proc;
+    const BehaviorScript *cmd; // The command this was decoded from
+    union BhvInstrArg args[2];
+};
+
+struct BhvScriptCacheEntry {
+    const BehaviorScript *script;
+    const struct BhvInstr *instrs; // NULL if the script couldn't be decoded
+};
+
+static struct BhvInstr sBhvInstrPool[BHV_INSTR_POOL_SIZE];
+static s32 sBhvInstrPoolUsed = 0;
+static struct BhvScriptCacheEntry sBhvScriptCache[BHV_SCRIPT_CACHE_SIZE];
+static s32 sBhvScriptCacheUsed = 0;
+// Scripts added while decoding the current script and the scripts it jumps to, which all fail together.
+static struct BhvScriptCacheEntry *sBhvScriptsDecoding[BHV_SCRIPT_CACHE_SIZE];
+static s32 sNumBhvScriptsDecoding;
+
+// The object's instruction when its script couldn't be decoded, so it keeps being interpreted.
+static const struct BhvInstr sBhvInstrInterpret;
+
+static const struct BhvInstr *sCurBhvInstr;
+
+// Runs the original command, for the commands that aren't worth decoding. They never jump, so if the command
+// moved on, so does the instruction.
+static s32 bhv_instr_interpret(void) {
+    BhvCommandProc bhvCmdProc = sCurBhvInstr->args[0].ptr;
+    s32 bhvProcResult;
+
+    gCurBhvCommand = sCurBhvInstr->cmd;
+    bhvProcResult = bhvCmdProc();
+    if (gCurBhvCommand != sCurBhvInstr->cmd) {
+        sCurBhvInstr++;
+    }
+
+    return bhvProcResult;
+}
+
+// BHV_CMD_BEGIN, BHV_CMD_NOP_1, BHV_CMD_NOP_2, BHV_CMD_NOP_4
+static s32 bhv_instr_nop(void) {
+    sCurBhvInstr++;
+    return BHV_PROC_CONTINUE;
+}
+
+// BHV_CMD_DELAY
+static s32 bhv_instr_delay(void) {
+    if (gCurrentObject->bhvDelayTimer < sCurBhvInstr->args[0].i - 1) {
+        gCurrentObject->bhvDelayTimer++;
+    } else {
+        gCurrentObject->bhvDelayTimer = 0;
+        sCurBhvInstr++;
+    }
+
+    return BHV_PROC_BREAK;
+}
+
+// BHV_CMD_CALL
+static s32 bhv_instr_call(void) {
+    cur_obj_bhv_stack_push((uintptr_t) (sCurBhvInstr + 1));
+    sCurBhvInstr = sCurBhvInstr->args[0].ptr;
+    return BHV_PROC_CONTINUE;
+}
+
+// BHV_CMD_RETURN
+static s32 bhv_instr_return(void) {
+    sCurBhvInstr = (const struct BhvInstr *) cur_obj_bhv_stack_pop();
+    return BHV_PROC_CONTINUE;
+}
+
+// BHV_CMD_GOTO
+static s32 bhv_instr_goto(void) {
+    sCurBhvInstr = sCurBhvInstr->args[0].ptr;
+    return BHV_PROC_CONTINUE;
+}
+
+// BHV_CMD_BEGIN_REPEAT, BHV_CMD_BEGIN_REPEAT_UNUSED
+static s32 bhv_instr_begin_repeat(void) {
+    cur_obj_bhv_stack_push((uintptr_t) (sCurBhvInstr + 1));
+    cur_obj_bhv_stack_push(sCurBhvInstr->args[0].i);
+
+    sCurBhvInstr++;
+    return BHV_PROC_CONTINUE;
+}
+
+// BHV_CMD_END_REPEAT, BHV_CMD_END_REPEAT_CONTINUE. The result is decoded from which of the two it is.
+static s32 bhv_instr_end_repeat(void) {
+    u32 count = cur_obj_bhv_stack_pop() - 1;
+    s32 bhvProcResult = sCurBhvInstr->args[0].i;
+
+    if (count != 0) {
+        sCurBhvInstr = (const struct BhvInstr *) cur_obj_bhv_stack_pop();
+        cur_obj_bhv_stack_push((uintptr_t) sCurBhvInstr);
+        cur_obj_bhv_stack_push(count);
+    } else {
+        cur_obj_bhv_stack_pop();
+        sCurBhvInstr++;
+    }
+
+    return bhvProcResult;
+}
+
+// BHV_CMD_BEGIN_LOOP
+static s32 bhv_instr_begin_loop(void) {
+    cur_obj_bhv_stack_push((uintptr_t) (sCurBhvInstr + 1));
+
+    sCurBhvInstr++;
+    return BHV_PROC_CONTINUE;
+}
+
+// BHV_CMD_END_LOOP
+static s32 bhv_instr_end_loop(void) {
+    sCurBhvInstr = (const struct BhvInstr *) cur_obj_bhv_stack_pop();
+    cur_obj_bhv_stack_push((uintptr_t) sCurBhvInstr);
+
+    return BHV_PROC_BREAK;
+}
+
+// BHV_CMD_BREAK, BHV_CMD_BREAK_UNUSED
+static s32 bhv_instr_break(void) {
+    return BHV_PROC_BREAK;
+}
+
+// BHV_CMD_CALL_NATIVE
+static s32 bhv_instr_call_native(void) {
+    NativeBhvFunc behaviorFunc = sCurBhvInstr->args[0].ptr;
+
+    behaviorFunc();
+
+    sCurBhvInstr++;
+    return BHV_PROC_CONTINUE;
+}
+
+// BHV_CMD_SET_INT
+static s32 bhv_instr_set_int(void) {
+    cur_obj_set_int(sCurBhvInstr->args[0].i, sCurBhvInstr->args[1].i);
+
+    sCurBhvInstr++;
+    return BHV_PROC_CONTINUE;
+}
+
+// BHV_CMD_ADD_INT
+static s32 bhv_instr_add_int(void) {
+    cur_obj_add_int(sCurBhvInstr->args[0].i, sCurBhvInstr->args[1].i);
+
+    sCurBhvInstr++;
+    return BHV_PROC_CONTINUE;
+}
+
+// BHV_CMD_OR_INT, BHV_CMD_OR_LONG
+static s32 bhv_instr_or_int(void) {
+    cur_obj_or_int(sCurBhvInstr->args[0].i, sCurBhvInstr->args[1].i);
+
+    sCurBhvInstr++;
+    return BHV_PROC_CONTINUE;
+}
+
+// BHV_CMD_BIT_CLEAR, with the bits to keep decoded
+static s32 bhv_instr_and_int(void) {
+    cur_obj_and_int(sCurBhvInstr->args[0].i, sCurBhvInstr->args[1].i);
+
+    sCurBhvInstr++;
+    return BHV_PROC_CONTINUE;
+}
+
+// BHV_CMD_SET_FLOAT
+static s32 bhv_instr_set_float(void) {
+    cur_obj_set_float(sCurBhvInstr->args[0].i, sCurBhvInstr->args[1].f);
+
+    sCurBhvInstr++;
+    return BHV_PROC_CONTINUE;
+}
+
+// BHV_CMD_ADD_FLOAT
+static s32 bhv_instr_add_float(void) {
+    cur_obj_add_float(sCurBhvInstr->args[0].i, sCurBhvInstr->args[1].f);
+
+    sCurBhvInstr++;
+    return BHV_PROC_CONTINUE;
+}
+
+// BHV_CMD_ANIMATE_TEXTURE
+static s32 bhv_instr_animate_texture(void) {
+    if ((gGlobalTimer % sCurBhvInstr->args[1].i) == 0) {
+        cur_obj_add_int(sCurBhvInstr->args[0].i, 1);
+    }
+
+    sCurBhvInstr++;
+    return BHV_PROC_CONTINUE;
+}
+
+static const struct BhvInstr *bhv_decode_script(const BehaviorScript *script, s32 depth);
+
+/**
+ * Decodes the command at cmd into instr. Returns FALSE if it can't be decoded.
+ */
+static s32 bhv_decode_cmd(struct BhvInstr *instr, const BehaviorScript *cmd, s32 depth) {
+    const BehaviorScript *prevCmd = gCurBhvCommand;
+    s32 success = TRUE;
+
+    instr->cmd = cmd;
+    instr->args[0].i = 0;
+    instr->args[1].i = 0;
+
+    // The argument macros read from gCurBhvCommand.
+    gCurBhvCommand = cmd;
+    switch (cmd[0] >> 24) {
+        case 0x00: // BHV_CMD_BEGIN
+        case 0x19: // BHV_CMD_NOP_1
+        case 0x1A: // BHV_CMD_NOP_2
+        case 0x24: // BHV_CMD_NOP_4
+            instr->proc = bhv_instr_nop;
+            break;
+        case 0x01: // BHV_CMD_DELAY
+            instr->proc = bhv_instr_delay;
+            instr->args[0].i = BHV_CMD_GET_2ND_S16(0);
+            break;
+        case 0x02: // BHV_CMD_CALL
+            instr->proc = bhv_instr_call;
+            instr->args[0].ptr = bhv_decode_script(segmented_to_virtual(BHV_CMD_GET_VPTR(1)), depth + 1);
+            success = (instr->args[0].ptr != NULL);
+            break;
+        case 0x03: // BHV_CMD_RETURN
+            instr->proc = bhv_instr_return;
+            break;
+        case 0x04: // BHV_CMD_GOTO
+            instr->proc = bhv_instr_goto;
+            instr->args[0].ptr = bhv_decode_script(segmented_to_virtual(BHV_CMD_GET_VPTR(1)), depth + 1);
+            success = (instr->args[0].ptr != NULL);
+            break;
+        case 0x05: // BHV_CMD_BEGIN_REPEAT
+            instr->proc = bhv_instr_begin_repeat;
+            instr->args[0].i = BHV_CMD_GET_2ND_S16(0);
+            break;
+        case 0x26: // BHV_CMD_BEGIN_REPEAT_UNUSED
+            instr->proc = bhv_instr_begin_repeat;
+            instr->args[0].i = BHV_CMD_GET_2ND_U8(0);
+            break;
+        case 0x06: // BHV_CMD_END_REPEAT
+            instr->proc = bhv_instr_end_repeat;
+            instr->args[0].i = BHV_PROC_BREAK;
+            break;
+        case 0x07: // BHV_CMD_END_REPEAT_CONTINUE
+            instr->proc = bhv_instr_end_repeat;
+            instr->args[0].i = BHV_PROC_CONTINUE;
+            break;
+        case 0x08: // BHV_CMD_BEGIN_LOOP
+            instr->proc = bhv_instr_begin_loop;
+            break;
+        case 0x09: // BHV_CMD_END_LOOP
+            instr->proc = bhv_instr_end_loop;
+            break;
+        case 0x0A: // BHV_CMD_BREAK
+        case 0x0B: // BHV_CMD_BREAK_UNUSED
+            instr->proc = bhv_instr_break;
+            break;
+        case 0x0C: // BHV_CMD_CALL_NATIVE
+            instr->proc = bhv_instr_call_native;
+            instr->args[0].ptr = BHV_CMD_GET_VPTR_SMALL(0);
+            break;
+        case 0x0D: // BHV_CMD_ADD_FLOAT
+            instr->proc = bhv_instr_add_float;
+            instr->args[0].i = BHV_CMD_GET_2ND_U8(0);
+            instr->args[1].f = BHV_CMD_GET_2ND_S16(0);
+            break;
+        case 0x0E: // BHV_CMD_SET_FLOAT
+            instr->proc = bhv_instr_set_float;
+            instr->args[0].i = BHV_CMD_GET_2ND_U8(0);
+            instr->args[1].f = BHV_CMD_GET_2ND_S16(0);
+            break;
+        case 0x0F: // BHV_CMD_ADD_INT
+            instr->proc = bhv_instr_add_int;
+            instr->args[0].i = BHV_CMD_GET_2ND_U8(0);
+            instr->args[1].i = BHV_CMD_GET_2ND_S16(0);
+            break;
+        case 0x10: // BHV_CMD_SET_INT
+            instr->proc = bhv_instr_set_int;
+            instr->args[0].i = BHV_CMD_GET_2ND_U8(0);
+            instr->args[1].i = BHV_CMD_GET_2ND_S16(0);
+            break;
+        case 0x11: // BHV_CMD_OR_INT
+            instr->proc = bhv_instr_or_int;
+            instr->args[0].i = BHV_CMD_GET_2ND_U8(0);
+            instr->args[1].i = BHV_CMD_GET_2ND_S16(0) & 0xFFFF;
+            break;
+        case 0x12: // BHV_CMD_OR_LONG
+            instr->proc = bhv_instr_or_int;
+            instr->args[0].i = BHV_CMD_GET_2ND_U8(0);
+            instr->args[1].i = BHV_CMD_GET_U32(1);
+            break;
+        case 0x13: // BHV_CMD_BIT_CLEAR
+            instr->proc = bhv_instr_and_int;
+            instr->args[0].i = BHV_CMD_GET_2ND_U8(0);
+            instr->args[1].i = (BHV_CMD_GET_2ND_S16(0) & 0xFFFF) ^ 0xFFFF;
+            break;
+        case 0x34: // BHV_CMD_ANIMATE_TEXTURE
+            instr->proc = bhv_instr_animate_texture;
+            instr->args[0].i = BHV_CMD_GET_2ND_U8(0);
+            instr->args[1].i = BHV_CMD_GET_2ND_S16(0);
+            break;
+        default:
+            instr->proc = bhv_instr_interpret;
+            instr->args[0].ptr = BehaviorCmdTable[cmd[0] >> 24];
+            break;
+    }
+    gCurBhvCommand = prevCmd;
+
+    return success;
+}
+
+/**
+ * Returns whether the script never runs past this command on its own, which is where decoding stops.
+ * Any commands after it can only be reached with GOTO, which decodes them as a script of their own.
+ */
+static s32 bhv_cmd_ends_script(const BehaviorScript *cmd) {
+    switch (cmd[0] >> 24) {
+        case 0x03: // BHV_CMD_RETURN
+        case 0x04: // BHV_CMD_GOTO
+        case 0x09: // BHV_CMD_END_LOOP
+        case 0x0A: // BHV_CMD_BREAK
+        case 0x0B: // BHV_CMD_BREAK_UNUSED
+        case 0x1D: // BHV_CMD_DEACTIVATE
+            return TRUE;
+        default:
+            return FALSE;
+    }
+}
+
+/**
+ * Returns the decoded instructions of the script at the virtual address script, decoding it and every script
+ * it jumps to the first time. Returns NULL if it can't be decoded.
+ */
+static const struct BhvInstr *bhv_decode_script(const BehaviorScript *script, s32 depth) {
+    u32 slot = ((uintptr_t) script >> 2) & (BHV_SCRIPT_CACHE_SIZE - 1);
+    struct BhvScriptCacheEntry *entry = NULL;
+    const BehaviorScript *cmd = script;
+    struct BhvInstr *instrs;
+    s32 i, length;
+
+    for (i = 0; i < BHV_SCRIPT_CACHE_SIZE; i++) {
+        entry = &sBhvScriptCache[slot];
+        if (entry->script == script) {
+            return entry->instrs;
+        }
+        if (entry->script == NULL) {
+            break;
+        }
+        slot = (slot + 1) & (BHV_SCRIPT_CACHE_SIZE - 1);
+    }
+
+    // Keep some room free, so lookups always end at an empty slot.
+    if (sBhvScriptCacheUsed >= BHV_SCRIPT_CACHE_SIZE - 1 || depth >= BHV_SCRIPT_MAX_DEPTH) {
+        return NULL;
+    }
+
+    // Find the length first, so the instructions can be placed together before decoding the scripts this jumps to.
+    for (length = 0; length < BHV_SCRIPT_MAX_LENGTH; length++) {
+        if ((cmd[0] >> 24) >= ARRAY_COUNT(BehaviorCmdTable)) {
+            return NULL;
+        }
+        if (bhv_cmd_ends_script(cmd)) {
+            break;
+        }
+        cmd += BehaviorCmdLengths[cmd[0] >> 24];
+    }
+    length++;
+
+    if (length > BHV_SCRIPT_MAX_LENGTH || sBhvInstrPoolUsed + length > BHV_INSTR_POOL_SIZE) {
+        return NULL;
+    }
+
+    instrs = &sBhvInstrPool[sBhvInstrPoolUsed];
+    sBhvInstrPoolUsed += length;
+
+    // Added before decoding, so scripts that jump back to this one find it.
+    entry->script = script;
+    entry->instrs = instrs;
+    sBhvScriptCacheUsed++;
+    sBhvScriptsDecoding[sNumBhvScriptsDecoding++] = entry;
+
+    cmd = script;
+    for (i = 0; i < length; i++) {
+        if (!bhv_decode_cmd(&instrs[i], cmd, depth)) {
+            return NULL;
+        }
+        cmd += BehaviorCmdLengths[cmd[0] >> 24];
+    }
+
+    return instrs;
+}
+
+/**
+ * Returns the decoded instructions for an object starting the script at the virtual address script,
+ * or &sBhvInstrInterpret if it has to be interpreted.
+ */
+static const struct BhvInstr *bhv_get_script_instrs(const BehaviorScript *script) {
+    s32 poolUsed = sBhvInstrPoolUsed;
+    const struct BhvInstr *instrs;
+
+    sNumBhvScriptsDecoding = 0;
+    instrs = bhv_decode_script(script, 0);
+
+    if (instrs == NULL) {
+        // Scripts decoded along the way may jump to the one that failed, so none of them can be used.
+        // They're kept in the cache so they aren't decoded again, and their instructions are freed.
+        for (s32 i = 0; i < sNumBhvScriptsDecoding; i++) {
+            sBhvScriptsDecoding[i]->instrs = NULL;
+        }
+        sBhvInstrPoolUsed = poolUsed;
+        return &sBhvInstrInterpret;
+    }
+
+    return instrs;
+}
+
+/**
+ * Forgets all decoded scripts. Must only be called while there are no objects.
+ */
+void clear_predecoded_behaviors(void) {
+    bzero(sBhvScriptCache, sizeof(sBhvScriptCache));
+    sBhvScriptCacheUsed = 0;
+    sBhvInstrPoolUsed = 0;
+}
+#endif
+
 // Execute the behavior script of the current object, process the object flags, and other miscellaneous code for updating objects.
 void cur_obj_update(void) {
+    PROFILER_ZONE("cur_obj_update");
+    PROFILER_BEHAVIOR(o->behavior);
     u32 objFlags = o->oFlags;
     f32 distanceFromMario;
     BhvCommandProc bhvCmdProc;
@@ -847,18 +1359,36 @@ void cur_obj_update(void) {
     }
 
     // Execute the behavior script.
-    gCurBhvCommand = o->curBhvCommand;
+#ifdef PREDECODE_BEHAVIORS
+    if (o->curBhvInstr == NULL) {
+        o->curBhvInstr = bhv_get_script_instrs(o->curBhvCommand);
+    }
+
+    if (o->curBhvInstr != &sBhvInstrInterpret) {
+        sCurBhvInstr = o->curBhvInstr;
 
-    do {
-        bhvCmdProc = BehaviorCmdTable[*gCurBhvCommand >> 24];
-        bhvProcResult = bhvCmdProc();
-    } while (bhvProcResult == BHV_PROC_CONTINUE);
+        do {
+            bhvProcResult = sCurBhvInstr->proc();
+        } while (bhvProcResult == BHV_PROC_CONTINUE);
 
-    o->curBhvCommand = gCurBhvCommand;
+        o->curBhvInstr = sCurBhvInstr;
+        o->curBhvCommand = sCurBhvInstr->cmd;
+    } else
+#endif
+    {
+        gCurBhvCommand = o->curBhvCommand;
+
+        do {
+            bhvCmdProc = BehaviorCmdTable[*gCurBhvCommand >> 24];
+            bhvProcResult = bhvCmdProc();
+        } while (bhvProcResult == BHV_PROC_CONTINUE);
+
+        o->curBhvCommand = gCurBhvCommand;
+    }
 
     // Increment the object's timer.
     if (o->oTimer < 0x3FFFFFFF) {
-        o->oTimer++;
+        o->oTimer += OBJ_UPDATE_FRAMES;
     }
 
     // If the object's action has changed, reset the action timer.
@@ -98,6 +98,12 @@ s16 gGeoLayoutStackIndex; // similar to SP register in MIPS
 s16 gGeoLayoutReturnIndex; // similar to RA register in MIPS
 u8 *gGeoLayoutCommand;
 
+#ifdef STATIC_GEO_MATRICES
+// The GEO_STATIC_NODE_START node being loaded, and its index in gCurGraphNodeList.
+static struct GraphNode *sStaticSubtreeRoot;
+static s16 sStaticSubtreeIndex;
+#endif
+
 /*
   0x00: Branch and store return address
    cmd+0x04: void *branchTarget
@@ -272,11 +278,23 @@ void geo_layout_cmd_node_perspective(void) {
 /*
   0x0B: Create a scene graph node that groups other nodes without any
   additional functionality
+   cmd+0x01: u8 isStatic (see GEO_STATIC_NODE_START)
 */
 void geo_layout_cmd_node_start(void) {
     struct GraphNodeStart *graphNode = init_graph_node_start(gGraphNodePool, NULL);
 
     register_scene_graph_node(&graphNode->node);
+#ifdef STATIC_GEO_MATRICES
+    if (cur_geo_cmd_u8(0x01) & GEO_START_FLAG_STATIC) {
+        sStaticSubtreeRoot = &graphNode->node;
+        sStaticSubtreeIndex = gCurGraphNodeIndex;
+    }
+#endif
+#ifdef ROOM_VISIBILITY
+    if (cur_geo_cmd_u8(0x01) & GEO_START_FLAG_ROOM) {
+        graphNode->room = cur_geo_cmd_s16(0x02);
+    }
+#endif
 
     gGeoLayoutCommand += 0x04 << CMD_SIZE_SHIFT;
 }
@@ -367,6 +385,70 @@ void geo_layout_cmd_node_camera(void) {
     gGeoLayoutCommand += 0x14 << CMD_SIZE_SHIFT;
 }
 
+#ifdef STATIC_GEO_MATRICES
+/**
+ * Returns the float matrix that a transform node about to be registered will be multiplied
+ * with when rendered, if it's inside a static subtree: the closest static ancestor's matrix,
+ * or identity if there isn't one. Returns NULL if the node isn't static, either because it is
+ * outside of a static subtree or because one of its ancestors moves its children every frame.
+ */
+static Mat4 *geo_layout_static_parent_matrix(void) {
+    static Mat4 identity;
+    s32 i;
+
+    if (sStaticSubtreeRoot == NULL || gCurGraphNodeIndex <= sStaticSubtreeIndex
+        || gCurGraphNodeList[sStaticSubtreeIndex] != sStaticSubtreeRoot) {
+        return NULL;
+    }
+
+    for (i = gCurGraphNodeIndex - 1; i > sStaticSubtreeIndex; i--) {
+        struct GraphNode *node = gCurGraphNodeList[i];
+        struct StaticMatrix *staticMatrix;
+
+        switch (node->type) {
+            case GRAPH_NODE_TYPE_START:
+            case GRAPH_NODE_TYPE_LEVEL_OF_DETAIL:
+            case GRAPH_NODE_TYPE_SWITCH_CASE:
+            case GRAPH_NODE_TYPE_DISPLAY_LIST:
+            case GRAPH_NODE_TYPE_GENERATED_LIST:
+            case GRAPH_NODE_TYPE_CULLING_RADIUS:
+                continue;
+            case GRAPH_NODE_TYPE_TRANSLATION_ROTATION: staticMatrix = ((struct GraphNodeTranslationRotation *) node)->staticMatrix; break;
+            case GRAPH_NODE_TYPE_TRANSLATION:          staticMatrix = ((struct GraphNodeTranslation         *) node)->staticMatrix; break;
+            case GRAPH_NODE_TYPE_ROTATION:             staticMatrix = ((struct GraphNodeRotation            *) node)->staticMatrix; break;
+            case GRAPH_NODE_TYPE_SCALE:                staticMatrix = ((struct GraphNodeScale               *) node)->staticMatrix; break;
+            default:
+                return NULL;
+        }
+
+        return ((staticMatrix != NULL) ? &staticMatrix->mtxf : NULL);
+    }
+
+    mtxf_identity(identity);
+    return &identity;
+}
+
+/**
+ * Allocates a StaticMatrix from the graph node pool and fills in its fixed point matrix
+ * from the float one, which the caller has already computed into 'mtxf'.
+ */
+static struct StaticMatrix *geo_layout_alloc_static_matrix(Mat4 mtxf) {
+    // Mtx needs to be 8 byte aligned for the RSP, but the pool only aligns to 4.
+    u8 *buf = alloc_only_pool_alloc(gGraphNodePool, sizeof(struct StaticMatrix) + 4);
+    struct StaticMatrix *staticMatrix;
+
+    if (buf == NULL) {
+        return NULL;
+    }
+
+    staticMatrix = (struct StaticMatrix *) ALIGN8((uintptr_t) buf);
+    mtxf_copy(staticMatrix->mtxf, mtxf);
+    mtxf_to_mtx(&staticMatrix->mtx, staticMatrix->mtxf);
+
+    return staticMatrix;
+}
+#endif
+
 /*
   0x10: Create translation & rotation scene graph node with optional display list
    cmd+0x01: u8 params
@@ -440,6 +522,16 @@ void geo_layout_cmd_node_translation_rotation(void) {
 
     graphNode = init_graph_node_translation_rotation(gGraphNodePool, NULL, drawingLayer, displayList,
                                                      translation, rotation);
+#ifdef STATIC_GEO_MATRICES
+    Mat4 *parentMtx = geo_layout_static_parent_matrix();
+    if (parentMtx != NULL) {
+        Mat4 mtxf;
+        Vec3f pos;
+        vec3s_to_vec3f(pos, translation);
+        mtxf_rotate_zxy_and_translate_and_mul(rotation, pos, mtxf, *parentMtx);
+        graphNode->staticMatrix = geo_layout_alloc_static_matrix(mtxf);
+    }
+#endif
     register_scene_graph_node(&graphNode->node);
 
     gGeoLayoutCommand = (u8 *) cmdPos;
@@ -475,6 +567,16 @@ void geo_layout_cmd_node_translation(void) {
 
     graphNode =
         init_graph_node_translation(gGraphNodePool, NULL, drawingLayer, displayList, translation);
+#ifdef STATIC_GEO_MATRICES
+    Mat4 *parentMtx = geo_layout_static_parent_matrix();
+    if (parentMtx != NULL) {
+        Mat4 mtxf;
+        Vec3f pos;
+        vec3s_to_vec3f(pos, translation);
+        mtxf_rotate_zxy_and_translate_and_mul(gVec3sZero, pos, mtxf, *parentMtx);
+        graphNode->staticMatrix = geo_layout_alloc_static_matrix(mtxf);
+    }
+#endif
 
     register_scene_graph_node(&graphNode->node);
 
@@ -510,6 +612,14 @@ void geo_layout_cmd_node_rotation(void) {
     }
 
     graphNode = init_graph_node_rotation(gGraphNodePool, NULL, drawingLayer, displayList, angle);
+#ifdef STATIC_GEO_MATRICES
+    Mat4 *parentMtx = geo_layout_static_parent_matrix();
+    if (parentMtx != NULL) {
+        Mat4 mtxf;
+        mtxf_rotate_zxy_and_translate_and_mul(angle, gVec3fZero, mtxf, *parentMtx);
+        graphNode->staticMatrix = geo_layout_alloc_static_matrix(mtxf);
+    }
+#endif
 
     register_scene_graph_node(&graphNode->node);
 
@@ -539,6 +649,16 @@ void geo_layout_cmd_node_scale(void) {
     }
 
     graphNode = init_graph_node_scale(gGraphNodePool, NULL, drawingLayer, displayList, scale);
+#ifdef STATIC_GEO_MATRICES
+    Mat4 *parentMtx = geo_layout_static_parent_matrix();
+    if (parentMtx != NULL) {
+        Mat4 mtxf;
+        Vec3f scaleVec;
+        vec3f_set(scaleVec, scale, scale, scale);
+        mtxf_scale_vec3f(mtxf, *parentMtx, scaleVec);
+        graphNode->staticMatrix = geo_layout_alloc_static_matrix(mtxf);
+    }
+#endif
 
     register_scene_graph_node(&graphNode->node);
 
@@ -608,6 +728,136 @@ void geo_layout_cmd_node_billboard(void) {
     gGeoLayoutCommand = (u8 *) cmdPos;
 }
 
+#ifdef LEVEL_GEOMETRY_CULLING
+// How deep to follow nested display lists, and how many commands to read in total, before giving up.
+#define DL_BOUNDS_MAX_DEPTH     10
+#define DL_BOUNDS_MAX_COMMANDS  0x4000
+
+struct DisplayListBounds {
+    Vec3s min;
+    Vec3s max;
+    s32 numVertices;
+    s32 commandsLeft;
+};
+
+/**
+ * Resolves an address found in a display list, or returns NULL if its segment isn't loaded.
+ */
+static void *geo_layout_resolve_gfx_address(uintptr_t addr) {
+#ifndef NO_SEGMENTED_MEMORY
+    u32 segment = (addr >> 24);
+
+    if (segment < 32) {
+        if (segment != 0 && get_segment_base_addr(segment) == (void *) 0x80000000) {
+            return NULL;
+        }
+        return segmented_to_virtual((void *) addr);
+    }
+#endif
+    return (void *) addr;
+}
+
+/**
+ * Accumulates the bounding box of every vertex loaded by a display list and the lists it calls.
+ * Returns FALSE if the bounds can't be trusted, e.g. if the list loads a matrix or reads from
+ * a segment that isn't set yet.
+ */
+static s32 geo_layout_scan_display_list(Gfx *dl, struct DisplayListBounds *bounds, s32 depth) {
+    while (--bounds->commandsLeft >= 0) {
+        u32 w0 = dl->words.w0;
+        uintptr_t w1 = dl->words.w1;
+
+        switch (_SHIFTR(w0, 24, 8)) {
+            case (u8) G_VTX: {
+#if defined(F3DEX_GBI_2)
+                s32 numVertices = _SHIFTR(w0, 12, 8);
+#elif defined(F3DEX_GBI) || defined(F3DLP_GBI)
+                s32 numVertices = _SHIFTR(w0, 10, 6);
+#else
+                s32 numVertices = (_SHIFTR(w0, 0, 16) / sizeof(Vtx));
+#endif
+                Vtx *vtx = geo_layout_resolve_gfx_address(w1);
+                if (vtx == NULL) {
+                    return FALSE;
+                }
+                for (; numVertices > 0; numVertices--, vtx++) {
+                    for (s32 i = 0; i < 3; i++) {
+                        bounds->min[i] = MIN(bounds->min[i], vtx->v.ob[i]);
+                        bounds->max[i] = MAX(bounds->max[i], vtx->v.ob[i]);
+                    }
+                    bounds->numVertices++;
+                }
+                break;
+            }
+            case (u8) G_DL: {
+                Gfx *target = geo_layout_resolve_gfx_address(w1);
+                if (target == NULL) {
+                    return FALSE;
+                }
+                if (_SHIFTR(w0, 16, 8) == G_DL_NOPUSH) {
+                    dl = target;
+                    continue;
+                }
+                if (depth >= DL_BOUNDS_MAX_DEPTH || !geo_layout_scan_display_list(target, bounds, (depth + 1))) {
+                    return FALSE;
+                }
+                break;
+            }
+            case (u8) G_ENDDL:
+                return TRUE;
+            case (u8) G_MTX:
+#ifdef G_BRANCH_Z
+            case (u8) G_BRANCH_Z:
+#endif
+                return FALSE;
+        }
+        dl++;
+    }
+
+    return FALSE;
+}
+
+/**
+ * Computes the bounding sphere of a display list node that belongs to an area's geometry,
+ * i.e. that has a camera node above it. Actor models are culled by their object instead.
+ */
+static void geo_layout_compute_display_list_bounds(struct GraphNodeDisplayList *graphNode) {
+    struct DisplayListBounds bounds;
+    s32 i;
+
+    for (i = gCurGraphNodeIndex - 1; i >= 0; i--) {
+        if (gCurGraphNodeList[i]->type == GRAPH_NODE_TYPE_CAMERA) {
+            break;
+        }
+    }
+    if (i < 0 || graphNode->displayList == NULL) {
+        return;
+    }
+
+    vec3_same(bounds.min, 0x7FFF);
+    vec3_same(bounds.max, -0x8000);
+    bounds.numVertices = 0;
+    bounds.commandsLeft = DL_BOUNDS_MAX_COMMANDS;
+
+    Gfx *dl = geo_layout_resolve_gfx_address((uintptr_t) graphNode->displayList);
+    if (dl == NULL || !geo_layout_scan_display_list(dl, &bounds, 0) || bounds.numVertices == 0) {
+        return;
+    }
+
+    Vec3f extents;
+    for (i = 0; i < 3; i++) {
+        graphNode->cullingCenter[i] = ((bounds.min[i] + bounds.max[i]) / 2);
+        extents[i] = (bounds.max[i] - bounds.min[i]);
+    }
+    // Round up, and never store 0 since that means "don't cull". Spheres too large for an s16 are left at 0,
+    // since a smaller sphere would cull geometry that is still on screen.
+    f32 radius = ((vec3_mag(extents) / 2.0f) + 2.0f);
+    if (radius < 0x7FFF) {
+        graphNode->cullingRadius = radius;
+    }
+}
+#endif
+
 /*
   0x15: Create plain display list scene graph node
    cmd+0x01: u8 drawingLayer
@@ -619,6 +869,9 @@ void geo_layout_cmd_node_display_list(void) {
     void *displayList = cur_geo_cmd_ptr(0x04);
 
     graphNode = init_graph_node_display_list(gGraphNodePool, NULL, drawingLayer, displayList);
+#ifdef LEVEL_GEOMETRY_CULLING
+    geo_layout_compute_display_list_bounds(graphNode);
+#endif
 
     register_scene_graph_node(&graphNode->node);
 
@@ -771,6 +1024,10 @@ struct GraphNode *process_geo_layout(struct AllocOnlyPool *pool, void *segptr) {
     gGeoLayoutStack[0] = 0;
     gGeoLayoutStack[1] = 0;
 
+#ifdef STATIC_GEO_MATRICES
+    sStaticSubtreeRoot = NULL;
+#endif
+
     while (gGeoLayoutCommand != NULL) {
         assert((gGeoLayoutCommand[0x00] < GEO_CMD_COUNT), "Invalid or unloaded geo layout detected.");
         GeoLayoutJumpTable[gGeoLayoutCommand[0x00]]();
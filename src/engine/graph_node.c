@@ -103,6 +103,9 @@ struct GraphNodeStart *init_graph_node_start(struct AllocOnlyPool *pool,
 
     if (graphNode != NULL) {
         init_scene_graph_node_links(&graphNode->node, GRAPH_NODE_TYPE_START);
+#ifdef ROOM_VISIBILITY
+        graphNode->room = 0;
+#endif
     }
 
     return graphNode;
@@ -218,6 +221,9 @@ init_graph_node_translation_rotation(struct AllocOnlyPool *pool,
         vec3s_copy(graphNode->rotation, rotation);
         SET_GRAPH_NODE_LAYER(graphNode->node.flags, drawingLayer);
         graphNode->displayList = displayList;
+#ifdef STATIC_GEO_MATRICES
+        graphNode->staticMatrix = NULL;
+#endif
     }
 
     return graphNode;
@@ -240,6 +246,9 @@ struct GraphNodeTranslation *init_graph_node_translation(struct AllocOnlyPool *p
         vec3s_copy(graphNode->translation, translation);
         SET_GRAPH_NODE_LAYER(graphNode->node.flags, drawingLayer);
         graphNode->displayList = displayList;
+#ifdef STATIC_GEO_MATRICES
+        graphNode->staticMatrix = NULL;
+#endif
     }
 
     return graphNode;
@@ -261,6 +270,9 @@ struct GraphNodeRotation *init_graph_node_rotation(struct AllocOnlyPool *pool,
         vec3s_copy(graphNode->rotation, rotation);
         SET_GRAPH_NODE_LAYER(graphNode->node.flags, drawingLayer);
         graphNode->displayList = displayList;
+#ifdef STATIC_GEO_MATRICES
+        graphNode->staticMatrix = NULL;
+#endif
     }
 
     return graphNode;
@@ -281,6 +293,9 @@ struct GraphNodeScale *init_graph_node_scale(struct AllocOnlyPool *pool,
         SET_GRAPH_NODE_LAYER(graphNode->node.flags, drawingLayer);
         graphNode->scale = scale;
         graphNode->displayList = displayList;
+#ifdef STATIC_GEO_MATRICES
+        graphNode->staticMatrix = NULL;
+#endif
     }
 
     return graphNode;
@@ -390,6 +405,9 @@ struct GraphNodeDisplayList *init_graph_node_display_list(struct AllocOnlyPool *
         init_scene_graph_node_links(&graphNode->node, GRAPH_NODE_TYPE_DISPLAY_LIST);
         SET_GRAPH_NODE_LAYER(graphNode->node.flags, drawingLayer);
         graphNode->displayList = displayList;
+#ifdef LEVEL_GEOMETRY_CULLING
+        graphNode->cullingRadius = 0;
+#endif
     }
 
     return graphNode;
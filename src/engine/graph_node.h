@@ -156,6 +156,9 @@ struct GraphNodeMasterList {
  */
 struct GraphNodeStart {
     /*0x00*/ struct GraphNode node;
+#ifdef ROOM_VISIBILITY
+    /*0x14*/ s16 room; // Children are only drawn while this room is visible from Mario's room, 0 for always
+#endif
 };
 
 /** GraphNode that only renders its children if the current transformation matrix
@@ -203,6 +206,17 @@ struct GraphNodeCamera {
     /*0x3A*/ s16 rollScreen; // rolls screen while keeping the light direction consistent
 };
 
+#ifdef STATIC_GEO_MATRICES
+/** The matrix of a transform node inside a GEO_STATIC_NODE_START subtree.
+ *  Built once at geo layout load, relative to the camera node, and pushed
+ *  as is when rendering instead of recomputing both matrices every frame.
+ */
+struct StaticMatrix {
+    /*0x00*/ Mtx mtx;
+    /*0x40*/ Mat4 mtxf;
+};
+#endif
+
 /** GraphNode that translates and rotates its children.
  *  Usage example: wing cap wings.
  *  There is a dprint function that sets the translation and rotation values
@@ -214,6 +228,9 @@ struct GraphNodeTranslationRotation {
     /*0x14*/ void *displayList;
     /*0x18*/ Vec3s translation;
     /*0x1E*/ Vec3s rotation;
+#ifdef STATIC_GEO_MATRICES
+    /*0x24*/ struct StaticMatrix *staticMatrix;
+#endif
 };
 
 /** GraphNode that translates itself and its children.
@@ -225,6 +242,9 @@ struct GraphNodeTranslation {
     /*0x14*/ void *displayList;
     /*0x18*/ Vec3s translation;
     // u8 filler[2];
+#ifdef STATIC_GEO_MATRICES
+    /*0x20*/ struct StaticMatrix *staticMatrix;
+#endif
 };
 
 /** GraphNode that rotates itself and its children.
@@ -237,6 +257,9 @@ struct GraphNodeRotation {
     /*0x14*/ void *displayList;
     /*0x18*/ Vec3s rotation;
     // u8 filler[2];
+#ifdef STATIC_GEO_MATRICES
+    /*0x20*/ struct StaticMatrix *staticMatrix;
+#endif
 };
 
 /** GraphNode part that transforms itself and its children based on animation
@@ -269,6 +292,10 @@ struct GraphNodeBillboard {
 struct GraphNodeDisplayList {
     /*0x00*/ struct GraphNode node;
     /*0x14*/ void *displayList;
+#ifdef LEVEL_GEOMETRY_CULLING
+    /*0x18*/ Vec3s cullingCenter;
+    /*0x1E*/ s16 cullingRadius; // 0 if the display list is never culled
+#endif
 };
 
 /** GraphNode part that scales itself and its children.
@@ -283,6 +310,9 @@ struct GraphNodeScale {
     /*0x00*/ struct GraphNode node;
     /*0x14*/ void *displayList;
     /*0x18*/ f32 scale;
+#ifdef STATIC_GEO_MATRICES
+    /*0x1C*/ struct StaticMatrix *staticMatrix;
+#endif
 };
 
 /** GraphNode that draws a shadow under an object.
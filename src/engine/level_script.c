@@ -657,6 +657,21 @@ static void level_cmd_set_terrain_data(void) {
     sCurrentCmd = CMD_NEXT;
 }
 
+static void level_cmd_set_baked_terrain_data(void) {
+    if (sCurrAreaIndex != -1) {
+        // Baked images are only in ROM, see load_baked_static_surfaces.
+        gAreas[sCurrAreaIndex].bakedTerrain = CMD_GET(void *, 4);
+    }
+    sCurrentCmd = CMD_NEXT;
+}
+
+static void level_cmd_set_room_visibility(void) {
+    if (sCurrAreaIndex != -1) {
+        gAreas[sCurrAreaIndex].roomVisibility = segmented_to_virtual(CMD_GET(void *, 4));
+    }
+    sCurrentCmd = CMD_NEXT;
+}
+
 static void level_cmd_set_rooms(void) {
     if (sCurrAreaIndex != -1) {
         gAreas[sCurrAreaIndex].surfaceRooms = segmented_to_virtual(CMD_GET(void *, 4));
@@ -938,6 +953,8 @@ static void (*LevelScriptJumpTable[])(void) = {
     /*LEVEL_CMD_PUPPYVOLUME                 */ level_cmd_puppyvolume,
     /*LEVEL_CMD_CHANGE_AREA_SKYBOX          */ level_cmd_change_area_skybox,
     /*LEVEL_CMD_SET_ECHO                    */ level_cmd_set_echo,
+    /*LEVEL_CMD_SET_BAKED_TERRAIN_DATA      */ level_cmd_set_baked_terrain_data,
+    /*LEVEL_CMD_SET_ROOM_VISIBILITY         */ level_cmd_set_room_visibility,
 };
 
 struct LevelCommand *level_script_execute(struct LevelCommand *cmd) {
@@ -27,6 +27,11 @@ Vec3s gVec3sOne  = {     1,     1,     1 };
 
 static u16 gRandomSeed16;
 
+// Restart the random number sequence from the given seed.
+void random_set_seed(u16 seed) {
+    gRandomSeed16 = seed;
+}
+
 // Generate a pseudorandom integer from 0 to 65535 from the random seed, and update the seed.
 u16 random_u16(void) {
     if (gRandomSeed16 == 22026) {
@@ -232,6 +237,40 @@ void mtxf_rotate_xyz_and_translate_and_mul(Vec3s rot, Vec3f trans, Mat4 dest, Ma
     MTXF_END(dest);
 }
 
+/// Compute the three rotation rows that mtxf_rotate_xyz_and_translate_and_mul builds internally, so they can be cached.
+void mtxf_rotate_xyz_rows(Vec3f rows[3], Vec3s rot) {
+    f32 sx = sins(rot[0]);
+    f32 cx = coss(rot[0]);
+    f32 sy = sins(rot[1]);
+    f32 cy = coss(rot[1]);
+    f32 sz = sins(rot[2]);
+    f32 cz = coss(rot[2]);
+    rows[0][0] = (cy * cz);
+    rows[0][1] = (cy * sz);
+    rows[0][2] = -sy;
+    f32 sxcz = (sx * cz);
+    f32 cxsz = (cx * sz);
+    rows[1][0] = ((sxcz * sy) - cxsz);
+    f32 sxsz = (sx * sz);
+    f32 cxcz = (cx * cz);
+    rows[1][1] = ((sxsz * sy) + cxcz);
+    rows[1][2] = (sx * cy);
+    rows[2][0] = ((cxcz * sy) + sxsz);
+    rows[2][1] = ((cxsz * sy) - sxcz);
+    rows[2][2] = (cx * cy);
+}
+
+/// Same as mtxf_rotate_xyz_and_translate_and_mul, but with the rotation rows already computed by mtxf_rotate_xyz_rows.
+void mtxf_rows_translate_and_mul(Vec3f rows[3], Vec3f trans, Mat4 dest, Mat4 src) {
+    PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.matrix);
+    linear_mtxf_mul_vec3f(src, dest[0], rows[0]);
+    linear_mtxf_mul_vec3f(src, dest[1], rows[1]);
+    linear_mtxf_mul_vec3f(src, dest[2], rows[2]);
+    linear_mtxf_mul_vec3f(src, dest[3], trans);
+    vec3f_add(dest[3], src[3]);
+    MTXF_END(dest);
+}
+
 /**
  * Set mtx to a look-at matrix for the camera. The resulting transformation
  * transforms the world as if there exists a camera at position 'from' pointed
@@ -903,6 +942,7 @@ void find_surface_on_ray_list(struct SurfaceNode *list, Vec3f orig, Vec3f dir, f
 
     // Iterate through every surface of the list
     for (; list != NULL; list = list->next) {
+        PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.collision_surfaces_visited);
         // Reject surface if out of vertical bounds
         if ((list->surface->lowerY > top) || (list->surface->upperY < bottom)) continue;
         // Check intersection between the ray and this surface
@@ -919,21 +959,28 @@ void find_surface_on_ray_list(struct SurfaceNode *list, Vec3f orig, Vec3f dir, f
 void find_surface_on_ray_cell(s32 cellX, s32 cellZ, Vec3f orig, Vec3f normalized_dir, f32 dir_length, struct Surface **hit_surface, Vec3f hit_pos, f32 *max_length, s32 flags) {
     // Skip if OOB
     if ((cellX >= 0) && (cellX <= (NUM_CELLS - 1)) && (cellZ >= 0) && (cellZ <= (NUM_CELLS - 1))) {
+        // The lateral bounds of the ray, used to pick a smaller list if the static cell is subdivided.
+        f32 endX = orig[0] + (normalized_dir[0] * dir_length);
+        f32 endZ = orig[2] + (normalized_dir[2] * dir_length);
+        s32 minX = (s32) MIN(orig[0], endX) - 1;
+        s32 minZ = (s32) MIN(orig[2], endZ) - 1;
+        s32 maxX = (s32) MAX(orig[0], endX) + 1;
+        s32 maxZ = (s32) MAX(orig[2], endZ) + 1;
         // Iterate through each surface in this partition
         if ((normalized_dir[1] > -NEAR_ONE) && (flags & RAYCAST_FIND_CEIL)) {
-            find_surface_on_ray_list( gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_CEILS ].next, orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
+            find_surface_on_ray_list(get_static_surface_list(cellX, cellZ, minX, minZ, maxX, maxZ, SPATIAL_PARTITION_CEILS), orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
             find_surface_on_ray_list(gDynamicSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_CEILS ].next, orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
         }
         if ((normalized_dir[1] <  NEAR_ONE) && (flags & RAYCAST_FIND_FLOOR)) {
-            find_surface_on_ray_list( gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_FLOORS].next, orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
+            find_surface_on_ray_list(get_static_surface_list(cellX, cellZ, minX, minZ, maxX, maxZ, SPATIAL_PARTITION_FLOORS), orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
             find_surface_on_ray_list(gDynamicSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_FLOORS].next, orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
         }
         if (flags & RAYCAST_FIND_WALL) {
-            find_surface_on_ray_list( gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_WALLS ].next, orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
+            find_surface_on_ray_list(get_static_surface_list(cellX, cellZ, minX, minZ, maxX, maxZ, SPATIAL_PARTITION_WALLS), orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
             find_surface_on_ray_list(gDynamicSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_WALLS ].next, orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
         }
         if (flags & RAYCAST_FIND_WATER) {
-            find_surface_on_ray_list( gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_WATER ].next, orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
+            find_surface_on_ray_list(get_static_surface_list(cellX, cellZ, minX, minZ, maxX, maxZ, SPATIAL_PARTITION_WATER), orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
             find_surface_on_ray_list(gDynamicSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_WATER ].next, orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
         }
     }
@@ -963,6 +1010,9 @@ f32 find_surface_on_ray(Vec3f orig, Vec3f dir, struct Surface **hit_surface, Vec
     // Don't do grid traversal if straight down
     if ((normalized_dir[1] >= NEAR_ONE) || (normalized_dir[1] <= -NEAR_ONE)) {
         find_surface_on_ray_cell((s32)start_cell_coord_x, (s32)start_cell_coord_z, orig, normalized_dir, dir_length, hit_surface, hit_pos, &max_length, flags);
+#ifdef LOCAL_SPACE_OBJECT_COLLISION
+        find_local_surface_on_ray(orig, normalized_dir, dir_length, hit_surface, hit_pos, &max_length, flags);
+#endif
         return max_length;
     }
 
@@ -997,6 +1047,9 @@ f32 find_surface_on_ray(Vec3f orig, Vec3f dir, struct Surface **hit_surface, Vec
             p_z += stp_z;
         }
     }
+#ifdef LOCAL_SPACE_OBJECT_COLLISION
+    find_local_surface_on_ray(orig, normalized_dir, dir_length, hit_surface, hit_pos, &max_length, flags);
+#endif
     return max_length;
 }
 
@@ -623,6 +623,7 @@ ALWAYS_INLINE s32 roundf(f32 in) {
     ((u32 *)(mtx))[15] = FLOAT_ONE;             \
 }
 
+void random_set_seed(u16 seed);
 u16 random_u16(void);
 f32 random_float(void);
 s32 random_sign(void);
@@ -635,6 +636,8 @@ void mtxf_rotate_zxy_and_translate(Mat4 dest, Vec3f trans, Vec3s rot);
 void mtxf_rotate_xyz_and_translate(Mat4 dest, Vec3f trans, Vec3s rot);
 void mtxf_rotate_zxy_and_translate_and_mul(Vec3s rot, Vec3f trans, Mat4 dest, Mat4 src);
 void mtxf_rotate_xyz_and_translate_and_mul(Vec3s rot, Vec3f trans, Mat4 dest, Mat4 src);
+void mtxf_rotate_xyz_rows(Vec3f rows[3], Vec3s rot);
+void mtxf_rows_translate_and_mul(Vec3f rows[3], Vec3f trans, Mat4 dest, Mat4 src);
 void mtxf_billboard(Mat4 dest, Mat4 mtx, Vec3f position, Vec3f scale, s16 angle);
 void mtxf_shadow(Mat4 dest, Vec3f upDir, Vec3f pos, Vec3f scale, s16 yaw);
 void mtxf_align_terrain_normal(Mat4 dest, Vec3f upDir, Vec3f pos, s16 yaw);
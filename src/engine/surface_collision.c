@@ -10,6 +10,31 @@
 #include "surface_load.h"
 #include "game/puppyprint.h"
 
+#ifdef LOCAL_SPACE_OBJECT_COLLISION
+/**
+ * Moves a world space point into the space of a local collision object.
+ */
+static void to_local_space(struct LocalCollisionObject *entry, Vec3f dst, Vec3f src) {
+    Vec3f diff;
+    vec3_diff(diff, src, entry->transform[3]);
+    linear_mtxf_transpose_mul_vec3(entry->transform, dst, diff);
+}
+
+/**
+ * Moves a point in the space of a local collision object back into world space.
+ */
+static void to_world_space(struct LocalCollisionObject *entry, Vec3f dst, Vec3f src) {
+    linear_mtxf_mul_vec3_and_translate(entry->transform, dst, src);
+}
+
+/**
+ * Checks whether a local space point is laterally within range of any of the object's surfaces.
+ */
+static s32 is_in_local_collision_range(struct LocalCollisionObject *entry, Vec3f pos, f32 range) {
+    return ((sqr(pos[0]) + sqr(pos[2])) <= sqr(entry->model->radius + range));
+}
+#endif
+
 /**************************************************
  *                      WALLS                     *
  **************************************************/
@@ -70,6 +95,7 @@ static s32 find_wall_collisions_from_list(struct SurfaceNode *surfaceNode, struc
         surf        = surfaceNode->surface;
         surfaceNode = surfaceNode->next;
         type        = surf->type;
+        PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.collision_surfaces_visited);
 
         // Exclude a large number of walls immediately to optimize.
         if (pos[1] < surf->lowerY || pos[1] > surf->upperY) continue;
@@ -168,6 +194,58 @@ static s32 find_wall_collisions_from_list(struct SurfaceNode *surfaceNode, struc
     return numCols;
 }
 
+#ifdef LOCAL_SPACE_OBJECT_COLLISION
+/**
+ * Finds wall collisions against the objects that are queried in their own space,
+ * pushing the position and appending world space copies of the walls.
+ */
+static s32 find_local_wall_collisions(struct WallCollisionData *colData) {
+    struct WallCollisionData localData;
+    s32 numCollisions = 0;
+    s32 i, j;
+    Vec3f pos;
+
+    for (i = 0; i < gNumLocalCollisionObjects; i++) {
+        struct LocalCollisionObject *entry = &gLocalCollisionObjects[i];
+
+        vec3_set(pos, colData->x, colData->y, colData->z);
+        to_local_space(entry, pos, pos);
+
+        f32 y = (pos[1] + colData->offsetY);
+        if (!is_in_local_collision_range(entry, pos, colData->radius)
+            || y < entry->model->lowerY || y > entry->model->upperY) {
+            continue;
+        }
+
+        localData = *colData;
+        localData.x = pos[0];
+        localData.y = pos[1];
+        localData.z = pos[2];
+
+        s32 numCols = find_wall_collisions_from_list(entry->model->lists[SPATIAL_PARTITION_WALLS].next, &localData);
+        if (numCols == 0) {
+            continue;
+        }
+        numCollisions += numCols;
+
+        pos[0] = localData.x;
+        pos[2] = localData.z;
+        to_world_space(entry, pos, pos);
+        colData->x = pos[0];
+        colData->z = pos[2];
+
+        for (j = colData->numWalls; j < localData.numWalls; j++) {
+            struct Surface *wall = get_local_surface_copy(entry, localData.walls[j]);
+            if (wall != NULL) {
+                colData->walls[colData->numWalls++] = wall;
+            }
+        }
+    }
+
+    return numCollisions;
+}
+#endif
+
 /**
  * Formats the position and wall search for find_wall_collisions.
  */
@@ -196,6 +274,7 @@ s32 f32_find_wall_collision(f32 *xPtr, f32 *yPtr, f32 *zPtr, f32 offsetY, f32 ra
  * Find wall collisions and receive their push.
  */
 s32 find_wall_collisions(struct WallCollisionData *colData) {
+    PROFILER_ZONE("find_wall_collisions");
     struct SurfaceNode *node;
     s32 numCollisions = 0;
     s32 x = colData->x;
@@ -210,6 +289,12 @@ s32 find_wall_collisions(struct WallCollisionData *colData) {
         return numCollisions;
     }
 
+#ifdef LOCAL_SPACE_OBJECT_COLLISION
+    if (!(gCollisionFlags & COLLISION_FLAG_EXCLUDE_DYNAMIC)) {
+        numCollisions += find_local_wall_collisions(colData);
+    }
+
+#endif
     // World (level) consists of a 16x16 grid. Find where the collision is on the grid (round toward -inf)
     s32 minCellX = GET_CELL_COORD(x - colData->radius);
     s32 minCellZ = GET_CELL_COORD(z - colData->radius);
@@ -225,7 +310,7 @@ s32 find_wall_collisions(struct WallCollisionData *colData) {
             }
 
             // Check for surfaces that are a part of level geometry.
-            node = gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_WALLS].next;
+            node = get_static_surface_list_at_height(cellX, cellZ, (x - colData->radius), (z - colData->radius), (x + colData->radius), (z + colData->radius), SPATIAL_PARTITION_WALLS, (colData->y + colData->offsetY));
             numCollisions += find_wall_collisions_from_list(node, colData);
         }
     }
@@ -308,6 +393,7 @@ static struct Surface *find_ceil_from_list(struct SurfaceNode *surfaceNode, s32
         surf = surfaceNode->surface;
         surfaceNode = surfaceNode->next;
         type = surf->type;
+        PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.collision_surfaces_visited);
 
         // Exclude all ceilings below the point
         if (y > surf->upperY) continue;
@@ -346,10 +432,40 @@ static struct Surface *find_ceil_from_list(struct SurfaceNode *surfaceNode, s32
     return ceil;
 }
 
+#ifdef LOCAL_SPACE_OBJECT_COLLISION
+/**
+ * Finds a ceiling of the objects that are queried in their own space that is lower than *pheight,
+ * updating *pheight and *pceil with a world space copy of it.
+ */
+static void find_local_ceil(s32 x, s32 y, s32 z, struct Surface **pceil, f32 *pheight) {
+    struct Surface *ceil;
+    f32 height;
+    Vec3f pos;
+    s32 i;
+
+    for (i = 0; i < gNumLocalCollisionObjects; i++) {
+        struct LocalCollisionObject *entry = &gLocalCollisionObjects[i];
+
+        vec3_set(pos, x, y, z);
+        to_local_space(entry, pos, pos);
+        if (!is_in_local_collision_range(entry, pos, 0.0f) || pos[1] > entry->model->upperY) {
+            continue;
+        }
+
+        ceil = find_ceil_from_list(entry->model->lists[SPATIAL_PARTITION_CEILS].next, pos[0], pos[1], pos[2], &height);
+        if (ceil != NULL && (height += entry->transform[3][1]) < *pheight && (ceil = get_local_surface_copy(entry, ceil)) != NULL) {
+            *pheight = height;
+            *pceil = ceil;
+        }
+    }
+}
+#endif
+
 /**
  * Find the lowest ceiling above a given position and return the height.
  */
 f32 find_ceil(f32 posX, f32 posY, f32 posZ, struct Surface **pceil) {
+    PROFILER_ZONE("find_ceil");
     f32 height        = CELL_HEIGHT_LIMIT;
     f32 dynamicHeight = CELL_HEIGHT_LIMIT;
     PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.collision_ceil);
@@ -378,13 +494,16 @@ f32 find_ceil(f32 posX, f32 posY, f32 posZ, struct Surface **pceil) {
         // Check for surfaces belonging to objects.
         surfaceList = gDynamicSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_CEILS].next;
         dynamicCeil = find_ceil_from_list(surfaceList, x, y, z, &dynamicHeight);
+#ifdef LOCAL_SPACE_OBJECT_COLLISION
+        find_local_ceil(x, y, z, &dynamicCeil, &dynamicHeight);
+#endif
 
         // In the next check, only check for ceilings lower than the previous check.
         height = dynamicHeight;
     }
 
     // Check for surfaces that are a part of level geometry.
-    surfaceList = gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_CEILS].next;
+    surfaceList = get_static_surface_list_at_height(cellX, cellZ, x, z, x, z, SPATIAL_PARTITION_CEILS, y);
     ceil = find_ceil_from_list(surfaceList, x, y, z, &height);
 
     // Use the lower ceiling.
@@ -429,50 +548,64 @@ static s32 check_within_floor_triangle_bounds(s32 x, s32 z, struct Surface *surf
 }
 
 /**
- * Iterate through the list of floors and find the first floor under a given point.
+ * Checks whether a floor can be stood on from a given point, and returns its height there.
+ * bufferY is the point's height plus FIND_FLOOR_BUFFER.
+ */
+ALWAYS_INLINE static s32 check_floor_under_point(struct Surface *surf, s32 x, s32 bufferY, s32 z, f32 *pheight) {
+    register SurfaceType type = surf->type;
+
+    // To prevent the Merry-Go-Round room from loading when Mario passes above the hole that leads
+    // there, SURFACE_INTANGIBLE is used. This prevent the wrong room from loading, but can also allow
+    // Mario to pass through.
+    if (!(gCollisionFlags & COLLISION_FLAG_INCLUDE_INTANGIBLE) && (type == SURFACE_INTANGIBLE)) {
+        return FALSE;
+    }
+
+    // Determine if we are checking for the camera or not.
+    if (gCollisionFlags & COLLISION_FLAG_CAMERA) {
+        if (surf->flags & SURFACE_FLAG_NO_CAM_COLLISION) {
+            return FALSE;
+        }
+    } else if (type == SURFACE_CAMERA_BOUNDARY) {
+        return FALSE; // If we are not checking for the camera, ignore camera only floors.
+    }
+
+    // Exclude all floors above the point.
+    if (bufferY < surf->lowerY) return FALSE;
+    // Check that the point is within the triangle bounds.
+    if (!check_within_floor_triangle_bounds(x, z, surf)) return FALSE;
+
+    // Get the height of the floor under the current location.
+    *pheight = get_surface_height_at_location(x, z, surf);
+
+    // Checks for floor interaction with a FIND_FLOOR_BUFFER unit buffer.
+    return (bufferY >= *pheight);
+}
+
+/**
+ * Iterate through the list of floors and find the first floor under a given point
+ * that is higher than *pheight.
  */
 static struct Surface *find_floor_from_list(struct SurfaceNode *surfaceNode, s32 x, s32 y, s32 z, f32 *pheight) {
     register struct Surface *surf, *floor = NULL;
-    register SurfaceType type = SURFACE_DEFAULT;
-    register f32 height;
     register s32 bufferY = y + FIND_FLOOR_BUFFER;
+    f32 height;
 
     // Iterate through the list of floors until there are no more floors.
     while (surfaceNode != NULL) {
         surf = surfaceNode->surface;
         surfaceNode = surfaceNode->next;
-        type        = surf->type;
-
-        // To prevent the Merry-Go-Round room from loading when Mario passes above the hole that leads
-        // there, SURFACE_INTANGIBLE is used. This prevent the wrong room from loading, but can also allow
-        // Mario to pass through.
-        if (!(gCollisionFlags & COLLISION_FLAG_INCLUDE_INTANGIBLE) && (type == SURFACE_INTANGIBLE)) {
-            continue;
-        }
+        PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.collision_surfaces_visited);
 
-        // Determine if we are checking for the camera or not.
-        if (gCollisionFlags & COLLISION_FLAG_CAMERA) {
-            if (surf->flags & SURFACE_FLAG_NO_CAM_COLLISION) {
-                continue;
-            }
-        } else if (type == SURFACE_CAMERA_BOUNDARY) {
-            continue; // If we are not checking for the camera, ignore camera only floors.
-        }
+        // The list is sorted from the highest upperY down, so none of the remaining floors
+        // can be higher than the previous highest floor.
+        if (surf->upperY < *pheight) break;
 
-        // Exclude all floors above the point.
-        if (bufferY < surf->lowerY) continue;
-        // Check that the point is within the triangle bounds.
-        if (!check_within_floor_triangle_bounds(x, z, surf)) continue;
-
-        // Get the height of the floor under the current location.
-        height = get_surface_height_at_location(x, z, surf);
+        if (!check_floor_under_point(surf, x, bufferY, z, &height)) continue;
 
         // Exclude floors lower than the previous highest floor.
         if (height <= *pheight) continue;
 
-        // Checks for floor interaction with a FIND_FLOOR_BUFFER unit buffer.
-        if (bufferY < height) continue;
-
         // Use the current floor
         *pheight = height;
         floor = surf;
@@ -509,6 +642,7 @@ struct Surface *find_water_floor_from_list(struct SurfaceNode *surfaceNode, s32
     while (bottomSurfaceNode != NULL) {
         surf = bottomSurfaceNode->surface;
         bottomSurfaceNode = bottomSurfaceNode->next;
+        PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.collision_surfaces_visited);
 
         // skip wall angled water
         if (surf->type != SURFACE_NEW_WATER_BOTTOM || absf(surf->normal.y) < NORMAL_FLOOR_THRESHOLD) continue;
@@ -529,6 +663,7 @@ struct Surface *find_water_floor_from_list(struct SurfaceNode *surfaceNode, s32
     while (topSurfaceNode != NULL) {
         surf = topSurfaceNode->surface;
         topSurfaceNode = topSurfaceNode->next;
+        PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.collision_surfaces_visited);
 
         // skip water tops or wall angled water bottoms
         if (surf->type == SURFACE_NEW_WATER_BOTTOM || absf(surf->normal.y) < NORMAL_FLOOR_THRESHOLD) continue;
@@ -580,15 +715,98 @@ f32 unused_find_dynamic_floor(f32 xPos, f32 yPos, f32 zPos, struct Surface **pfl
     return floorHeight;
 }
 
+#ifdef LOCAL_SPACE_OBJECT_COLLISION
+/**
+ * Finds a floor of the objects that are queried in their own space that is higher than *pheight,
+ * updating *pheight and *pfloor with a world space copy of it.
+ */
+static void find_local_floor(s32 x, s32 y, s32 z, struct Surface **pfloor, f32 *pheight) {
+    struct Surface *floor;
+    f32 height;
+    Vec3f pos;
+    s32 i;
+
+    for (i = 0; i < gNumLocalCollisionObjects; i++) {
+        struct LocalCollisionObject *entry = &gLocalCollisionObjects[i];
+
+        vec3_set(pos, x, y, z);
+        to_local_space(entry, pos, pos);
+        if (!is_in_local_collision_range(entry, pos, 0.0f) || (pos[1] + FIND_FLOOR_BUFFER) < entry->model->lowerY) {
+            continue;
+        }
+
+        // Only look for floors higher than the current one, in the object's space.
+        height = (*pheight - entry->transform[3][1]);
+        floor = find_floor_from_list(entry->model->lists[SPATIAL_PARTITION_FLOORS].next, pos[0], pos[1], pos[2], &height);
+        if (floor != NULL && (floor = get_local_surface_copy(entry, floor)) != NULL) {
+            *pheight = (height + entry->transform[3][1]);
+            *pfloor = floor;
+        }
+    }
+}
+#endif
+
+/**
+ * Find the highest floor under a given position and return its height, or FLOOR_LOWER_LIMIT if there isn't one.
+ * Floors of the level geometry are only checked above minStaticHeight, which has to be lower than the highest
+ * of them under the position, if there is one. *pfloor is left as is if there isn't a floor.
+ */
+static f32 find_floor_above(s32 x, s32 y, s32 z, struct Surface **pfloor, f32 minStaticHeight) {
+    f32 height = FLOOR_LOWER_LIMIT;
+    f32 staticHeight;
+    // Each level is split into cells to limit load, find the appropriate cell.
+    s32 cellX = GET_CELL_COORD(x);
+    s32 cellZ = GET_CELL_COORD(z);
+
+    struct SurfaceNode *surfaceList;
+    struct Surface *floor;
+
+    if (!(gCollisionFlags & COLLISION_FLAG_EXCLUDE_DYNAMIC)) {
+        // Check for surfaces belonging to objects.
+        surfaceList = gDynamicSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_FLOORS].next;
+        floor = find_floor_from_list(surfaceList, x, y, z, &height);
+        if (floor != NULL) {
+            *pfloor = floor;
+        }
+#ifdef LOCAL_SPACE_OBJECT_COLLISION
+        find_local_floor(x, y, z, pfloor, &height);
+#endif
+    }
+
+    // Check for surfaces that are a part of level geometry, only higher than the previous check.
+    // Object floors win ties.
+    staticHeight = MAX(height, minStaticHeight);
+    surfaceList = get_static_surface_list_at_height(cellX, cellZ, x, z, x, z, SPATIAL_PARTITION_FLOORS, (y + FIND_FLOOR_BUFFER));
+    floor = find_floor_from_list(surfaceList, x, y, z, &staticHeight);
+    if (floor != NULL) {
+        *pfloor = floor;
+        height = staticHeight;
+    }
+
+    // To prevent accidentally leaving the floor tangible, stop checking for it.
+    gCollisionFlags &= ~(COLLISION_FLAG_RETURN_FIRST | COLLISION_FLAG_EXCLUDE_DYNAMIC | COLLISION_FLAG_INCLUDE_INTANGIBLE);
+    // If a floor was missed, increment the debug counter.
+    if (*pfloor == NULL) {
+        gNumFindFloorMisses++;
+    }
+
+#ifdef VANILLA_DEBUG
+    // Increment the debug tracker.
+    gNumCalls.floor++;
+#endif
+
+    return height;
+}
+
 /**
  * Find the highest floor under a given position and return the height.
  */
 f32 find_floor(f32 xPos, f32 yPos, f32 zPos, struct Surface **pfloor) {
+    PROFILER_ZONE("find_floor");
     PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.collision_floor);
     PUPPYPRINT_GET_SNAPSHOT();
 
-    f32 height        = FLOOR_LOWER_LIMIT;
-    f32 dynamicHeight = FLOOR_LOWER_LIMIT;
+    f32 height = FLOOR_LOWER_LIMIT;
 
     //! (Parallel Universes) Because position is casted to an s16, reaching higher
     //  float locations can return floors despite them not existing there.
@@ -599,55 +817,273 @@ f32 find_floor(f32 xPos, f32 yPos, f32 zPos, struct Surface **pfloor) {
 
     *pfloor = NULL;
 
+    if (!is_outside_level_bounds(x, z)) {
+        height = find_floor_above(x, y, z, pfloor, FLOOR_LOWER_LIMIT);
+    }
+
+    profiler_collision_update(first);
+    return height;
+}
+
+/**
+ * Tries the floor a cache handle remembers and the floors sharing an edge with it, returning the first one
+ * that can be stood on from the point, and its height.
+ */
+static struct Surface *find_cached_floor(struct FloorCache *cache, s32 x, s32 y, s32 z, f32 *pheight) {
+    s32 bufferY = y + FIND_FLOOR_BUFFER;
+    s32 i;
+
+    if (cache->generation != gStaticFloorLinksGeneration || cache->index >= gNumStaticFloorLinks) {
+        return NULL;
+    }
+
+    struct StaticFloorLink *link = &gStaticFloorLinks[cache->index];
+    PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.collision_surfaces_visited);
+    if (check_floor_under_point(link->floor, x, bufferY, z, pheight)) {
+        return link->floor;
+    }
+
+    for (i = 0; i < 3; i++) {
+        s32 neighbor = link->neighbors[i];
+        if (neighbor == NO_FLOOR_LINK) {
+            continue;
+        }
+
+        PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.collision_surfaces_visited);
+        if (check_floor_under_point(gStaticFloorLinks[neighbor].floor, x, bufferY, z, pheight)) {
+            cache->index = neighbor;
+            return gStaticFloorLinks[neighbor].floor;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Find the highest floor under a given position and return the height, the same way find_floor does.
+ * The cache handle remembers the floor it finds, so that the next query nearby can start from it or
+ * one of its neighbors. Object floors are still all checked, but only floors of the level geometry at least
+ * as high as that one have to be checked then, and since cell lists are sorted from the highest down, the
+ * walk stops soon after it reaches it. Ties go to the same floor as in find_floor, since the walk still
+ * passes through every static floor at the cached height, in list order.
+ * Meant for things that look for a floor at about the same place every frame, each with their own handle.
+ */
+f32 find_floor_cached(struct FloorCache *cache, f32 xPos, f32 yPos, f32 zPos, struct Surface **pfloor) {
+    PROFILER_ZONE("find_floor");
+    PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.collision_floor);
+    PUPPYPRINT_GET_SNAPSHOT();
+
+    f32 height = FLOOR_LOWER_LIMIT;
+    s32 x = xPos;
+    s32 y = yPos;
+    s32 z = zPos;
+
+    *pfloor = NULL;
+
     if (is_outside_level_bounds(x, z)) {
         profiler_collision_update(first);
         return height;
     }
-    // Each level is split into cells to limit load, find the appropriate cell.
-    s32 cellX = GET_CELL_COORD(x);
-    s32 cellZ = GET_CELL_COORD(z);
 
-    struct SurfaceNode *surfaceList;
-    struct Surface *floor = NULL;
-    struct Surface *dynamicFloor = NULL;
+    // COLLISION_FLAG_RETURN_FIRST returns the first floor the walk finds, so it has to start from the same place.
+    struct Surface *cachedFloor = NULL;
+    f32 minStaticHeight = FLOOR_LOWER_LIMIT;
+    f32 cachedHeight;
+    if (!(gCollisionFlags & COLLISION_FLAG_RETURN_FIRST)) {
+        cachedFloor = find_cached_floor(cache, x, y, z, &cachedHeight);
+    }
+    if (cachedFloor != NULL) {
+        // Walk from just below the cached height, so every floor tied with it is still found in list order.
+        // Floor heights are far below 2^24, so subtracting 1 is exact.
+        minStaticHeight = (cachedHeight - 1.0f);
+    }
 
-    s32 includeDynamic = !(gCollisionFlags & COLLISION_FLAG_EXCLUDE_DYNAMIC);
+    height = find_floor_above(x, y, z, pfloor, minStaticHeight);
 
-    if (includeDynamic) {
-        // Check for surfaces belonging to objects.
-        surfaceList = gDynamicSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_FLOORS].next;
-        dynamicFloor = find_floor_from_list(surfaceList, x, y, z, &dynamicHeight);
+    if (*pfloor != NULL && *pfloor == cachedFloor) {
+        PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.floor_cache_hits);
+    } else {
+        PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.floor_cache_misses);
 
-        // In the next check, only check for floors higher than the previous check.
-        height = dynamicHeight;
+        // Only floors of the level geometry can be remembered, object floors can move or go away.
+        s32 index = (*pfloor != NULL) ? get_static_floor_link(*pfloor) : NO_FLOOR_LINK;
+        if (index != NO_FLOOR_LINK) {
+            cache->index = index;
+            cache->generation = gStaticFloorLinksGeneration;
+        }
     }
 
-    // Check for surfaces that are a part of level geometry.
-    surfaceList = gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_FLOORS].next;
-    floor = find_floor_from_list(surfaceList, x, y, z, &height);
+    profiler_collision_update(first);
+    return height;
+}
 
-    // Use the higher floor.
-    if (includeDynamic && height <= dynamicHeight) {
-        floor  = dynamicFloor;
-        height = dynamicHeight;
+/**
+ * The most queries find_floors_batched sorts at once, larger batches are split.
+ */
+#define FLOOR_QUERY_BATCH_SIZE 64
+
+/**
+ * Returns the lowest height a query in a bucket has found a floor at so far.
+ */
+static f32 get_lowest_query_height(struct FloorQuery *queries, s16 *bucket, s32 bucketSize) {
+    f32 lowestHeight = queries[bucket[0]].height;
+    s32 i;
+
+    for (i = 1; i < bucketSize; i++) {
+        lowestHeight = MIN(lowestHeight, queries[bucket[i]].height);
     }
 
-    // To prevent accidentally leaving the floor tangible, stop checking for it.
-    gCollisionFlags &= ~(COLLISION_FLAG_RETURN_FIRST | COLLISION_FLAG_EXCLUDE_DYNAMIC | COLLISION_FLAG_INCLUDE_INTANGIBLE);
-    // If a floor was missed, increment the debug counter.
-    if (floor == NULL) {
-        gNumFindFloorMisses++;
+    return lowestHeight;
+}
+
+/**
+ * Walks a list of floors once for every query in a bucket, finding the highest floor under
+ * each query that is higher than the floor it already has.
+ * With COLLISION_FLAG_RETURN_FIRST, each query keeps the first such floor in the list, like find_floor_from_list.
+ */
+static void find_floors_from_list_batched(struct SurfaceNode *surfaceNode, struct FloorQuery *queries, s16 *bucket, s32 bucketSize) {
+    struct Surface *surf;
+    f32 height;
+    f32 lowestHeight = get_lowest_query_height(queries, bucket, bucketSize);
+    s32 returnFirst = (gCollisionFlags & COLLISION_FLAG_RETURN_FIRST);
+    u8 done[FLOOR_QUERY_BATCH_SIZE];
+    s32 numDone = 0;
+    s32 i;
+
+    bzero(done, bucketSize);
+
+    while (surfaceNode != NULL) {
+        surf = surfaceNode->surface;
+        surfaceNode = surfaceNode->next;
+        PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.collision_surfaces_visited);
+
+        // The list is sorted from the highest upperY down, so none of the remaining floors
+        // can be higher than the floor any of the queries already has.
+        if (surf->upperY < lowestHeight) break;
+
+        s32 found = FALSE;
+        for (i = 0; i < bucketSize; i++) {
+            struct FloorQuery *query = &queries[bucket[i]];
+
+            if (done[i]) continue;
+
+            if (check_floor_under_point(surf, query->x, (query->y + FIND_FLOOR_BUFFER), query->z, &height) && height > query->height) {
+                query->height = height;
+                query->floor = surf;
+                found = TRUE;
+                if (returnFirst) {
+                    done[i] = TRUE;
+                    numDone++;
+                }
+            }
+        }
+
+        if (numDone == bucketSize) break;
+
+        if (found) {
+            lowestHeight = get_lowest_query_height(queries, bucket, bucketSize);
+        }
+    }
+}
+
+/**
+ * Finds the floors of a bucket of queries that are all in the same cell.
+ */
+static void find_floors_in_cell_batched(struct FloorQuery *queries, s16 *bucket, s32 bucketSize) {
+    struct FloorQuery *query = &queries[bucket[0]];
+    s32 cellX = GET_CELL_COORD(query->x);
+    s32 cellZ = GET_CELL_COORD(query->z);
+    s32 minX = query->x;
+    s32 minZ = query->z;
+    s32 maxX = query->x;
+    s32 maxZ = query->z;
+    s32 maxY = query->y;
+    s32 i;
+
+    for (i = 1; i < bucketSize; i++) {
+        query = &queries[bucket[i]];
+        minX = MIN(minX, query->x);
+        minZ = MIN(minZ, query->z);
+        maxX = MAX(maxX, query->x);
+        maxZ = MAX(maxZ, query->z);
+        maxY = MAX(maxY, query->y);
+    }
+
+    if (!(gCollisionFlags & COLLISION_FLAG_EXCLUDE_DYNAMIC)) {
+        // Check for surfaces belonging to objects.
+        find_floors_from_list_batched(gDynamicSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_FLOORS].next, queries, bucket, bucketSize);
+#ifdef LOCAL_SPACE_OBJECT_COLLISION
+        for (i = 0; i < bucketSize; i++) {
+            query = &queries[bucket[i]];
+            find_local_floor(query->x, query->y, query->z, &query->floor, &query->height);
+        }
+#endif
     }
 
-    // Return the floor.
-    *pfloor = floor;
+    // Check for surfaces that are a part of level geometry, only higher than the previous check.
+    // Starting from the highest query skips the same floors for all of them.
+    find_floors_from_list_batched(get_static_surface_list_at_height(cellX, cellZ, minX, minZ, maxX, maxZ, SPATIAL_PARTITION_FLOORS, (maxY + FIND_FLOOR_BUFFER)), queries, bucket, bucketSize);
+}
+
+/**
+ * Finds the highest floor under each of a number of positions, like calling find_floor for each of them.
+ * The queries are bucketed by cell, so that each cell's lists are only walked once for all the queries in it.
+ * Meant for effects that need many unrelated floors in the same frame. gCollisionFlags apply to the whole batch,
+ * and are cleared afterwards like they are by find_floor.
+ */
+void find_floors_batched(struct FloorQuery *queries, s32 numQueries) {
+    PROFILER_ZONE("find_floor");
+    PUPPYPRINT_GET_SNAPSHOT();
+    s16 order[FLOOR_QUERY_BATCH_SIZE];
+    u16 cells[FLOOR_QUERY_BATCH_SIZE];
+    s32 batchSize, numSorted, start, end, i, j;
+
+    for (; numQueries > 0; queries += batchSize, numQueries -= batchSize) {
+        batchSize = MIN(numQueries, FLOOR_QUERY_BATCH_SIZE);
+        numSorted = 0;
+
+        // Insertion sort the queries by cell, leaving out the ones outside of the level.
+        for (i = 0; i < batchSize; i++) {
+            struct FloorQuery *query = &queries[i];
+            PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.collision_floor);
+
+            query->floor = NULL;
+            query->height = FLOOR_LOWER_LIMIT;
+            if (is_outside_level_bounds(query->x, query->z)) {
+                continue;
+            }
+
+            u16 cell = ((GET_CELL_COORD(query->z) * NUM_CELLS) + GET_CELL_COORD(query->x));
+            for (j = numSorted; j > 0 && cells[j - 1] > cell; j--) {
+                cells[j] = cells[j - 1];
+                order[j] = order[j - 1];
+            }
+            cells[j] = cell;
+            order[j] = i;
+            numSorted++;
+        }
+
+        for (start = 0; start < numSorted; start = end) {
+            for (end = (start + 1); end < numSorted && cells[end] == cells[start]; end++);
+            find_floors_in_cell_batched(queries, &order[start], (end - start));
+        }
+
+        for (i = 0; i < batchSize; i++) {
+            // If a floor was missed, increment the debug counter.
+            if (queries[i].floor == NULL) {
+                gNumFindFloorMisses++;
+            }
+        }
 #ifdef VANILLA_DEBUG
-    // Increment the debug tracker.
-    gNumCalls.floor++;
+        // Increment the debug tracker.
+        gNumCalls.floor += batchSize;
 #endif
+    }
+
+    // To prevent accidentally leaving the floor tangible, stop checking for it.
+    gCollisionFlags &= ~(COLLISION_FLAG_RETURN_FIRST | COLLISION_FLAG_EXCLUDE_DYNAMIC | COLLISION_FLAG_INCLUDE_INTANGIBLE);
 
     profiler_collision_update(first);
-    return height;
 }
 
 f32 find_room_floor(f32 x, f32 y, f32 z, struct Surface **pfloor) {
@@ -690,7 +1126,7 @@ f32 find_water_floor(s32 xPos, s32 yPos, s32 zPos, struct Surface **pfloor) {
     s32 cellZ = GET_CELL_COORD(z);
 
     // Check for surfaces that are a part of level geometry.
-    struct SurfaceNode *surfaceList = gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_WATER].next;
+    struct SurfaceNode *surfaceList = get_static_surface_list(cellX, cellZ, x, z, x, z, SPATIAL_PARTITION_WATER);
     struct Surface     *floor       = find_water_floor_from_list(surfaceList, x, y, z, &height);
 
     if (floor == NULL) {
@@ -752,6 +1188,7 @@ s32 find_water_level_and_floor(s32 x, s32 y, s32 z, struct Surface **pfloor) {
  * Finds the height of water at a given location.
  */
 s32 find_water_level(s32 x, s32 z) { // TODO: Allow y pos
+    PROFILER_ZONE("find_water_level");
     s32 val;
     s32 loX, hiX, loZ, hiZ;
     TerrainData *p = gEnvironmentRegions;
@@ -939,3 +1376,58 @@ s32 unused_resolve_floor_or_ceil_collisions(s32 checkCeil, f32 *px, f32 *py, f32
 
     return 0;
 }
+
+#ifdef LOCAL_SPACE_OBJECT_COLLISION
+/**************************************************
+ *                    RAYCASTS                    *
+ **************************************************/
+
+/**
+ * Casts a ray against the objects that are queried in their own space, updating the hit when one of them is closer.
+ * Used by find_surface_on_ray, with the same arguments.
+ */
+void find_local_surface_on_ray(Vec3f orig, Vec3f dir, f32 dir_length, struct Surface **hit_surface, Vec3f hit_pos, f32 *max_length, s32 flags) {
+    struct Surface *localHit;
+    Vec3f localOrig, localDir, localHitPos;
+    f32 localMaxLength;
+    s32 i;
+
+    for (i = 0; i < gNumLocalCollisionObjects; i++) {
+        struct LocalCollisionObject *entry = &gLocalCollisionObjects[i];
+        struct LocalCollisionModel *model = entry->model;
+
+        // Rotations keep the length of the ray, so only the bounds have to be checked in the object's space.
+        to_local_space(entry, localOrig, orig);
+        linear_mtxf_transpose_mul_vec3(entry->transform, localDir, dir);
+
+        // The lists shorten the length to their hit, which only holds if that hit can be copied to world space.
+        localMaxLength = *max_length;
+
+        f32 endX = localOrig[0] + (localDir[0] * localMaxLength);
+        f32 endY = localOrig[1] + (localDir[1] * localMaxLength);
+        f32 endZ = localOrig[2] + (localDir[2] * localMaxLength);
+        if (MIN(localOrig[0], endX) > model->radius || MAX(localOrig[0], endX) < -model->radius
+            || MIN(localOrig[2], endZ) > model->radius || MAX(localOrig[2], endZ) < -model->radius
+            || MIN(localOrig[1], endY) > model->upperY || MAX(localOrig[1], endY) < model->lowerY) {
+            continue;
+        }
+
+        localHit = NULL;
+        if ((localDir[1] > -NEAR_ONE) && (flags & RAYCAST_FIND_CEIL)) {
+            find_surface_on_ray_list(model->lists[SPATIAL_PARTITION_CEILS ].next, localOrig, localDir, dir_length, &localHit, localHitPos, &localMaxLength);
+        }
+        if ((localDir[1] <  NEAR_ONE) && (flags & RAYCAST_FIND_FLOOR)) {
+            find_surface_on_ray_list(model->lists[SPATIAL_PARTITION_FLOORS].next, localOrig, localDir, dir_length, &localHit, localHitPos, &localMaxLength);
+        }
+        if (flags & RAYCAST_FIND_WALL) {
+            find_surface_on_ray_list(model->lists[SPATIAL_PARTITION_WALLS ].next, localOrig, localDir, dir_length, &localHit, localHitPos, &localMaxLength);
+        }
+
+        if (localHit != NULL && (localHit = get_local_surface_copy(entry, localHit)) != NULL) {
+            *hit_surface = localHit;
+            *max_length = localMaxLength;
+            to_world_space(entry, hit_pos, localHitPos);
+        }
+    }
+}
+#endif
@@ -42,6 +42,15 @@ struct WallCollisionData {
     /*0x18*/ struct Surface *walls[MAX_REFERENCED_WALLS];
 };
 
+/**
+ * A position given to find_floors_batched, and the floor it found under it.
+ */
+struct FloorQuery {
+    /*0x00*/ s32 x, y, z;
+    /*0x0C*/ f32 height;
+    /*0x10*/ struct Surface *floor;
+};
+
 s32 f32_find_wall_collision(f32 *xPtr, f32 *yPtr, f32 *zPtr, f32 offsetY, f32 radius);
 s32 find_wall_collisions(struct WallCollisionData *colData);
 void resolve_and_return_wall_collisions(Vec3f pos, f32 offset, f32 radius, struct WallCollisionData *collisionData);
@@ -54,6 +63,8 @@ ALWAYS_INLINE f32 find_mario_ceil(Vec3f pos, f32 height, struct Surface **ceil)
 
 f32 find_floor_height(f32 x, f32 y, f32 z);
 f32 find_floor(f32 xPos, f32 yPos, f32 zPos, struct Surface **pfloor);
+f32 find_floor_cached(struct FloorCache *cache, f32 xPos, f32 yPos, f32 zPos, struct Surface **pfloor);
+void find_floors_batched(struct FloorQuery *queries, s32 numQueries);
 f32 find_room_floor(f32 x, f32 y, f32 z, struct Surface **pfloor);
 s32 get_room_at_pos(f32 x, f32 y, f32 z);
 s32 find_water_level_and_floor(s32 x, s32 y, s32 z, struct Surface **pfloor);
@@ -62,5 +73,8 @@ s32 find_poison_gas_level(s32 x, s32 z);
 #ifdef VANILLA_DEBUG
 void debug_surface_list_info(f32 xPos, f32 zPos);
 #endif
+#ifdef LOCAL_SPACE_OBJECT_COLLISION
+void find_local_surface_on_ray(Vec3f orig, Vec3f dir, f32 dir_length, struct Surface **hit_surface, Vec3f hit_pos, f32 *max_length, s32 flags);
+#endif
 
 #endif // SURFACE_COLLISION_H
@@ -1,4 +1,5 @@
 #include <PR/ultratypes.h>
+#include <string.h>
 
 #include "sm64.h"
 #include "game/ingame_menu.h"
@@ -24,6 +25,21 @@
  */
 SpatialPartitionCell gStaticSurfacePartition[NUM_CELLS][NUM_CELLS];
 SpatialPartitionCell gDynamicSurfacePartition[NUM_CELLS][NUM_CELLS];
+#ifdef STATIC_SURFACE_SUBDIVISION_THRESHOLD
+/**
+ * Static cells that were too dense get split into STATIC_SURFACE_SUBDIVISIONS^2 smaller cells.
+ * Each entry is either NULL or points to that many SpatialPartitionCells in the static surface pool,
+ * indexed by (subZ * STATIC_SURFACE_SUBDIVISIONS + subX).
+ */
+SpatialPartitionCell *gStaticSurfaceSubcells[NUM_CELLS][NUM_CELLS];
+#endif
+#ifdef STATIC_SURFACE_BAND_THRESHOLD
+/**
+ * The bands of the static cells' lists. Each entry is either NULL or points to NUM_SPATIAL_PARTITIONS band pointers
+ * for the whole cell, followed by as many for each of its subcells, in the static surface pool.
+ */
+static struct SurfaceBands **sStaticSurfaceBands[NUM_CELLS][NUM_CELLS];
+#endif
 struct CellCoords {
     u8 z;
     u8 x;
@@ -52,14 +68,103 @@ void *gDynamicSurfacePoolEnd;
  */
 u32 gTotalStaticSurfaceData;
 
+/**
+ * The floors of the current area's level geometry, sorted by address, see build_static_floor_links.
+ */
+struct StaticFloorLink *gStaticFloorLinks;
+s32 gNumStaticFloorLinks;
+
+/**
+ * Changes every time the floor links are rebuilt, so FloorCache handles from another area are ignored. Never 0.
+ */
+u16 gStaticFloorLinksGeneration;
+
+/**
+ * While an area is loading, its floors are recorded here, growing down from the end of the static surface pool.
+ */
+static struct Surface **sStaticFloorStack;
+static struct Surface **sStaticFloorStackEnd;
+
+#ifdef BAKED_STATIC_COLLISION
+/**
+ * Set while an area's surfaces come from its baked image, so the surfaces in its collision data are skipped.
+ */
+static u8 sStaticSurfacesBaked;
+#endif
+
+/**
+ * Set while building an object's surfaces to link them somewhere else afterwards, instead of adding them to the partition as they are read.
+ */
+static u8 sDeferSurfaceLinking;
+
+#ifdef PERSISTENT_DYNAMIC_SURFACES
+/**
+ * The surfaces an object built from its collision model, kept between frames.
+ * Indexed by the object's slot in gObjectPool.
+ */
+struct DynamicSurfaceCache {
+    Mat4 transform; // The transform and scale the surfaces were built with
+    Vec3f scale;
+    TerrainData *collisionData;
+    struct Surface *surfaces;
+    u16 numSurfaces;
+    u16 capacity; // Triangles in collisionData, which surfaces has room for
+    u8 minCellX, maxCellX, minCellZ, maxCellZ; // Cells that hold the surfaces' nodes
+    u8 refreshed; // Whether the object loaded its collision since the last clear_dynamic_surfaces
+};
+
+static struct DynamicSurfaceCache sDynamicSurfaceCache[OBJECT_POOL_CAPACITY];
+
+/**
+ * Nodes unlinked from the dynamic partition, reused before allocating new ones.
+ */
+static struct SurfaceNode *sFreeDynamicSurfaceNodes;
+static s32 sNumFreeDynamicSurfaceNodes;
+#endif
+
+#ifdef LOCAL_SPACE_OBJECT_COLLISION
+struct LocalCollisionObject gLocalCollisionObjects[MAX_LOCAL_COLLISION_OBJECTS];
+s32 gNumLocalCollisionObjects;
+
+static struct LocalCollisionModel sLocalCollisionModels[MAX_LOCAL_COLLISION_MODELS];
+static s32 sNumLocalCollisionModels;
+
+/**
+ * Holds the surfaces and nodes of the local collision models, for as long as the level is loaded.
+ */
+static void *sLocalCollisionPool;
+static void *sLocalCollisionPoolEnd;
+
+/**
+ * World space copies of local surfaces returned by collision queries. Like other dynamic surfaces,
+ * they are valid until the next clear_dynamic_surfaces, so slots are never reused before then.
+ * Once they are all used, further copies go into the dynamic surface pool, see get_local_surface_copy.
+ */
+#define NUM_LOCAL_SURFACE_COPIES 64
+static struct Surface sLocalSurfaceCopies[NUM_LOCAL_SURFACE_COPIES];
+static struct Surface *sLocalSurfaceCopySources[NUM_LOCAL_SURFACE_COPIES];
+static struct Object *sLocalSurfaceCopyObjects[NUM_LOCAL_SURFACE_COPIES];
+static s32 sNumLocalSurfaceCopies;
+#endif
+
 /**
  * Allocate the part of the surface node pool to contain a surface node.
  */
 static struct SurfaceNode *alloc_surface_node(u32 dynamic) {
     struct SurfaceNode **poolEnd = (struct SurfaceNode **)(dynamic ? &gDynamicSurfacePoolEnd : &gCurrStaticSurfacePoolEnd);
 
-    struct SurfaceNode *node = *poolEnd;
-    (*poolEnd)++;
+    struct SurfaceNode *node;
+#ifdef PERSISTENT_DYNAMIC_SURFACES
+    if (dynamic && sFreeDynamicSurfaceNodes != NULL) {
+        node = sFreeDynamicSurfaceNodes;
+        sFreeDynamicSurfaceNodes = node->next;
+        sNumFreeDynamicSurfaceNodes--;
+    } else
+#endif
+    {
+        node = *poolEnd;
+        (*poolEnd)++;
+    }
     gSurfaceNodesAllocated++;
 
     node->next = NULL;
@@ -88,11 +193,9 @@ static struct Surface *alloc_surface(u32 dynamic) {
 }
 
 /**
- * Iterates through the entire partition, clearing the surfaces.
+ * Iterates through a number of cells, clearing the surfaces.
  */
-static void clear_spatial_partition(SpatialPartitionCell *cells) {
-    register s32 i = sqr(NUM_CELLS);
-
+static void clear_spatial_partition_cells(SpatialPartitionCell *cells, s32 i) {
     while (i--) {
         (*cells)[SPATIAL_PARTITION_FLOORS].next = NULL;
         (*cells)[SPATIAL_PARTITION_CEILS].next = NULL;
@@ -103,39 +206,290 @@ static void clear_spatial_partition(SpatialPartitionCell *cells) {
     }
 }
 
+/**
+ * Iterates through the entire partition, clearing the surfaces.
+ */
+static void clear_spatial_partition(SpatialPartitionCell *cells) {
+    clear_spatial_partition_cells(cells, sqr(NUM_CELLS));
+}
+
 /**
  * Clears the static (level) surface partitions for new use.
  */
 static void clear_static_surfaces(void) {
     gTotalStaticSurfaceData = 0;
     clear_spatial_partition(&gStaticSurfacePartition[0][0]);
+#ifdef STATIC_SURFACE_SUBDIVISION_THRESHOLD
+    bzero(gStaticSurfaceSubcells, sizeof(gStaticSurfaceSubcells));
+#endif
+#ifdef STATIC_SURFACE_BAND_THRESHOLD
+    bzero(sStaticSurfaceBands, sizeof(sStaticSurfaceBands));
+#endif
 }
 
 /**
- * Add a surface to the correct cell list of surfaces.
- * @param dynamic Determines whether the surface is static or dynamic
- * @param cellX The X position of the cell in which the surface resides
- * @param cellZ The Z position of the cell in which the surface resides
- * @param surface The surface to add
+ * Inserts a surface node into a cell list, keeping the list sorted by priority.
  */
-static void add_surface_to_cell(s32 dynamic, s32 cellX, s32 cellZ, struct Surface *surface) {
-    struct SurfaceNode *list;
+static void insert_surface_node(struct SurfaceNode *list, struct SurfaceNode *newNode, s32 surfacePriority, s32 sortDir) {
     s32 priority;
-    s32 sortDir = 1; // highest to lowest, then insertion order (water and floors)
-    s32 listIndex;
 
+    // Loop until we find the appropriate place for the surface in the list.
+    while (list->next != NULL) {
+        priority = list->next->surface->upperY * sortDir;
+
+        if (surfacePriority > priority) {
+            break;
+        }
+
+        list = list->next;
+    }
+
+    newNode->next = list->next;
+    list->next = newNode;
+}
+
+#ifdef STATIC_SURFACE_SUBDIVISION_THRESHOLD
+/**
+ * Walls can push the query position around while their list is being walked, so they are added to
+ * every subcell within this distance to keep those pushes from stepping past walls in the same cell.
+ */
+#define SUBCELL_WALL_MARGIN 128
+
+/**
+ * Converts a coordinate into a subcell coordinate, clamped to the subcells of the given cell.
+ */
+static s32 get_subcell_index(s32 coord, s32 cell) {
+    s32 index = (coord + LEVEL_BOUNDARY_MAX) / SUBCELL_SIZE;
+    s32 firstIndex = (cell * STATIC_SURFACE_SUBDIVISIONS);
+
+    // Division rounds toward zero, so anything left of the level boundary needs to be caught here.
+    if ((coord + LEVEL_BOUNDARY_MAX) < 0) {
+        index = 0;
+    }
+
+    return (CLAMP(index, firstIndex, (firstIndex + STATIC_SURFACE_SUBDIVISIONS - 1)) - firstIndex);
+}
+
+/**
+ * Finds the range of subcells a surface touches within a cell.
+ */
+static void get_surface_subcell_range(struct Surface *surface, s32 cellX, s32 cellZ, s32 listIndex, s32 *minSubX, s32 *minSubZ, s32 *maxSubX, s32 *maxSubZ) {
+    s32 minX, maxX, minZ, maxZ;
+    s32 margin = ((listIndex == SPATIAL_PARTITION_WALLS) ? SUBCELL_WALL_MARGIN : 0);
+
+    min_max_3i(surface->vertex1[0], surface->vertex2[0], surface->vertex3[0], &minX, &maxX);
+    min_max_3i(surface->vertex1[2], surface->vertex2[2], surface->vertex3[2], &minZ, &maxZ);
+
+    *minSubX = get_subcell_index((minX - margin), cellX);
+    *maxSubX = get_subcell_index((maxX + margin), cellX);
+    *minSubZ = get_subcell_index((minZ - margin), cellZ);
+    *maxSubZ = get_subcell_index((maxZ + margin), cellZ);
+}
+
+/**
+ * Adds a static surface to the sorted lists of every subcell it touches.
+ */
+static void add_surface_to_subcells(s32 cellX, s32 cellZ, s32 listIndex, struct Surface *surface, s32 surfacePriority, s32 sortDir) {
+    SpatialPartitionCell *subcells = gStaticSurfaceSubcells[cellZ][cellX];
+    s32 minSubX, minSubZ, maxSubX, maxSubZ;
+
+    get_surface_subcell_range(surface, cellX, cellZ, listIndex, &minSubX, &minSubZ, &maxSubX, &maxSubZ);
+
+    for (s32 subZ = minSubZ; subZ <= maxSubZ; subZ++) {
+        for (s32 subX = minSubX; subX <= maxSubX; subX++) {
+            struct SurfaceNode *newNode = alloc_surface_node(FALSE);
+            newNode->surface = surface;
+            insert_surface_node(&subcells[(subZ * STATIC_SURFACE_SUBDIVISIONS) + subX][listIndex], newNode, surfacePriority, sortDir);
+        }
+    }
+}
+
+/**
+ * Splits a static cell into subcells. The cell lists are already sorted, so each surface is
+ * appended to the end of its subcell lists, which keeps the same order.
+ * The cell is left as it is if the subcells don't fit below the recorded floors.
+ */
+static void subdivide_static_cell(s32 cellX, s32 cellZ) {
+    SpatialPartitionCell *subcells = gCurrStaticSurfacePoolEnd;
+    struct SurfaceNode *tails[sqr(STATIC_SURFACE_SUBDIVISIONS)];
+    s32 minSubX, minSubZ, maxSubX, maxSubZ;
+    s32 numNodes = 0;
+
+    for (s32 listIndex = 0; listIndex < NUM_SPATIAL_PARTITIONS; listIndex++) {
+        for (struct SurfaceNode *node = gStaticSurfacePartition[cellZ][cellX][listIndex].next; node != NULL; node = node->next) {
+            get_surface_subcell_range(node->surface, cellX, cellZ, listIndex, &minSubX, &minSubZ, &maxSubX, &maxSubZ);
+            numNodes += ((maxSubX - minSubX + 1) * (maxSubZ - minSubZ + 1));
+        }
+    }
+
+    // The floors recorded for build_static_floor_links grow down from the end of the same pool.
+    void *poolLimit = ((sStaticFloorStack != NULL) ? (void *) sStaticFloorStack : (void *) sStaticFloorStackEnd);
+    if ((void *) ((struct SurfaceNode *) (subcells + sqr(STATIC_SURFACE_SUBDIVISIONS)) + numNodes) > poolLimit) {
+        return;
+    }
+
+    gCurrStaticSurfacePoolEnd = (subcells + sqr(STATIC_SURFACE_SUBDIVISIONS));
+    clear_spatial_partition_cells(subcells, sqr(STATIC_SURFACE_SUBDIVISIONS));
+    gStaticSurfaceSubcells[cellZ][cellX] = subcells;
+
+    for (s32 listIndex = 0; listIndex < NUM_SPATIAL_PARTITIONS; listIndex++) {
+        struct SurfaceNode *node = gStaticSurfacePartition[cellZ][cellX][listIndex].next;
+
+        for (s32 i = 0; i < sqr(STATIC_SURFACE_SUBDIVISIONS); i++) {
+            tails[i] = &subcells[i][listIndex];
+        }
+
+        while (node != NULL) {
+            get_surface_subcell_range(node->surface, cellX, cellZ, listIndex, &minSubX, &minSubZ, &maxSubX, &maxSubZ);
+
+            for (s32 subZ = minSubZ; subZ <= maxSubZ; subZ++) {
+                for (s32 subX = minSubX; subX <= maxSubX; subX++) {
+                    s32 i = ((subZ * STATIC_SURFACE_SUBDIVISIONS) + subX);
+                    struct SurfaceNode *newNode = alloc_surface_node(FALSE);
+                    newNode->surface = node->surface;
+                    tails[i]->next = newNode;
+                    tails[i] = newNode;
+                }
+            }
+
+            node = node->next;
+        }
+    }
+}
+
+/**
+ * Subdivides every static cell that has a list longer than STATIC_SURFACE_SUBDIVISION_THRESHOLD.
+ */
+static void subdivide_static_surfaces(void) {
+    for (s32 cellZ = 0; cellZ < NUM_CELLS; cellZ++) {
+        for (s32 cellX = 0; cellX < NUM_CELLS; cellX++) {
+            for (s32 listIndex = 0; listIndex < NUM_SPATIAL_PARTITIONS; listIndex++) {
+                struct SurfaceNode *node = gStaticSurfacePartition[cellZ][cellX][listIndex].next;
+                s32 count = 0;
+
+                while (node != NULL && count <= STATIC_SURFACE_SUBDIVISION_THRESHOLD) {
+                    node = node->next;
+                    count++;
+                }
+
+                if (count > STATIC_SURFACE_SUBDIVISION_THRESHOLD) {
+                    subdivide_static_cell(cellX, cellZ);
+                    break;
+                }
+            }
+        }
+    }
+}
+#endif
+
+/**
+ * Returns the head of the static surface list that covers the given area within a cell. If the cell has been subdivided
+ * and the area fits in one subcell, the shorter subcell list is used instead of the whole cell's list.
+ * *slot is set to 0 for the whole cell's list, or to 1 + the index of the subcell.
+ */
+static struct SurfaceNode *get_static_surface_list_head(s32 cellX, s32 cellZ, UNUSED s32 minX, UNUSED s32 minZ, UNUSED s32 maxX, UNUSED s32 maxZ, s32 partition, s32 *slot) {
+#ifdef STATIC_SURFACE_SUBDIVISION_THRESHOLD
+    SpatialPartitionCell *subcells = gStaticSurfaceSubcells[cellZ][cellX];
+
+    if (subcells != NULL) {
+        s32 subX = get_subcell_index(minX, cellX);
+        s32 subZ = get_subcell_index(minZ, cellZ);
+
+        if (subX == get_subcell_index(maxX, cellX) && subZ == get_subcell_index(maxZ, cellZ)) {
+            *slot = (1 + (subZ * STATIC_SURFACE_SUBDIVISIONS) + subX);
+            return &subcells[*slot - 1][partition];
+        }
+    }
+#endif
+
+    *slot = 0;
+    return &gStaticSurfacePartition[cellZ][cellX][partition];
+}
+
+/**
+ * Returns the static surface list that covers the given area within a cell.
+ */
+struct SurfaceNode *get_static_surface_list(s32 cellX, s32 cellZ, s32 minX, s32 minZ, s32 maxX, s32 maxZ, s32 partition) {
+    s32 slot;
+
+    return get_static_surface_list_head(cellX, cellZ, minX, minZ, maxX, maxZ, partition, &slot)->next;
+}
+
+/**
+ * Returns the static surface list that covers the given area within a cell, starting from the first surface
+ * that can be hit at height y. For floors, y is the height including FIND_FLOOR_BUFFER. Walls may get a list
+ * that only holds the walls around y. Floors above y, ceilings below y and walls away from y aren't always left out.
+ */
+struct SurfaceNode *get_static_surface_list_at_height(s32 cellX, s32 cellZ, s32 minX, s32 minZ, s32 maxX, s32 maxZ, s32 partition, UNUSED s32 y) {
+    s32 slot;
+    struct SurfaceNode *head = get_static_surface_list_head(cellX, cellZ, minX, minZ, maxX, maxZ, partition, &slot);
+#ifdef STATIC_SURFACE_BAND_THRESHOLD
+    struct SurfaceBands **cellBands = sStaticSurfaceBands[cellZ][cellX];
+
+    if (cellBands != NULL && cellBands[(slot * NUM_SPATIAL_PARTITIONS) + partition] != NULL) {
+        struct SurfaceBands *bands = cellBands[(slot * NUM_SPATIAL_PARTITIONS) + partition];
+        s32 index = ((y - bands->lowerY) / STATIC_SURFACE_BAND_HEIGHT);
+        struct SurfaceBand *band = &bands->bands[CLAMP(index, 0, (bands->numBands - 1))];
+#ifdef PUPPYPRINT_DEBUG
+        gPuppyCallCounter.collision_surfaces_skipped += band->numSkipped;
+#endif
+        return band->list;
+    }
+#endif
+
+    return head->next;
+}
+
+/**
+ * Returns which list of a cell a surface goes into, and the direction that list is sorted in.
+ */
+static s32 get_surface_partition(struct Surface *surface, s32 *sortDir) {
     if (SURFACE_IS_NEW_WATER(surface->type)) {
-        listIndex = SPATIAL_PARTITION_WATER;
+        *sortDir = 1; // highest to lowest, then insertion order
+        return SPATIAL_PARTITION_WATER;
     } else if (surface->normal.y > NORMAL_FLOOR_THRESHOLD) {
-        listIndex = SPATIAL_PARTITION_FLOORS;
+        *sortDir = 1; // highest to lowest, then insertion order
+        return SPATIAL_PARTITION_FLOORS;
     } else if (surface->normal.y < NORMAL_CEIL_THRESHOLD) {
-        listIndex = SPATIAL_PARTITION_CEILS;
-        sortDir = -1; // lowest to highest, then insertion order
+        *sortDir = -1; // lowest to highest, then insertion order
+        return SPATIAL_PARTITION_CEILS;
     } else {
-        listIndex = SPATIAL_PARTITION_WALLS;
-        sortDir = 0; // insertion order
+        *sortDir = 0; // insertion order
+        return SPATIAL_PARTITION_WALLS;
+    }
+}
+
+/**
+ * Records a floor of the area that is loading, for build_static_floor_links.
+ */
+static void record_static_floor(struct Surface *surface) {
+    s32 sortDir;
+
+    if (sStaticFloorStack == NULL || get_surface_partition(surface, &sortDir) != SPATIAL_PARTITION_FLOORS) {
+        return;
     }
 
+    // Stop recording once the pool runs into the recorded floors.
+    if ((void *) (sStaticFloorStack - 1) < gCurrStaticSurfacePoolEnd) {
+        sStaticFloorStack = NULL;
+        return;
+    }
+
+    *--sStaticFloorStack = surface;
+}
+
+/**
+ * Add a surface to the correct cell list of surfaces.
+ * @param dynamic Determines whether the surface is static or dynamic
+ * @param cellX The X position of the cell in which the surface resides
+ * @param cellZ The Z position of the cell in which the surface resides
+ * @param surface The surface to add
+ */
+static void add_surface_to_cell(s32 dynamic, s32 cellX, s32 cellZ, struct Surface *surface) {
+    struct SurfaceNode *list;
+    s32 sortDir;
+    s32 listIndex = get_surface_partition(surface, &sortDir);
+
     s32 surfacePriority = surface->upperY * sortDir;
 
     struct SurfaceNode *newNode = alloc_surface_node(dynamic);
@@ -143,6 +497,7 @@ static void add_surface_to_cell(s32 dynamic, s32 cellX, s32 cellZ, struct Surfac
 
     if (dynamic) {
         list = &gDynamicSurfacePartition[cellZ][cellX][listIndex];
+#ifndef PERSISTENT_DYNAMIC_SURFACES
         if (sNumCellsUsed >= sizeof(sCellsUsed) / sizeof(struct CellCoords)) {
             sClearAllCells = TRUE;
         } else {
@@ -153,23 +508,22 @@ static void add_surface_to_cell(s32 dynamic, s32 cellX, s32 cellZ, struct Surfac
                 sNumCellsUsed++;
             }
         }
+#endif
     } else {
         list = &gStaticSurfacePartition[cellZ][cellX][listIndex];
-    }
-
-    // Loop until we find the appropriate place for the surface in the list.
-    while (list->next != NULL) {
-        priority = list->next->surface->upperY * sortDir;
-
-        if (surfacePriority > priority) {
-            break;
+#ifdef STATIC_SURFACE_BAND_THRESHOLD
+        // The bands of the cell's lists would miss surfaces added after the area has loaded (static object models).
+        sStaticSurfaceBands[cellZ][cellX] = NULL;
+#endif
+#ifdef STATIC_SURFACE_SUBDIVISION_THRESHOLD
+        // Surfaces added after the area has loaded (static object models) also need to go into the smaller cells.
+        if (gStaticSurfaceSubcells[cellZ][cellX] != NULL) {
+            add_surface_to_subcells(cellX, cellZ, listIndex, surface, surfacePriority, sortDir);
         }
-
-        list = list->next;
+#endif
     }
 
-    newNode->next = list->next;
-    list->next = newNode;
+    insert_surface_node(list, newNode, surfacePriority, sortDir);
 }
 
 /**
@@ -210,6 +564,21 @@ static s32 upper_cell_index(s32 coord) {
     return MIN((NUM_CELLS - 1), index);
 }
 
+/**
+ * Finds the range of cells a surface touches.
+ */
+static void get_surface_cell_range(struct Surface *surface, s32 *minCellX, s32 *maxCellX, s32 *minCellZ, s32 *maxCellZ) {
+    s32 minX, maxX, minZ, maxZ;
+
+    min_max_3i(surface->vertex1[0], surface->vertex2[0], surface->vertex3[0], &minX, &maxX);
+    min_max_3i(surface->vertex1[2], surface->vertex2[2], surface->vertex3[2], &minZ, &maxZ);
+
+    *minCellX = lower_cell_index(minX);
+    *maxCellX = upper_cell_index(maxX);
+    *minCellZ = lower_cell_index(minZ);
+    *maxCellZ = upper_cell_index(maxZ);
+}
+
 /**
  * Every level is split into 16x16 cells, this takes a surface, finds
  * the appropriate cells (with a buffer), and adds the surface to those
@@ -219,15 +588,9 @@ static s32 upper_cell_index(s32 coord) {
  */
 static void add_surface(struct Surface *surface, s32 dynamic) {
     s32 cellZ, cellX;
-    s32 minX, maxX, minZ, maxZ;
-
-    min_max_3i(surface->vertex1[0], surface->vertex2[0], surface->vertex3[0], &minX, &maxX);
-    min_max_3i(surface->vertex1[2], surface->vertex2[2], surface->vertex3[2], &minZ, &maxZ);
+    s32 minCellX, maxCellX, minCellZ, maxCellZ;
 
-    s32 minCellX = lower_cell_index(minX);
-    s32 maxCellX = upper_cell_index(maxX);
-    s32 minCellZ = lower_cell_index(minZ);
-    s32 maxCellZ = upper_cell_index(maxZ);
+    get_surface_cell_range(surface, &minCellX, &maxCellX, &minCellZ, &maxCellZ);
 
     for (cellZ = minCellZ; cellZ <= maxCellZ; cellZ++) {
         for (cellX = minCellX; cellX <= maxCellX; cellX++) {
@@ -349,6 +712,17 @@ static void load_static_surfaces(TerrainData **data, TerrainData *vertexData, s3
 
     s32 numSurfaces = *(*data)++;
 
+#ifdef BAKED_STATIC_COLLISION
+    if (sStaticSurfacesBaked) {
+#ifdef ALL_SURFACES_HAVE_FORCE
+        *data += 4 * numSurfaces;
+#else
+        *data += (3 + hasForce) * numSurfaces;
+#endif
+        return;
+    }
+#endif
+
     for (i = 0; i < numSurfaces; i++) {
         if (*surfaceRooms != NULL) {
             room = *(*surfaceRooms)++;
@@ -371,6 +745,7 @@ static void load_static_surfaces(TerrainData **data, TerrainData *vertexData, s3
 #endif
 
             add_surface(surface, FALSE);
+            record_static_floor(surface);
         }
 
 #ifdef ALL_SURFACES_HAVE_FORCE
@@ -411,12 +786,329 @@ static void load_environmental_regions(TerrainData **data) {
     }
 }
 
+#ifdef BAKED_STATIC_COLLISION
+/**
+ * Loads the static surfaces of an area from an image made by tools/collision_baker.py, which is only in ROM.
+ * The surfaces are DMA'd straight into the static surface pool and the cell lists are linked in their baked order.
+ * The rest of the image is only needed while loading, so it's read into the free space of the pool past the nodes.
+ * Returns FALSE without loading anything if the image doesn't match the current collision settings.
+ */
+static s32 load_baked_static_surfaces(const struct BakedCollision *bakedRom, RoomData *surfaceRooms) {
+    static u8 header[ALIGN16(sizeof(struct BakedCollision))] ALIGNED16;
+    struct BakedCollision *baked = (struct BakedCollision *) header;
+    s32 i, j;
+
+    dma_read(header, (u8 *) bakedRom, (u8 *) (bakedRom + 1));
+
+    if (baked->version != BAKED_COLLISION_VERSION || baked->cellSize != CELL_SIZE || baked->numCells != NUM_CELLS) {
+        return FALSE;
+    }
+#ifndef ALL_SURFACES_HAVE_FORCE
+    if (baked->flags & BAKED_COLLISION_FLAG_NEEDS_SURFACE_FORCE) {
+        return FALSE;
+    }
+#endif
+#ifndef ENABLE_VANILLA_LEVEL_SPECIFIC_CHECKS
+    // Degenerate triangles are kept with a broken normal when the checks are disabled, which isn't worth baking.
+    if (baked->flags & BAKED_COLLISION_FLAG_HAS_DEGENERATE_TRIS) {
+        return FALSE;
+    }
+#endif
+
+    // dma_read copies whole 16 byte blocks, so every array gets a 16 byte aligned spot that it can overrun.
+    struct Surface *surfaces = gCurrStaticSurfacePoolEnd;
+    struct SurfaceNode *node = (struct SurfaceNode *) (surfaces + baked->numSurfaces);
+    struct BakedSurfaceList *lists = (struct BakedSurfaceList *) ALIGN16((uintptr_t) (node + baked->numNodes));
+    u16 *nodeSurfaces = (u16 *) ALIGN16((uintptr_t) (lists + baked->numLists));
+    u16 *surfaceTris = (u16 *) ALIGN16((uintptr_t) (nodeSurfaces + baked->numNodes));
+    void *loadEnd = (void *) ALIGN16((uintptr_t) (surfaceTris + baked->numSurfaces));
+
+    if (loadEnd > (void *) sStaticFloorStack) {
+        return FALSE;
+    }
+
+    dma_read((u8 *) surfaces, (u8 *) baked->surfaces, (u8 *) (baked->surfaces + baked->numSurfaces));
+    dma_read((u8 *) lists, (u8 *) baked->lists, (u8 *) (baked->lists + baked->numLists));
+    dma_read((u8 *) nodeSurfaces, (u8 *) baked->nodes, (u8 *) (baked->nodes + baked->numNodes));
+    if (surfaceRooms != NULL) {
+        dma_read((u8 *) surfaceTris, (u8 *) baked->surfaceTris, (u8 *) (baked->surfaceTris + baked->numSurfaces));
+    }
+
+    gCurrStaticSurfacePoolEnd = node + baked->numNodes;
+    gSurfacesAllocated += baked->numSurfaces;
+    gSurfaceNodesAllocated += baked->numNodes;
+
+    if (surfaceRooms != NULL) {
+        for (i = 0; i < baked->numSurfaces; i++) {
+            surfaces[i].room = surfaceRooms[surfaceTris[i]];
+        }
+    }
+
+    for (i = 0; i < (s32)baked->numLists; i++) {
+        const struct BakedSurfaceList *bakedList = &lists[i];
+        struct SurfaceNode *list = &gStaticSurfacePartition[bakedList->cellZ][bakedList->cellX][bakedList->partition];
+        const u16 *surfaceIndex = &nodeSurfaces[bakedList->firstNode];
+
+        for (j = 0; j < bakedList->numNodes; j++) {
+            node->surface = &surfaces[*surfaceIndex++];
+            list->next = node;
+            list = node++;
+        }
+        list->next = NULL;
+    }
+
+    for (i = 0; i < baked->numSurfaces; i++) {
+        record_static_floor(&surfaces[i]);
+    }
+
+    return TRUE;
+}
+#endif
+
+/**
+ * Hashes a directed edge of a floor.
+ */
+static u32 hash_floor_edge(TerrainData *a, TerrainData *b) {
+    return (((u32) a[0] * 73856093) ^ ((u32) a[1] * 19349663) ^ ((u32) a[2] * 83492791)
+          ^ ((u32) b[0] * 50331653) ^ ((u32) b[1] * 12582917) ^ ((u32) b[2] * 3145739));
+}
+
+/**
+ * Gets the start and end vertex of one of a floor's edges.
+ */
+static void get_floor_edge(struct Surface *floor, s32 edge, TerrainData **a, TerrainData **b) {
+    TerrainData *vertices[3] = { floor->vertex1, floor->vertex2, floor->vertex3 };
+
+    *a = vertices[edge];
+    *b = vertices[(edge + 1) % 3];
+}
+
+/**
+ * Builds gStaticFloorLinks at the end of the static surface pool from the floors recorded while loading the area.
+ * Adjacent floors wind their shared edge in opposite directions, so each floor's neighbors are found by
+ * looking up the reverse of its edges in a hash of every edge, which is built in the pool's free space.
+ */
+static void build_static_floor_links(void) {
+    struct Surface **floors = sStaticFloorStack;
+    s32 numFloors = (sStaticFloorStackEnd - floors);
+    struct StaticFloorLink *links = gCurrStaticSurfacePoolEnd;
+    TerrainData *a, *b, *otherA, *otherB;
+    s32 i, edge;
+
+    sStaticFloorStack = NULL;
+    gStaticFloorLinks = NULL;
+    gNumStaticFloorLinks = 0;
+    if (++gStaticFloorLinksGeneration == 0) {
+        gStaticFloorLinksGeneration = 1;
+    }
+
+    // Give up if the pool ran into the recorded floors, or there are too many to index.
+    if (floors == NULL || (void *) &links[numFloors] > (void *) floors || numFloors > 0x7FFF) {
+        return;
+    }
+
+    // They were recorded in the order they were allocated, so reading them backwards sorts them by address.
+    for (i = 0; i < numFloors; i++) {
+        links[i].floor = floors[numFloors - 1 - i];
+        links[i].neighbors[0] = NO_FLOOR_LINK;
+        links[i].neighbors[1] = NO_FLOOR_LINK;
+        links[i].neighbors[2] = NO_FLOOR_LINK;
+    }
+    gCurrStaticSurfacePoolEnd = &links[numFloors];
+    gStaticFloorLinks = links;
+    gNumStaticFloorLinks = numFloors;
+
+    // Each slot holds (floor * 3 + edge), or -1 if empty. Keep the table at most half full.
+    u32 numSlots = 1;
+    while (numSlots < (u32) (numFloors * 3 * 2)) {
+        numSlots <<= 1;
+    }
+    s32 *slots = gCurrStaticSurfacePoolEnd;
+    if ((void *) &slots[numSlots] > (void *) sStaticFloorStackEnd) {
+        return;
+    }
+    u32 mask = (numSlots - 1);
+    u32 slot;
+
+    for (slot = 0; slot < numSlots; slot++) {
+        slots[slot] = -1;
+    }
+
+    for (i = 0; i < numFloors; i++) {
+        for (edge = 0; edge < 3; edge++) {
+            get_floor_edge(links[i].floor, edge, &a, &b);
+            for (slot = (hash_floor_edge(a, b) & mask); slots[slot] != -1; slot = ((slot + 1) & mask));
+            slots[slot] = ((i * 3) + edge);
+        }
+    }
+
+    for (i = 0; i < numFloors; i++) {
+        for (edge = 0; edge < 3; edge++) {
+            get_floor_edge(links[i].floor, edge, &a, &b);
+            for (slot = (hash_floor_edge(b, a) & mask); slots[slot] != -1; slot = ((slot + 1) & mask)) {
+                s32 other = (slots[slot] / 3);
+                get_floor_edge(links[other].floor, (slots[slot] % 3), &otherA, &otherB);
+
+                if (other != i && !memcmp(otherA, b, sizeof(Vec3t)) && !memcmp(otherB, a, sizeof(Vec3t))) {
+                    links[i].neighbors[edge] = other;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Returns the index of a floor in gStaticFloorLinks, or NO_FLOOR_LINK if it isn't part of the current area's level geometry.
+ */
+s32 get_static_floor_link(struct Surface *floor) {
+    s32 low = 0;
+    s32 high = (gNumStaticFloorLinks - 1);
+
+    while (low <= high) {
+        s32 mid = ((low + high) / 2);
+        struct Surface *midFloor = gStaticFloorLinks[mid].floor;
+
+        if (midFloor == floor) {
+            return mid;
+        } else if ((uintptr_t) midFloor < (uintptr_t) floor) {
+            low = (mid + 1);
+        } else {
+            high = (mid - 1);
+        }
+    }
+
+    return NO_FLOOR_LINK;
+}
+
+#ifdef STATIC_SURFACE_BAND_THRESHOLD
+/**
+ * Splits a static floor, ceiling or wall list into bands of STATIC_SURFACE_BAND_HEIGHT, in the static surface pool.
+ * The band of a floor list starts at its first floor that isn't entirely above the top of the band, and the band of
+ * a ceiling list starts at its first ceiling that isn't entirely below the bottom of the band. The band of a wall list
+ * is a new list of the walls that overlap the band, in the same order. Returns NULL if the list fits in one band.
+ */
+static struct SurfaceBands *build_surface_list_bands(struct SurfaceNode *list, s32 partition) {
+    struct SurfaceNode *node;
+    s32 lowerY = list->surface->lowerY;
+    s32 upperY = list->surface->upperY;
+
+    for (node = list; node != NULL; node = node->next) {
+        lowerY = MIN(lowerY, node->surface->lowerY);
+        upperY = MAX(upperY, node->surface->upperY);
+    }
+
+    s32 numBands = (((upperY - lowerY) / STATIC_SURFACE_BAND_HEIGHT) + 1);
+    if (numBands <= 1) {
+        return NULL;
+    }
+
+    struct SurfaceBands *bands = gCurrStaticSurfacePoolEnd;
+    gCurrStaticSurfacePoolEnd = &bands->bands[numBands];
+    bands->lowerY = lowerY;
+    bands->numBands = numBands;
+
+    for (s32 i = 0; i < numBands; i++) {
+        struct SurfaceBand *band = &bands->bands[i];
+        s32 bottom = (lowerY + (i * STATIC_SURFACE_BAND_HEIGHT));
+        s32 top = (bottom + STATIC_SURFACE_BAND_HEIGHT - 1);
+
+        band->numSkipped = 0;
+
+        if (partition == SPATIAL_PARTITION_WALLS) {
+            struct SurfaceNode head;
+            struct SurfaceNode *tail = &head;
+
+            for (node = list; node != NULL; node = node->next) {
+                if (node->surface->lowerY <= top && node->surface->upperY >= bottom) {
+                    tail->next = alloc_surface_node(FALSE);
+                    tail = tail->next;
+                    tail->surface = node->surface;
+                } else {
+                    band->numSkipped++;
+                }
+            }
+
+            tail->next = NULL;
+            band->list = head.next;
+        } else {
+            for (node = list; node != NULL; node = node->next) {
+                if (partition == SPATIAL_PARTITION_FLOORS ? (node->surface->lowerY <= top) : (node->surface->upperY >= bottom)) {
+                    break;
+                }
+                band->numSkipped++;
+            }
+
+            band->list = node;
+        }
+    }
+
+    return bands;
+}
+
+/**
+ * Splits every static list that is longer than STATIC_SURFACE_BAND_THRESHOLD into bands, including the lists of subcells.
+ */
+static void build_static_surface_bands(void) {
+    for (s32 cellZ = 0; cellZ < NUM_CELLS; cellZ++) {
+        for (s32 cellX = 0; cellX < NUM_CELLS; cellX++) {
+            SpatialPartitionCell *cells = &gStaticSurfacePartition[cellZ][cellX];
+            s32 numCells = 1;
+            struct SurfaceBands **cellBands = NULL;
+#ifdef STATIC_SURFACE_SUBDIVISION_THRESHOLD
+            if (gStaticSurfaceSubcells[cellZ][cellX] != NULL) {
+                numCells += sqr(STATIC_SURFACE_SUBDIVISIONS);
+            }
+#endif
+
+            for (s32 slot = 0; slot < numCells; slot++) {
+#ifdef STATIC_SURFACE_SUBDIVISION_THRESHOLD
+                if (slot > 0) {
+                    cells = &gStaticSurfaceSubcells[cellZ][cellX][slot - 1];
+                }
+#endif
+                // Water is looked up by height in its own way, so only floors, ceilings and walls get bands.
+                for (s32 listIndex = 0; listIndex < SPATIAL_PARTITION_WATER; listIndex++) {
+                    struct SurfaceNode *node = (*cells)[listIndex].next;
+                    s32 numSurfaces = 0;
+
+                    while (node != NULL && numSurfaces <= STATIC_SURFACE_BAND_THRESHOLD) {
+                        node = node->next;
+                        numSurfaces++;
+                    }
+
+                    if (numSurfaces <= STATIC_SURFACE_BAND_THRESHOLD) {
+                        continue;
+                    }
+
+                    if (cellBands == NULL) {
+                        cellBands = gCurrStaticSurfacePoolEnd;
+                        gCurrStaticSurfacePoolEnd = &cellBands[numCells * NUM_SPATIAL_PARTITIONS];
+                        bzero(cellBands, (numCells * NUM_SPATIAL_PARTITIONS * sizeof(struct SurfaceBands *)));
+                        sStaticSurfaceBands[cellZ][cellX] = cellBands;
+                    }
+
+                    cellBands[(slot * NUM_SPATIAL_PARTITIONS) + listIndex] = build_surface_list_bands((*cells)[listIndex].next, listIndex);
+                }
+            }
+        }
+    }
+}
+#endif
+
 /**
  * Allocate the dynamic surface pool for object collision.
  */
 void alloc_surface_pools(void) {
     gDynamicSurfacePool = main_pool_alloc(DYNAMIC_SURFACE_POOL_SIZE, MEMORY_POOL_LEFT);
     gDynamicSurfacePoolEnd = gDynamicSurfacePool;
+    sClearAllCells = TRUE;
+#ifdef LOCAL_SPACE_OBJECT_COLLISION
+    sLocalCollisionPool = main_pool_alloc(LOCAL_COLLISION_POOL_SIZE, MEMORY_POOL_LEFT);
+    sLocalCollisionPoolEnd = sLocalCollisionPool;
+    sNumLocalCollisionModels = 0;
+    gNumLocalCollisionObjects = 0;
+#endif
 
     gCCMEnteredSlide = FALSE;
     reset_red_coins_collected();
@@ -481,9 +1173,9 @@ u32 get_area_terrain_size(TerrainData *data) {
 
 /**
  * Process the level file, loading in vertices, surfaces, some objects, and environmental
- * boxes (water, gas, JRB fog).
+ * boxes (water, gas, JRB fog). If bakedData is usable, the surfaces are loaded from it instead.
  */
-void load_area_terrain(s32 index, TerrainData *data, RoomData *surfaceRooms, s16 *macroObjects) {
+void load_area_terrain(s32 index, TerrainData *data, RoomData *surfaceRooms, s16 *macroObjects, UNUSED const struct BakedCollision *bakedData) {
     PUPPYPRINT_GET_SNAPSHOT();
     s32 terrainLoadType;
     TerrainData *vertexData = NULL;
@@ -500,8 +1192,15 @@ void load_area_terrain(s32 index, TerrainData *data, RoomData *surfaceRooms, s16
     clear_static_surfaces();
 
     // Initialise a new surface pool for this block of static surface data
-    gCurrStaticSurfacePool = main_pool_alloc(main_pool_available() - 0x10, MEMORY_POOL_LEFT);
+    u32 poolSize = (main_pool_available() - 0x10);
+    gCurrStaticSurfacePool = main_pool_alloc(poolSize, MEMORY_POOL_LEFT);
     gCurrStaticSurfacePoolEnd = gCurrStaticSurfacePool;
+    sStaticFloorStackEnd = (struct Surface **) (((uintptr_t) gCurrStaticSurfacePool + poolSize) & ~(sizeof(struct Surface *) - 1));
+    sStaticFloorStack = sStaticFloorStackEnd;
+
+#ifdef BAKED_STATIC_COLLISION
+    sStaticSurfacesBaked = (bakedData != NULL && load_baked_static_surfaces(bakedData, surfaceRooms));
+#endif
 
     // A while loop iterating through each section of the level data. Sections of data
     // are prefixed by a terrain "type." This type is reused for surfaces as the surface
@@ -527,6 +1226,14 @@ void load_area_terrain(s32 index, TerrainData *data, RoomData *surfaceRooms, s16
         }
     }
 
+#ifdef BAKED_STATIC_COLLISION
+    sStaticSurfacesBaked = FALSE;
+#endif
+
+#ifdef STATIC_SURFACE_SUBDIVISION_THRESHOLD
+    subdivide_static_surfaces();
+#endif
+
     if (macroObjects != NULL && *macroObjects != -1) {
         // If the first macro object presetID is within the range [0, 29].
         // Generally an early spawning method, every object is in BBH (the first level).
@@ -539,6 +1246,11 @@ void load_area_terrain(s32 index, TerrainData *data, RoomData *surfaceRooms, s16
         }
     }
 
+    build_static_floor_links();
+#ifdef STATIC_SURFACE_BAND_THRESHOLD
+    build_static_surface_bands();
+#endif
+
     surfacePoolData = (uintptr_t)gCurrStaticSurfacePoolEnd - (uintptr_t)gCurrStaticSurfacePool;
     gTotalStaticSurfaceData += surfacePoolData;
     main_pool_realloc(gCurrStaticSurfacePool, surfacePoolData);
@@ -548,6 +1260,164 @@ void load_area_terrain(s32 index, TerrainData *data, RoomData *surfaceRooms, s16
     profiler_collision_update(first);
 }
 
+#if defined(PERSISTENT_DYNAMIC_SURFACES) || defined(LOCAL_SPACE_OBJECT_COLLISION)
+/**
+ * Returns whether a block of the given size still fits at the end of the dynamic surface pool.
+ */
+static s32 dynamic_surface_pool_has_room(size_t size) {
+    return (((uintptr_t) gDynamicSurfacePoolEnd + size) <= ((uintptr_t) gDynamicSurfacePool + DYNAMIC_SURFACE_POOL_SIZE));
+}
+
+/**
+ * Returns the number of triangles in an object's collision model.
+ */
+static s32 count_object_surfaces(TerrainData *data) {
+    s32 count = 0;
+
+    data++;
+    data += 1 + (3 * *data);
+
+    while (*data != TERRAIN_LOAD_CONTINUE) {
+        UNUSED s32 surfaceType = *data++;
+        s32 numSurfaces = *data++;
+
+#ifdef ALL_SURFACES_HAVE_FORCE
+        data += (4 * numSurfaces);
+#else
+        data += ((surface_has_force(surfaceType) ? 4 : 3) * numSurfaces);
+#endif
+        count += numSurfaces;
+    }
+
+    return count;
+}
+#endif
+
+#ifdef PERSISTENT_DYNAMIC_SURFACES
+/**
+ * Adds an object's surfaces to the dynamic partition and remembers which cells they went into.
+ */
+static void link_object_surfaces(struct DynamicSurfaceCache *entry) {
+    s32 minX = LEVEL_BOUNDARY_MAX;
+    s32 minZ = LEVEL_BOUNDARY_MAX;
+    s32 maxX = -LEVEL_BOUNDARY_MAX;
+    s32 maxZ = -LEVEL_BOUNDARY_MAX;
+    s32 surfMinX, surfMaxX, surfMinZ, surfMaxZ;
+
+    for (s32 i = 0; i < entry->numSurfaces; i++) {
+        struct Surface *surface = &entry->surfaces[i];
+
+        add_surface(surface, TRUE);
+
+        min_max_3i(surface->vertex1[0], surface->vertex2[0], surface->vertex3[0], &surfMinX, &surfMaxX);
+        min_max_3i(surface->vertex1[2], surface->vertex2[2], surface->vertex3[2], &surfMinZ, &surfMaxZ);
+        minX = MIN(minX, surfMinX);
+        maxX = MAX(maxX, surfMaxX);
+        minZ = MIN(minZ, surfMinZ);
+        maxZ = MAX(maxZ, surfMaxZ);
+    }
+
+    entry->minCellX = lower_cell_index(minX);
+    entry->maxCellX = upper_cell_index(maxX);
+    entry->minCellZ = lower_cell_index(minZ);
+    entry->maxCellZ = upper_cell_index(maxZ);
+}
+
+/**
+ * Returns the number of nodes link_object_surfaces needs for an object's surfaces.
+ */
+static s32 count_object_surface_nodes(struct DynamicSurfaceCache *entry) {
+    s32 minCellX, maxCellX, minCellZ, maxCellZ;
+    s32 count = 0;
+
+    for (s32 i = 0; i < entry->numSurfaces; i++) {
+        get_surface_cell_range(&entry->surfaces[i], &minCellX, &maxCellX, &minCellZ, &maxCellZ);
+        count += ((maxCellX - minCellX + 1) * (maxCellZ - minCellZ + 1));
+    }
+
+    return count;
+}
+
+/**
+ * Removes every node of an object's surfaces from the dynamic partition.
+ */
+static void unlink_object_surfaces(struct Object *obj, struct DynamicSurfaceCache *entry) {
+    for (s32 cellZ = entry->minCellZ; cellZ <= entry->maxCellZ; cellZ++) {
+        for (s32 cellX = entry->minCellX; cellX <= entry->maxCellX; cellX++) {
+            for (s32 listIndex = 0; listIndex < NUM_SPATIAL_PARTITIONS; listIndex++) {
+                struct SurfaceNode *list = &gDynamicSurfacePartition[cellZ][cellX][listIndex];
+
+                while (list->next != NULL) {
+                    struct SurfaceNode *node = list->next;
+
+                    if (node->surface->object == obj) {
+                        list->next = node->next;
+                        node->next = sFreeDynamicSurfaceNodes;
+                        sFreeDynamicSurfaceNodes = node;
+                        sNumFreeDynamicSurfaceNodes++;
+                        gSurfaceNodesAllocated--;
+                    } else {
+                        list = node;
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Removes an object's surfaces from the partition and frees them.
+ */
+static void drop_object_surfaces(struct Object *obj) {
+    struct DynamicSurfaceCache *entry = &sDynamicSurfaceCache[obj - gObjectPool];
+
+    if (entry->surfaces == NULL) {
+        return;
+    }
+
+    unlink_object_surfaces(obj, entry);
+
+    // Only space at the end of the pool can be given back, anything else waits for the next reset.
+    if ((void *) &entry->surfaces[entry->capacity] == gDynamicSurfacePoolEnd) {
+        gDynamicSurfacePoolEnd = entry->surfaces;
+    }
+    gSurfacesAllocated -= entry->capacity;
+    entry->surfaces = NULL;
+}
+
+/**
+ * Drops the surfaces of objects that didn't load their collision last frame, or have been unloaded.
+ */
+static void drop_stale_dynamic_surfaces(void) {
+    for (s32 i = 0; i < OBJECT_POOL_CAPACITY; i++) {
+        struct DynamicSurfaceCache *entry = &sDynamicSurfaceCache[i];
+
+        if (entry->surfaces != NULL && (!entry->refreshed || gObjectPool[i].activeFlags == ACTIVE_FLAG_DEACTIVATED)) {
+            drop_object_surfaces(&gObjectPool[i]);
+        }
+        entry->refreshed = FALSE;
+    }
+}
+
+/**
+ * Empties the dynamic partition and pool, so every object rebuilds its surfaces the next time it loads them.
+ */
+static void reset_dynamic_surfaces(void) {
+    for (s32 i = 0; i < OBJECT_POOL_CAPACITY; i++) {
+        sDynamicSurfaceCache[i].surfaces = NULL;
+        sDynamicSurfaceCache[i].refreshed = FALSE;
+    }
+
+    gSurfacesAllocated = gNumStaticSurfaces;
+    gSurfaceNodesAllocated = gNumStaticSurfaceNodes;
+    gDynamicSurfacePoolEnd = gDynamicSurfacePool;
+    sFreeDynamicSurfaceNodes = NULL;
+    sNumFreeDynamicSurfaceNodes = 0;
+    clear_spatial_partition(&gDynamicSurfacePartition[0][0]);
+    sClearAllCells = FALSE;
+}
+#endif
+
 /**
  * If not in time stop, clear the surface partitions.
  */
@@ -556,6 +1426,18 @@ void clear_dynamic_surfaces(void) {
     if (!(gTimeStopState & TIME_STOP_ACTIVE)) {
         clear_dynamic_surface_references();
 
+#ifdef LOCAL_SPACE_OBJECT_COLLISION
+        gNumLocalCollisionObjects = 0;
+        sNumLocalSurfaceCopies = 0;
+#endif
+#ifdef PERSISTENT_DYNAMIC_SURFACES
+        // Surfaces dropped while they weren't at the end of the pool leave gaps, so start over once it gets too full.
+        if (sClearAllCells || ((uintptr_t) gDynamicSurfacePoolEnd - (uintptr_t) gDynamicSurfacePool) > DYNAMIC_SURFACE_POOL_SIZE / 4 * 3) {
+            reset_dynamic_surfaces();
+        } else {
+            drop_stale_dynamic_surfaces();
+        }
+#else
         gSurfacesAllocated = gNumStaticSurfaces;
         gSurfaceNodesAllocated = gNumStaticSurfaceNodes;
         gDynamicSurfacePoolEnd = gDynamicSurfacePool;
@@ -568,25 +1450,34 @@ void clear_dynamic_surfaces(void) {
         }
         sNumCellsUsed = 0;
         sClearAllCells = FALSE;
+#endif
     }
     profiler_collision_update(first);
 }
 
+/**
+ * Returns the current object's transform, building it from its position and angle
+ * if it isn't using it as its throw matrix yet this frame.
+ */
+static Mat4 *get_object_transform(void) {
+    if (o->header.gfx.throwMatrix == NULL) {
+        o->header.gfx.throwMatrix = &o->transform;
+        obj_build_transform_from_pos_and_angle(o, O_POS_INDEX, O_FACE_ANGLE_INDEX);
+    }
+
+    return &o->transform;
+}
+
 /**
  * Applies an object's transformation to the object's vertices.
  */
 void transform_object_vertices(TerrainData **data, TerrainData *vertexData) {
-    Mat4 *objectTransform = &o->transform;
+    Mat4 *objectTransform = get_object_transform();
 
     register s32 numVertices = *(*data)++;
 
     register TerrainData *vertices = *data;
 
-    if (o->header.gfx.throwMatrix == NULL) {
-        o->header.gfx.throwMatrix = objectTransform;
-        obj_build_transform_from_pos_and_angle(o, O_POS_INDEX, O_FACE_ANGLE_INDEX);
-    }
-
     Mat4 transform;
     mtxf_scale_vec3f(transform, *objectTransform, o->header.gfx.scale);
 
@@ -643,7 +1534,9 @@ void load_object_surfaces(TerrainData **data, TerrainData *vertexData, u32 dynam
 
             surface->flags |= flags;
             surface->room = room;
-            add_surface(surface, dynamic);
+            if (!sDeferSurfaceLinking) {
+                add_surface(surface, dynamic);
+            }
         }
 
 #ifdef ALL_SURFACES_HAVE_FORCE
@@ -679,12 +1572,290 @@ static void get_optimal_coll_dist(struct Object *obj) {
 
 static TerrainData sVertexData[600];
 
+#ifdef PERSISTENT_DYNAMIC_SURFACES
+/**
+ * Loads the current object's surfaces, reusing the ones from its last load if its transform,
+ * scale and collision model are unchanged. Otherwise they are rebuilt in place and relinked.
+ */
+static void load_persistent_object_surfaces(void) {
+    struct DynamicSurfaceCache *entry = &sDynamicSurfaceCache[o - gObjectPool];
+    TerrainData *collisionData = o->collisionData;
+
+    entry->refreshed = TRUE;
+
+    get_object_transform();
+
+    if (entry->surfaces != NULL
+        && entry->collisionData == collisionData
+        && !memcmp(entry->transform, o->transform, sizeof(Mat4))
+        && !memcmp(entry->scale, o->header.gfx.scale, sizeof(Vec3f))) {
+        PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.dynamic_surface_objects_reused);
+        return;
+    }
+    PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.dynamic_surface_objects_rebuilt);
+
+    if (entry->surfaces != NULL) {
+        if (entry->collisionData == collisionData) {
+            unlink_object_surfaces(o, entry);
+        } else {
+            drop_object_surfaces(o);
+        }
+    }
+
+    if (entry->surfaces == NULL) {
+        s32 capacity = count_object_surfaces(collisionData);
+
+        // Gaps left by dropped surfaces can fill the pool up. Rather than run past it, the object goes
+        // without collision for this frame, and the next clear_dynamic_surfaces starts over.
+        if (!dynamic_surface_pool_has_room(capacity * sizeof(struct Surface))) {
+            sClearAllCells = TRUE;
+            return;
+        }
+
+        entry->collisionData = collisionData;
+        entry->capacity = capacity;
+        entry->surfaces = gDynamicSurfacePoolEnd;
+        gDynamicSurfacePoolEnd = &entry->surfaces[entry->capacity];
+        gSurfacesAllocated += entry->capacity;
+    }
+
+    mtxf_copy(entry->transform, o->transform);
+    vec3f_copy(entry->scale, o->header.gfx.scale);
+
+    // Build the surfaces over the old ones by pointing the pool at them for the duration.
+    void *poolEnd = gDynamicSurfacePoolEnd;
+    s32 surfacesAllocated = gSurfacesAllocated;
+    gDynamicSurfacePoolEnd = entry->surfaces;
+    sDeferSurfaceLinking = TRUE;
+
+    collisionData++;
+    transform_object_vertices(&collisionData, sVertexData);
+
+    // TERRAIN_LOAD_CONTINUE acts as an "end" to the terrain data.
+    while (*collisionData != TERRAIN_LOAD_CONTINUE) {
+        load_object_surfaces(&collisionData, sVertexData, TRUE);
+    }
+
+    sDeferSurfaceLinking = FALSE;
+
+    entry->numSurfaces = ((struct Surface *) gDynamicSurfacePoolEnd - entry->surfaces);
+    gDynamicSurfacePoolEnd = poolEnd;
+    gSurfacesAllocated = surfacesAllocated;
+
+    // The same goes for the nodes that aren't covered by unlinked ones.
+    s32 numNewNodes = (count_object_surface_nodes(entry) - sNumFreeDynamicSurfaceNodes);
+    if (numNewNodes > 0 && !dynamic_surface_pool_has_room(numNewNodes * sizeof(struct SurfaceNode))) {
+        drop_object_surfaces(o);
+        sClearAllCells = TRUE;
+        return;
+    }
+
+    link_object_surfaces(entry);
+}
+#endif
+
+#ifdef LOCAL_SPACE_OBJECT_COLLISION
+/**
+ * Returns the model space collision model of the current object, building it if no object has used it at this scale yet.
+ * Returns NULL if there is no room left for it.
+ */
+static struct LocalCollisionModel *get_local_collision_model(void) {
+    TerrainData *collisionData = o->collisionData;
+    struct LocalCollisionModel *model;
+    s32 i;
+
+    for (i = 0; i < sNumLocalCollisionModels; i++) {
+        model = &sLocalCollisionModels[i];
+        if (model->collisionData == collisionData && !memcmp(model->scale, o->header.gfx.scale, sizeof(Vec3f))) {
+            return model;
+        }
+    }
+
+    s32 capacity = count_object_surfaces(collisionData);
+    if (sNumLocalCollisionModels >= MAX_LOCAL_COLLISION_MODELS
+        || ((uintptr_t) sLocalCollisionPoolEnd + capacity * (sizeof(struct Surface) + sizeof(struct SurfaceNode)))
+           > ((uintptr_t) sLocalCollisionPool + LOCAL_COLLISION_POOL_SIZE)) {
+        return NULL;
+    }
+
+    model = &sLocalCollisionModels[sNumLocalCollisionModels++];
+    model->collisionData = collisionData;
+    vec3f_copy(model->scale, o->header.gfx.scale);
+    model->radius = 0.0f;
+    model->lowerY = 0;
+    model->upperY = 0;
+    for (i = 0; i < NUM_SPATIAL_PARTITIONS; i++) {
+        model->lists[i].next = NULL;
+    }
+
+    // Scale the vertices, without rotating or moving them.
+    collisionData++;
+    s32 numVertices = *collisionData++;
+    TerrainData *vertexData = sVertexData;
+    f32 radiusSquared = 0.0f;
+
+    while (numVertices--) {
+        vec3_prod(vertexData, collisionData, model->scale);
+        radiusSquared = MAX(radiusSquared, sqr(vertexData[0]) + sqr(vertexData[2]));
+        collisionData += 3;
+        vertexData += 3;
+    }
+    model->radius = sqrtf(radiusSquared);
+
+    // Build the surfaces into the local pool.
+    void *poolEnd = gDynamicSurfacePoolEnd;
+    s32 surfacesAllocated = gSurfacesAllocated;
+    struct Surface *surfaces = sLocalCollisionPoolEnd;
+    gDynamicSurfacePoolEnd = surfaces;
+    sDeferSurfaceLinking = TRUE;
+
+    // TERRAIN_LOAD_CONTINUE acts as an "end" to the terrain data.
+    while (*collisionData != TERRAIN_LOAD_CONTINUE) {
+        load_object_surfaces(&collisionData, sVertexData, TRUE);
+    }
+
+    s32 numSurfaces = ((struct Surface *) gDynamicSurfacePoolEnd - surfaces);
+    sDeferSurfaceLinking = FALSE;
+    gDynamicSurfacePoolEnd = poolEnd;
+    gSurfacesAllocated = surfacesAllocated;
+
+    // Sort them into the model's lists, one node each.
+    struct SurfaceNode *nodes = (struct SurfaceNode *) &surfaces[numSurfaces];
+    for (i = 0; i < numSurfaces; i++) {
+        struct Surface *surface = &surfaces[i];
+        s32 sortDir;
+        s32 listIndex = get_surface_partition(surface, &sortDir);
+
+        nodes[i].surface = surface;
+        insert_surface_node(&model->lists[listIndex], &nodes[i], (surface->upperY * sortDir), sortDir);
+
+        model->lowerY = MIN(model->lowerY, surface->lowerY);
+        model->upperY = MAX(model->upperY, surface->upperY);
+    }
+    sLocalCollisionPoolEnd = &nodes[numSurfaces];
+
+    return model;
+}
+
+/**
+ * Registers the current object for local space collision queries this frame, if it opted in with OBJ_FLAG_LOCAL_SPACE_COLLISION.
+ * Returns FALSE if its surfaces have to be loaded into the dynamic partition instead.
+ */
+static s32 load_local_object_collision(void) {
+    if (!(o->oFlags & OBJ_FLAG_LOCAL_SPACE_COLLISION)) {
+        return FALSE;
+    }
+
+    Mat4 *transform = get_object_transform();
+    s32 i;
+
+    // Queries only move the lateral position into the object's space, so it has to be upright.
+    if ((*transform)[1][1] < NEAR_ONE) {
+        return FALSE;
+    }
+
+    for (i = 0; i < gNumLocalCollisionObjects; i++) {
+        if (gLocalCollisionObjects[i].obj == o) {
+            break;
+        }
+    }
+    if (i >= MAX_LOCAL_COLLISION_OBJECTS) {
+        return FALSE;
+    }
+
+    // Water levels are only looked up in the dynamic partition.
+    struct LocalCollisionModel *model = get_local_collision_model();
+    if (model == NULL || model->lists[SPATIAL_PARTITION_WATER].next != NULL) {
+        return FALSE;
+    }
+
+    struct LocalCollisionObject *entry = &gLocalCollisionObjects[i];
+    mtxf_copy(entry->transform, *transform);
+    entry->obj = o;
+    entry->model = model;
+    if (i == gNumLocalCollisionObjects) {
+        gNumLocalCollisionObjects++;
+    }
+
+#ifdef PERSISTENT_DYNAMIC_SURFACES
+    // Remove the surfaces left from a frame where it was loaded into the partition.
+    drop_object_surfaces(o);
+#endif
+    return TRUE;
+}
+
+/**
+ * Returns a world space copy of one of the surfaces of a local collision object, valid until the next
+ * clear_dynamic_surfaces. Repeated queries that hit the same surface of the same object get the same copy back.
+ * Returns NULL if there is no room left for the copy, in which case the query ignores the surface.
+ */
+struct Surface *get_local_surface_copy(struct LocalCollisionObject *entry, struct Surface *surface) {
+    struct Surface *copy;
+    s32 i;
+
+    for (i = 0; i < sNumLocalSurfaceCopies; i++) {
+        if (sLocalSurfaceCopySources[i] == surface && sLocalSurfaceCopyObjects[i] == entry->obj) {
+            return &sLocalSurfaceCopies[i];
+        }
+    }
+
+    if (sNumLocalSurfaceCopies < NUM_LOCAL_SURFACE_COPIES) {
+        i = sNumLocalSurfaceCopies++;
+        sLocalSurfaceCopySources[i] = surface;
+        sLocalSurfaceCopyObjects[i] = entry->obj;
+        copy = &sLocalSurfaceCopies[i];
+    } else if (dynamic_surface_pool_has_room(sizeof(struct Surface))) {
+        // Earlier copies may still be held by whoever queried them, so take one from the dynamic pool instead,
+        // which is cleared along with them.
+        copy = gDynamicSurfacePoolEnd;
+        gDynamicSurfacePoolEnd = (copy + 1);
+#ifdef PERSISTENT_DYNAMIC_SURFACES
+        // The pool isn't emptied every frame then, so make the next clear_dynamic_surfaces start over.
+        sClearAllCells = TRUE;
+#endif
+    } else {
+        return NULL;
+    }
+
+    Vec3f v, n;
+    s16 min, max;
+
+    *copy = *surface;
+
+    vec3s_to_vec3f(v, surface->vertex1);
+    linear_mtxf_mul_vec3_and_translate(entry->transform, v, v);
+    vec3f_to_vec3s(copy->vertex1, v);
+    vec3s_to_vec3f(v, surface->vertex2);
+    linear_mtxf_mul_vec3_and_translate(entry->transform, v, v);
+    vec3f_to_vec3s(copy->vertex2, v);
+    vec3s_to_vec3f(v, surface->vertex3);
+    linear_mtxf_mul_vec3_and_translate(entry->transform, v, v);
+    vec3f_to_vec3s(copy->vertex3, v);
+
+    vec3_set(n, surface->normal.x, surface->normal.y, surface->normal.z);
+    linear_mtxf_mul_vec3(entry->transform, n, n);
+    copy->normal.x = n[0];
+    copy->normal.y = n[1];
+    copy->normal.z = n[2];
+    copy->originOffset = -vec3_dot(n, copy->vertex1);
+
+    min_max_3s(copy->vertex1[1], copy->vertex2[1], copy->vertex3[1], &min, &max);
+    copy->lowerY = (min - SURFACE_VERTICAL_BUFFER);
+    copy->upperY = (max + SURFACE_VERTICAL_BUFFER);
+    copy->object = entry->obj;
+
+    return copy;
+}
+#endif
+
 /**
  * Transform an object's vertices, reload them, and render the object.
  */
 void load_object_collision_model(void) {
     PUPPYPRINT_GET_SNAPSHOT();
+#ifndef PERSISTENT_DYNAMIC_SURFACES
     TerrainData *collisionData = o->collisionData;
+#endif
 
     Vec3f dist;
     vec3_diff(dist, &o->oPosVec, &gMarioObject->oPosVec);
@@ -716,14 +1887,29 @@ void load_object_collision_model(void) {
         && inColRadius
         && !(o->activeFlags & ACTIVE_FLAG_IN_DIFFERENT_ROOM)
     ) {
-        collisionData++;
-        transform_object_vertices(&collisionData, sVertexData);
+#ifdef LOCAL_SPACE_OBJECT_COLLISION
+        // Objects queried in their own space don't load anything.
+        if (!load_local_object_collision())
+#endif
+        {
+#ifdef PERSISTENT_DYNAMIC_SURFACES
+            load_persistent_object_surfaces();
+#else
+            collisionData++;
+            transform_object_vertices(&collisionData, sVertexData);
 
-        // TERRAIN_LOAD_CONTINUE acts as an "end" to the terrain data.
-        while (*collisionData != TERRAIN_LOAD_CONTINUE) {
-            load_object_surfaces(&collisionData, sVertexData, TRUE);
+            // TERRAIN_LOAD_CONTINUE acts as an "end" to the terrain data.
+            while (*collisionData != TERRAIN_LOAD_CONTINUE) {
+                load_object_surfaces(&collisionData, sVertexData, TRUE);
+            }
+#endif
         }
     }
+#ifdef PERSISTENT_DYNAMIC_SURFACES
+    else if (!(gTimeStopState & TIME_STOP_ACTIVE)) {
+        drop_object_surfaces(o);
+    }
+#endif
 
     f32 marioDist = o->oDistanceToMario;
 
@@ -748,6 +1934,11 @@ void load_object_static_model(void) {
     // Initialise a new surface pool for this block of surface data
     gCurrStaticSurfacePool = main_pool_alloc(main_pool_available() - 0x10, MEMORY_POOL_LEFT);
     gCurrStaticSurfacePoolEnd = gCurrStaticSurfacePool;
+#ifdef PERSISTENT_DYNAMIC_SURFACES
+    // Dynamic surfaces outlive this frame, so keep counting them.
+    s32 numDynamicSurfaceNodes = (gSurfaceNodesAllocated - gNumStaticSurfaceNodes);
+    s32 numDynamicSurfaces = (gSurfacesAllocated - gNumStaticSurfaces);
+#endif
     gSurfaceNodesAllocated = gNumStaticSurfaceNodes;
     gSurfacesAllocated = gNumStaticSurfaces;
 
@@ -765,5 +1956,9 @@ void load_object_static_model(void) {
 
     gNumStaticSurfaceNodes = gSurfaceNodesAllocated;
     gNumStaticSurfaces = gSurfacesAllocated;
+#ifdef PERSISTENT_DYNAMIC_SURFACES
+    gSurfaceNodesAllocated += numDynamicSurfaceNodes;
+    gSurfacesAllocated += numDynamicSurfaces;
+#endif
     profiler_collision_update(first);
 }
@@ -33,19 +33,97 @@ typedef struct SurfaceNode SpatialPartitionCell[NUM_SPATIAL_PARTITIONS];
 
 extern SpatialPartitionCell gStaticSurfacePartition[NUM_CELLS][NUM_CELLS];
 extern SpatialPartitionCell gDynamicSurfacePartition[NUM_CELLS][NUM_CELLS];
+#ifdef STATIC_SURFACE_SUBDIVISION_THRESHOLD
+#define SUBCELL_SIZE (CELL_SIZE / STATIC_SURFACE_SUBDIVISIONS)
+STATIC_ASSERT(((CELL_SIZE % STATIC_SURFACE_SUBDIVISIONS) == 0), "STATIC_SURFACE_SUBDIVISIONS must divide CELL_SIZE evenly!");
+extern SpatialPartitionCell *gStaticSurfaceSubcells[NUM_CELLS][NUM_CELLS];
+#endif
+#ifdef STATIC_SURFACE_BAND_THRESHOLD
+/**
+ * Where a query in one band of a static surface list starts walking, see build_static_surface_bands.
+ */
+struct SurfaceBand {
+    struct SurfaceNode *list;
+    u16 numSkipped; // Number of surfaces in the whole list that aren't walked
+};
+
+/**
+ * A long static surface list split into bands of STATIC_SURFACE_BAND_HEIGHT, from the lowest surface up.
+ */
+struct SurfaceBands {
+    s16 lowerY;
+    s16 numBands;
+    struct SurfaceBand bands[];
+};
+#endif
 extern void *gCurrStaticSurfacePool;
 extern void *gDynamicSurfacePool;
 extern void *gCurrStaticSurfacePoolEnd;
 extern void *gDynamicSurfacePoolEnd;
 extern u32 gTotalStaticSurfaceData;
 
+#define NO_FLOOR_LINK -1
+
+/**
+ * A floor of the current area's level geometry and the floors it shares an edge with.
+ */
+struct StaticFloorLink {
+    struct Surface *floor;
+    s16 neighbors[3]; // Index of the floor across each edge, or NO_FLOOR_LINK
+};
+
+extern struct StaticFloorLink *gStaticFloorLinks;
+extern s32 gNumStaticFloorLinks;
+extern u16 gStaticFloorLinksGeneration;
+
+#ifdef LOCAL_SPACE_OBJECT_COLLISION
+/**
+ * The size of the pool holding the model space surfaces of objects with OBJ_FLAG_LOCAL_SPACE_COLLISION, in bytes.
+ */
+#define LOCAL_COLLISION_POOL_SIZE 0x6000
+#define MAX_LOCAL_COLLISION_MODELS 32
+#define MAX_LOCAL_COLLISION_OBJECTS 32
+
+/**
+ * A collision model built in model space, scaled but not rotated or moved.
+ * Shared by every object that uses the same model at the same scale.
+ */
+struct LocalCollisionModel {
+    TerrainData *collisionData;
+    Vec3f scale;
+    SpatialPartitionCell lists; // The model's surfaces, sorted like the lists of a cell
+    f32 radius; // Lateral distance from the origin to the furthest vertex
+    s16 lowerY; // Vertical extent of the surfaces, relative to the origin
+    s16 upperY;
+};
+
+/**
+ * An object whose collision is queried in its own space this frame, instead of being loaded into the dynamic partition.
+ */
+struct LocalCollisionObject {
+    Mat4 transform; // The object's transform when it loaded its collision, without scale
+    struct Object *obj;
+    struct LocalCollisionModel *model;
+};
+
+extern struct LocalCollisionObject gLocalCollisionObjects[MAX_LOCAL_COLLISION_OBJECTS];
+extern s32 gNumLocalCollisionObjects;
+
+struct Surface *get_local_surface_copy(struct LocalCollisionObject *entry, struct Surface *surface);
+// Defined in math_util.c, next to find_surface_on_ray.
+void find_surface_on_ray_list(struct SurfaceNode *list, Vec3f orig, Vec3f dir, f32 dir_length, struct Surface **hit_surface, Vec3f hit_pos, f32 *max_length);
+#endif
+
 void alloc_surface_pools(void);
 #ifdef NO_SEGMENTED_MEMORY
 u32 get_area_terrain_size(TerrainData *data);
 #endif
-void load_area_terrain(s32 index, TerrainData *data, RoomData *surfaceRooms, MacroObject *macroObjects);
+void load_area_terrain(s32 index, TerrainData *data, RoomData *surfaceRooms, MacroObject *macroObjects, const struct BakedCollision *bakedData);
 void clear_dynamic_surfaces(void);
 void load_object_collision_model(void);
 void load_object_static_model(void);
+s32 get_static_floor_link(struct Surface *floor);
+struct SurfaceNode *get_static_surface_list(s32 cellX, s32 cellZ, s32 minX, s32 minZ, s32 maxX, s32 maxZ, s32 partition);
+struct SurfaceNode *get_static_surface_list_at_height(s32 cellX, s32 cellZ, s32 minX, s32 minZ, s32 maxX, s32 maxZ, s32 partition, s32 y);
 
 #endif // SURFACE_LOAD_H
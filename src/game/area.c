@@ -193,7 +193,9 @@ void clear_areas(void) {
         gAreaData[i].terrainType = TERRAIN_GRASS;
         gAreaData[i].graphNode = NULL;
         gAreaData[i].terrainData = NULL;
+        gAreaData[i].bakedTerrain = NULL;
         gAreaData[i].surfaceRooms = NULL;
+        gAreaData[i].roomVisibility = NULL;
         gAreaData[i].macroObjects = NULL;
         gAreaData[i].warpNodes = NULL;
         gAreaData[i].paintingWarpNodes = NULL;
@@ -233,6 +235,26 @@ void clear_area_graph_nodes(void) {
     }
 }
 
+#ifdef ROOM_VISIBILITY
+static const u32 *sRoomVisibilityMasks = NULL;
+
+/**
+ * Returns whether the current area's room visibility table marks room as visible from fromRoom.
+ * Areas without a table, and rooms outside of it, are always visible.
+ */
+s32 is_room_visible_from(s32 fromRoom, s32 room) {
+    const struct RoomVisibility *visibility = gCurrentArea->roomVisibility;
+
+    if (sRoomVisibilityMasks == NULL
+        || fromRoom <= 0 || fromRoom > visibility->numRooms
+        || room     <= 0 || room     > visibility->numRooms) {
+        return TRUE;
+    }
+
+    return (sRoomVisibilityMasks[fromRoom * visibility->wordsPerRoom + (room >> 5)] >> (room & 0x1F)) & 1;
+}
+#endif
+
 void load_area(s32 index) {
     if (gCurrentArea == NULL && gAreaData[index].graphNode != NULL) {
         gCurrentArea = &gAreaData[index];
@@ -242,9 +264,16 @@ void load_area(s32 index) {
 
         gMarioCurrentRoom = 0;
 
+#ifdef ROOM_VISIBILITY
+        sRoomVisibilityMasks = NULL;
+        if (gCurrentArea->roomVisibility != NULL) {
+            sRoomVisibilityMasks = segmented_to_virtual((void *) gCurrentArea->roomVisibility->masks);
+        }
+#endif
+
         if (gCurrentArea->terrainData != NULL) {
             load_area_terrain(index, gCurrentArea->terrainData, gCurrentArea->surfaceRooms,
-                              gCurrentArea->macroObjects);
+                              gCurrentArea->macroObjects, gCurrentArea->bakedTerrain);
         }
 
         if (gCurrentArea->objectSpawnInfos != NULL) {
@@ -263,6 +292,9 @@ void unload_area(void) {
 
         gCurrentArea->flags = AREA_FLAG_UNLOAD;
         gCurrentArea = NULL;
+#ifdef ROOM_VISIBILITY
+        sRoomVisibilityMasks = NULL;
+#endif
         gWarpTransition.isActive = FALSE;
     }
 }
@@ -75,8 +75,10 @@ struct Area {
     /*0x38*/ u16 musicParam2;
     /*0x3A*/ u8 useEchoOverride; // Should area echo be overridden using echoOverride?
     /*0x3B*/ s8 echoOverride; // Value used to override the area echo values defined in level_defines.h
+    /*0x3C*/ const struct BakedCollision *bakedTerrain; // prebaked static collision (set from level script cmd 0x40)
+    /*0x40*/ const struct RoomVisibility *roomVisibility; // rooms visible from each room (set from level script cmd 0x41)
 #ifdef BETTER_REVERB
-    /*0x3C*/ u8 betterReverbPreset;
+    /*0x44*/ u8 betterReverbPreset;
 #endif
 };
 
@@ -187,6 +189,9 @@ u32 get_mario_spawn_type(struct Object *obj);
 struct ObjectWarpNode *area_get_warp_node(u8 id);
 void clear_areas(void);
 void clear_area_graph_nodes(void);
+#ifdef ROOM_VISIBILITY
+s32 is_room_visible_from(s32 fromRoom, s32 room);
+#endif
 void load_area(s32 index);
 void unload_area(void);
 void load_mario_area(void);
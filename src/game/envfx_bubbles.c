@@ -21,6 +21,15 @@
  * sake of concise naming, flowers fall under bubbles.
  */
 
+#define ENVFX_FLOWER_PARTICLE_COUNT      30
+#define ENVFX_LAVA_BUBBLE_PARTICLE_COUNT 15
+
+/**
+ * The most particles that can look for a floor in the same frame, which is every flower or lava bubble respawning at once.
+ */
+#define ENVFX_MAX_FLOOR_QUERIES ((ENVFX_FLOWER_PARTICLE_COUNT > ENVFX_LAVA_BUBBLE_PARTICLE_COUNT) \
+                                     ? ENVFX_FLOWER_PARTICLE_COUNT : ENVFX_LAVA_BUBBLE_PARTICLE_COUNT)
+
 s16 gEnvFxBubbleConfig[10];
 static Gfx *sGfxCursor; // points to end of display list for bubble particles
 static s32 sBubbleParticleCount;
@@ -71,6 +80,9 @@ s32 random_flower_offset(void) {
 void envfx_update_flower(Vec3s centerPos) {
     s32 i;
     s32 globalTimer = gGlobalTimer;
+    struct FloorQuery queries[ENVFX_MAX_FLOOR_QUERIES];
+    s16 respawned[ENVFX_MAX_FLOOR_QUERIES];
+    s32 numQueries = 0;
 
     s16 centerX = centerPos[0];
     s16 centerZ = centerPos[2];
@@ -80,9 +92,14 @@ void envfx_update_flower(Vec3s centerPos) {
         if (!(gEnvFxBuffer + i)->isAlive) {
             (gEnvFxBuffer + i)->xPos = random_flower_offset() + centerX;
             (gEnvFxBuffer + i)->zPos = random_flower_offset() + centerZ;
-            (gEnvFxBuffer + i)->yPos = find_floor_height((gEnvFxBuffer + i)->xPos, 10000.0f, (gEnvFxBuffer + i)->zPos);
             (gEnvFxBuffer + i)->isAlive = TRUE;
             (gEnvFxBuffer + i)->animFrame = random_float() * 5.0f;
+
+            // The flowers that respawned look for their floor together below.
+            queries[numQueries].x = (gEnvFxBuffer + i)->xPos;
+            queries[numQueries].y = 10000;
+            queries[numQueries].z = (gEnvFxBuffer + i)->zPos;
+            respawned[numQueries++] = i;
         } else if (!(globalTimer & 3)) {
             (gEnvFxBuffer + i)->animFrame++;
             if ((gEnvFxBuffer + i)->animFrame > 5) {
@@ -90,21 +107,25 @@ void envfx_update_flower(Vec3s centerPos) {
             }
         }
     }
+
+    find_floors_batched(queries, numQueries);
+
+    for (i = 0; i < numQueries; i++) {
+        (gEnvFxBuffer + respawned[i])->yPos = queries[i].height;
+    }
 }
 
 /**
- * Update the position of a lava bubble to be somewhere around centerPos
- * Uses find_floor to find the height of lava, if no floor or a non-lava
+ * Update the position of a lava bubble to be somewhere around centerPos,
+ * and set up the query for the floor under it.
+ * The floor is used to find the height of lava, if no floor or a non-lava
  * floor is found the bubble y is set to -10000, which is why you can see
  * occasional lava bubbles far below the course in Lethal Lava Land.
  * In the second Bowser fight arena, the visual lava is above the lava
  * floor so lava-bubbles are not normally visible, only if you bring the
  * camera below the lava plane.
  */
-void envfx_set_lava_bubble_position(s32 index, Vec3s centerPos) {
-    struct Surface *surface;
-    s16 floorY;
-
+void envfx_set_lava_bubble_position(s32 index, Vec3s centerPos, struct FloorQuery *query) {
     s16 centerX = centerPos[0];
     s16 centerY = centerPos[1];
     s16 centerZ = centerPos[2];
@@ -126,15 +147,17 @@ void envfx_set_lava_bubble_position(s32 index, Vec3s centerPos) {
         (gEnvFxBuffer + index)->zPos = -16000 - (gEnvFxBuffer + index)->zPos;
     }
 
-    floorY =
-        find_floor((gEnvFxBuffer + index)->xPos, centerY + 500, (gEnvFxBuffer + index)->zPos, &surface);
-    if (surface == NULL) {
-        (gEnvFxBuffer + index)->yPos = FLOOR_LOWER_LIMIT_MISC;
-        return;
-    }
+    query->x = (gEnvFxBuffer + index)->xPos;
+    query->y = centerY + 500;
+    query->z = (gEnvFxBuffer + index)->zPos;
+}
 
-    if (surface->type == SURFACE_BURNING) {
-        (gEnvFxBuffer + index)->yPos = floorY;
+/**
+ * Set the height of a lava bubble from the floor that was found under it.
+ */
+void envfx_set_lava_bubble_height(s32 index, struct FloorQuery *query) {
+    if (query->floor != NULL && query->floor->type == SURFACE_BURNING) {
+        (gEnvFxBuffer + index)->yPos = (s16) query->height;
     } else {
         (gEnvFxBuffer + index)->yPos = FLOOR_LOWER_LIMIT_MISC;
     }
@@ -147,10 +170,14 @@ void envfx_set_lava_bubble_position(s32 index, Vec3s centerPos) {
 void envfx_update_lava(Vec3s centerPos) {
     s32 i;
     s32 globalTimer = gGlobalTimer;
+    struct FloorQuery queries[ENVFX_MAX_FLOOR_QUERIES];
+    s16 respawned[ENVFX_MAX_FLOOR_QUERIES];
+    s32 numQueries = 0;
 
     for (i = 0; i < sBubbleParticleMaxCount; i++) {
         if (!(gEnvFxBuffer + i)->isAlive) {
-            envfx_set_lava_bubble_position(i, centerPos);
+            envfx_set_lava_bubble_position(i, centerPos, &queries[numQueries]);
+            respawned[numQueries++] = i;
             (gEnvFxBuffer + i)->isAlive = TRUE;
         } else if (!(globalTimer & 1)) {
             (gEnvFxBuffer + i)->animFrame += 1;
@@ -161,6 +188,13 @@ void envfx_update_lava(Vec3s centerPos) {
         }
     }
 
+    // The bubbles that respawned look for their floor together.
+    find_floors_batched(queries, numQueries);
+
+    for (i = 0; i < numQueries; i++) {
+        envfx_set_lava_bubble_height(respawned[i], &queries[i]);
+    }
+
     if (((s8)(s32)(random_float() * 16.0f)) == 8) {
         play_sound(SOUND_GENERAL_QUIET_BUBBLE2, gGlobalSoundSource);
     }
@@ -305,13 +339,13 @@ s32 envfx_init_bubble(s32 mode) {
             return FALSE;
 
         case ENVFX_FLOWERS:
-            sBubbleParticleCount = 30;
-            sBubbleParticleMaxCount = 30;
+            sBubbleParticleCount = ENVFX_FLOWER_PARTICLE_COUNT;
+            sBubbleParticleMaxCount = ENVFX_FLOWER_PARTICLE_COUNT;
             break;
 
         case ENVFX_LAVA_BUBBLES:
-            sBubbleParticleCount = 15;
-            sBubbleParticleMaxCount = 15;
+            sBubbleParticleCount = ENVFX_LAVA_BUBBLE_PARTICLE_COUNT;
+            sBubbleParticleMaxCount = ENVFX_LAVA_BUBBLE_PARTICLE_COUNT;
             break;
 
         case ENVFX_WHIRLPOOL_BUBBLES:
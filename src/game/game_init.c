@@ -31,6 +31,8 @@
 #include "vc_ultra.h"
 #include "profiling.h"
 #include "emutest.h"
+#include "input_replay.h"
+#include "profiler_export.h"
 
 // Emulators that the Instant Input patch should not be applied to
 #define INSTANT_INPUT_BLACKLIST (EMU_CONSOLE | EMU_WIIVC | EMU_ARES | EMU_SIMPLE64 | EMU_CEN64)
@@ -629,6 +631,12 @@ void read_controller_inputs(s32 threadID) {
                 }
                 controllerData->button = newButton;
             }
+#if defined(ENABLE_INPUT_RECORDING) || defined(ENABLE_INPUT_REPLAY_BENCHMARK)
+            // Record or replay player 1's inputs as the game sees them, before the deadzone is applied.
+            if (threadID == THREAD_5_GAME_LOOP && cont == 0) {
+                input_replay_update(controllerData);
+            }
+#endif
             controller->rawStickX = controllerData->stick_x;
             controller->rawStickY = controllerData->stick_y;
             controller->buttonPressed  = (~controller->buttonDown & controllerData->button);
@@ -789,8 +797,14 @@ void thread5_game_loop(UNUSED void *arg) {
     gConfig.widescreen = save_file_get_widescreen_mode();
 #endif
     render_init();
+#if defined(ENABLE_INPUT_RECORDING) || defined(ENABLE_INPUT_REPLAY_BENCHMARK)
+    input_replay_init();
+#endif
 
     while (TRUE) {
+#ifdef PROFILER_EXPORT
+        profiler_export_frame();
+#endif
         profiler_frame_setup();
         // If the reset timer is active, run the process to reset the game.
         if (gResetTimer != 0) {
@@ -0,0 +1,220 @@
+#include <ultra64.h>
+
+#include "sm64.h"
+#include "level_table.h"
+#include "engine/math_util.h"
+#include "input_replay.h"
+#include "profiling.h"
+
+#if defined(ENABLE_INPUT_RECORDING) || defined(ENABLE_INPUT_REPLAY_BENCHMARK)
+
+#if !defined(ISVPRINT) && !defined(UNF)
+#error "Input recording and replay print their results over ISV/UNF, build with ISVPRINT=1 or UNF=1."
+#endif
+
+#ifdef TEST_LEVEL
+#define INPUT_REPLAY_BOOT_LEVEL TEST_LEVEL
+#else
+#define INPUT_REPLAY_BOOT_LEVEL LEVEL_NONE
+#endif
+
+#define INPUT_REPLAY_STRING_(x) #x
+#define INPUT_REPLAY_STRING(x) INPUT_REPLAY_STRING_(x)
+
+#ifdef ENABLE_INPUT_RECORDING
+
+// Holding these stops the recording and prints it.
+#define INPUT_RECORDING_STOP_BUTTONS (L_TRIG | R_TRIG | Z_TRIG)
+// Recordings are stored as runs of identical inputs, so this is how many times the input can change.
+#define INPUT_RECORDING_MAX_INPUTS 0x2000
+// Inputs printed per line of the recording.
+#define INPUT_RECORDING_INPUTS_PER_LINE 4
+
+static struct ReplayInput sRecordedInputs[INPUT_RECORDING_MAX_INPUTS];
+static s32 sNumRecordedInputs = 0;
+static s32 sRecordingDone = FALSE;
+
+/**
+ * Prints the recording as the contents of src/game/input_replay/recording.inc.c.
+ */
+static void input_recording_print(void) {
+    char line[INPUT_RECORDING_INPUTS_PER_LINE * 32];
+    char *linePos;
+    s32 i, j;
+
+    osSyncPrintf("// input_replay/recording.inc.c begin\n");
+    osSyncPrintf("// Inputs replayed by ENABLE_INPUT_REPLAY_BENCHMARK, recorded over %d input changes.\n", sNumRecordedInputs);
+    osSyncPrintf("#define INPUT_REPLAY_LEVEL %s\n", INPUT_REPLAY_STRING(INPUT_REPLAY_BOOT_LEVEL));
+    osSyncPrintf("#define INPUT_REPLAY_SEED 0x%04X\n", INPUT_RECORDING_SEED);
+    osSyncPrintf("static const struct ReplayInput sReplayInputs[] = {\n");
+
+    for (i = 0; i < sNumRecordedInputs; i += INPUT_RECORDING_INPUTS_PER_LINE) {
+        linePos = line;
+        for (j = i; j < MIN(i + INPUT_RECORDING_INPUTS_PER_LINE, sNumRecordedInputs); j++) {
+            struct ReplayInput *input = &sRecordedInputs[j];
+            linePos += sprintf(linePos, " { %5d, 0x%04X, %4d, %4d },", input->frames, input->button, input->stickX, input->stickY);
+        }
+        osSyncPrintf("   %s\n", line);
+    }
+
+    osSyncPrintf("    { 0 },\n");
+    osSyncPrintf("};\n");
+    osSyncPrintf("// input_replay/recording.inc.c end\n");
+}
+
+/**
+ * Records player 1's inputs for this frame, extending the last run of inputs if nothing changed.
+ */
+static void input_recording_update(OSContPadEx *pad) {
+    struct ReplayInput *input = (sNumRecordedInputs > 0) ? &sRecordedInputs[sNumRecordedInputs - 1] : NULL;
+
+    if (sRecordingDone) {
+        return;
+    }
+
+    if (input != NULL && input->frames < 0xFFFF && input->button == pad->button
+        && input->stickX == pad->stick_x && input->stickY == pad->stick_y) {
+        input->frames++;
+    } else if (sNumRecordedInputs < INPUT_RECORDING_MAX_INPUTS) {
+        input = &sRecordedInputs[sNumRecordedInputs++];
+        input->frames = 1;
+        input->button = pad->button;
+        input->stickX = pad->stick_x;
+        input->stickY = pad->stick_y;
+    } else {
+        osSyncPrintf("Input recording is full, stopping it.\n");
+        sRecordingDone = TRUE;
+    }
+
+    if ((pad->button & INPUT_RECORDING_STOP_BUTTONS) == INPUT_RECORDING_STOP_BUTTONS) {
+        sRecordingDone = TRUE;
+    }
+
+    if (sRecordingDone) {
+        input_recording_print();
+    }
+}
+
+#else // ENABLE_INPUT_REPLAY_BENCHMARK
+
+#include "input_replay/recording.inc.c"
+
+STATIC_ASSERT(INPUT_REPLAY_LEVEL == INPUT_REPLAY_BOOT_LEVEL, "The input recording was made with a different TEST_LEVEL!");
+
+// How many frames of profiler times are kept, later frames are replayed without being measured.
+#define INPUT_REPLAY_MAX_FRAMES 0x2000
+
+enum ReplayFrameTime {
+    REPLAY_FRAME_TIME_CPU,
+    REPLAY_FRAME_TIME_RSP,
+    REPLAY_FRAME_TIME_RDP,
+    REPLAY_FRAME_TIME_COUNT
+};
+
+// Microseconds spent on each frame, saturated to fit.
+static u16 sReplayFrameTimes[INPUT_REPLAY_MAX_FRAMES][REPLAY_FRAME_TIME_COUNT];
+static const struct ReplayInput *sCurrReplayInput = sReplayInputs;
+static u16 sReplayInputFrame = 0;
+static s32 sReplayFrame = 0;
+static s32 sReplayDone = FALSE;
+
+/**
+ * Prints the time every replayed frame took as CSV, followed by the averages.
+ */
+static void input_replay_print(void) {
+    s32 numFrames = MIN(sReplayFrame, INPUT_REPLAY_MAX_FRAMES);
+    u32 totals[REPLAY_FRAME_TIME_COUNT] = { 0 };
+    s32 i, j;
+
+    osSyncPrintf("# input replay benchmark begin\n");
+    osSyncPrintf("frame,cpu_us,rsp_us,rdp_us\n");
+    for (i = 0; i < numFrames; i++) {
+        u16 *times = sReplayFrameTimes[i];
+        osSyncPrintf("%d,%d,%d,%d\n", i, times[REPLAY_FRAME_TIME_CPU], times[REPLAY_FRAME_TIME_RSP], times[REPLAY_FRAME_TIME_RDP]);
+        for (j = 0; j < REPLAY_FRAME_TIME_COUNT; j++) {
+            totals[j] += times[j];
+        }
+    }
+
+    if (numFrames > 0) {
+        osSyncPrintf("# %d of %d frames, average cpu_us %d, rsp_us %d, rdp_us %d\n", numFrames, sReplayFrame,
+                     totals[REPLAY_FRAME_TIME_CPU] / numFrames, totals[REPLAY_FRAME_TIME_RSP] / numFrames,
+                     totals[REPLAY_FRAME_TIME_RDP] / numFrames);
+    }
+    osSyncPrintf("# input replay benchmark end\n");
+}
+
+/**
+ * Stores the profiler times of the frame before the current one.
+ */
+static void input_replay_measure_frame(s32 frame) {
+    u32 times[REPLAY_FRAME_TIME_COUNT];
+    s32 i;
+
+    if (frame < 0 || frame >= INPUT_REPLAY_MAX_FRAMES) {
+        return;
+    }
+
+    profiler_get_last_frame_microseconds(&times[REPLAY_FRAME_TIME_CPU], &times[REPLAY_FRAME_TIME_RSP], &times[REPLAY_FRAME_TIME_RDP]);
+    for (i = 0; i < REPLAY_FRAME_TIME_COUNT; i++) {
+        sReplayFrameTimes[frame][i] = MIN(times[i], 0xFFFF);
+    }
+}
+
+/**
+ * Overrides player 1's inputs for this frame with the recording, and prints the results once it's over.
+ */
+static void input_replay_benchmark_update(OSContPadEx *pad) {
+    pad->button = 0;
+    pad->stick_x = 0;
+    pad->stick_y = 0;
+
+    if (sReplayDone) {
+        return;
+    }
+
+    // The last frame's times are only complete once the next frame has started.
+    input_replay_measure_frame(sReplayFrame - 1);
+
+    if (sCurrReplayInput->frames == 0) {
+        input_replay_print();
+        sReplayDone = TRUE;
+        return;
+    }
+
+    pad->button = sCurrReplayInput->button;
+    pad->stick_x = sCurrReplayInput->stickX;
+    pad->stick_y = sCurrReplayInput->stickY;
+    sReplayFrame++;
+
+    if (++sReplayInputFrame >= sCurrReplayInput->frames) {
+        sReplayInputFrame = 0;
+        sCurrReplayInput++;
+    }
+}
+
+#endif
+
+/**
+ * Starts the recording or replay from its random seed. Has to be called before the first frame.
+ */
+void input_replay_init(void) {
+#ifdef ENABLE_INPUT_RECORDING
+    random_set_seed(INPUT_RECORDING_SEED);
+#else
+    random_set_seed(INPUT_REPLAY_SEED);
+#endif
+}
+
+/**
+ * Records or replays player 1's inputs, called once per game frame after the controllers are read.
+ */
+void input_replay_update(OSContPadEx *pad) {
+#ifdef ENABLE_INPUT_RECORDING
+    input_recording_update(pad);
+#else
+    input_replay_benchmark_update(pad);
+#endif
+}
+
+#endif
@@ -0,0 +1,21 @@
+#ifndef INPUT_REPLAY_H
+#define INPUT_REPLAY_H
+
+#include <PR/ultratypes.h>
+#include <PR/os_cont.h>
+
+#include "config.h"
+
+struct ReplayInput {
+    u16 frames; // how many frames this input is held for. if this value is 0, the recording is over
+    u16 button;
+    s8 stickX;
+    s8 stickY;
+};
+
+#if defined(ENABLE_INPUT_RECORDING) || defined(ENABLE_INPUT_REPLAY_BENCHMARK)
+void input_replay_init(void);
+void input_replay_update(OSContPadEx *pad);
+#endif
+
+#endif // INPUT_REPLAY_H
@@ -0,0 +1,7 @@
+// Inputs replayed by ENABLE_INPUT_REPLAY_BENCHMARK.
+// Replace this file with the output of an ENABLE_INPUT_RECORDING build.
+#define INPUT_REPLAY_LEVEL LEVEL_NONE
+#define INPUT_REPLAY_SEED 0x0000
+static const struct ReplayInput sReplayInputs[] = {
+    { 0 },
+};
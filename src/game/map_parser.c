@@ -6,15 +6,25 @@
 
 #define STACK_TRAVERSAL_LIMIT 100
 
+// Symbols are grouped into buckets of this many address bits by tools/mapPacker.py.
+#define MAP_BUCKET_SHIFT 12
+
 struct MapEntry {
 	u32 addr;
 	u32 nm_offset;
-	u32 nm_len;
-	u32 pad;
 };
+
+// For each bucket, the index of the first symbol at or above its address, with one extra past the last bucket.
+struct MapBucketIndex {
+	u32 base;
+	u32 numBuckets;
+	u16 firstEntry[];
+};
+
 extern u8 gMapStrings[];
 extern struct MapEntry gMapEntries[];
 extern u32 gMapEntrySize;
+extern struct MapBucketIndex gMapBuckets;
 extern u8 _mapDataSegmentRomStart[];
 
 
@@ -41,18 +51,36 @@ void map_data_init(void) {
 	while (headless_pi_status() & (PI_STATUS_DMA_BUSY | PI_STATUS_ERROR));
 }
 
+/**
+ * Returns the name of the function containing pc, which is the last symbol at or below it.
+ * The bucket index narrows the search down to the symbols that start in the same bucket as pc.
+ */
 char *parse_map(u32 pc) {
-	u32 i;
+	if (pc < gMapBuckets.base) {
+		return NULL;
+	}
 
-	for (i = 0; i < gMapEntrySize; i++) {
-		if (gMapEntries[i].addr >= pc) break;
+	u32 bucket = ((pc - gMapBuckets.base) >> MAP_BUCKET_SHIFT);
+	if (bucket >= gMapBuckets.numBuckets) {
+		return NULL;
+	}
+
+	// Binary search for the first symbol above pc.
+	u32 lo = gMapBuckets.firstEntry[bucket];
+	u32 hi = gMapBuckets.firstEntry[bucket + 1];
+	while (lo < hi) {
+		u32 mid = ((lo + hi) / 2);
+		if (gMapEntries[mid].addr <= pc) {
+			lo = (mid + 1);
+		} else {
+			hi = mid;
+		}
 	}
 
-	if (i == gMapEntrySize - 1) {
+	if (lo == 0) {
 		return NULL;
-	} else {
-		return (char*) ((u32)gMapStrings + gMapEntries[i - 1].nm_offset);
 	}
+	return (char*) ((u32)gMapStrings + gMapEntries[lo - 1].nm_offset);
 }
 
 extern u8 _mainSegmentStart[];
@@ -32,6 +32,7 @@
 #include "save_file.h"
 #include "sound_init.h"
 #include "rumble_init.h"
+#include "profiling.h"
 
 
 /**************************************************
@@ -1273,7 +1274,7 @@ void update_mario_geometry_inputs(struct MarioState *m) {
     f32_find_wall_collision(&m->pos[0], &m->pos[1], &m->pos[2], 60.0f, 50.0f);
     f32_find_wall_collision(&m->pos[0], &m->pos[1], &m->pos[2], 30.0f, 24.0f);
 
-    m->floorHeight = find_floor(m->pos[0], m->pos[1], m->pos[2], &m->floor);
+    m->floorHeight = find_floor_cached(&m->floorCache, m->pos[0], m->pos[1], m->pos[2], &m->floor);
 
     // If Mario is OOB, move his position to his graphical position (which was not updated)
     // and check for the floor there.
@@ -1281,7 +1282,7 @@ void update_mario_geometry_inputs(struct MarioState *m) {
     // since the graphical position was not Mario's previous location.
     if (m->floor == NULL) {
         vec3f_copy(m->pos, m->marioObj->header.gfx.pos);
-        m->floorHeight = find_floor(m->pos[0], m->pos[1], m->pos[2], &m->floor);
+        m->floorHeight = find_floor_cached(&m->floorCache, m->pos[0], m->pos[1], m->pos[2], &m->floor);
     }
 
     m->ceilHeight = find_mario_ceil(m->pos, m->floorHeight, &m->ceil);
@@ -1703,6 +1704,7 @@ void queue_rumble_particles(struct MarioState *m) {
  * Main function for executing Mario's behavior. Returns particleFlags.
  */
 s32 execute_mario_action(UNUSED struct Object *obj) {
+    PROFILER_ZONE("execute_mario_action");
     s32 inLoop = TRUE;
 
     // Updates once per frame:
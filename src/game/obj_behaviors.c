@@ -378,7 +378,7 @@ s16 object_step(void) {
         collisionFlags += OBJ_COL_FLAG_HIT_WALL;
     }
 
-    floorY = find_floor(objX + objVelX, objY, objZ + objVelZ, &sObjFloor);
+    floorY = find_floor_cached(&o->floorCache, objX + objVelX, objY, objZ + objVelZ, &sObjFloor);
 
     o->oFloor       = sObjFloor;
     o->oFloorHeight = floorY;
@@ -7,6 +7,9 @@
 #include "object_list_processor.h"
 #include "spawn_object.h"
 #include "engine/math_util.h"
+#include "config/config_world.h"
+#include "puppyprint.h"
+#include "profiling.h"
 
 UNUSED struct Object *debug_print_obj_collision(struct Object *a) {
     struct Object *currCollidedObj;
@@ -22,6 +25,300 @@ UNUSED struct Object *debug_print_obj_collision(struct Object *a) {
     return NULL;
 }
 
+#ifdef OBJECT_COLLISION_BROADPHASE
+
+/**
+ * With the broadphase, collision detection works on a compact copy of the fields that the first overlap test reads from
+ * every tangible collidable object, rebuilt at the start of each frame's detection. The fields are stored as separate arrays, and
+ * objects are numbered in list order, with each collidable list occupying a contiguous range of numbers. Intangible
+ * objects are left out, since they never take part in a pair, so testing one object against a list only visits the
+ * objects it can collide with and reads each array sequentially instead of striding across whole objects. Everything
+ * else is read from the objects themselves, which are only touched when a pair's hitbox cylinders actually overlap.
+ * Nothing moves or changes its tangibility during collision detection, so the copy stays in sync until the next frame.
+ * Without the broadphase, every object is tested against the whole of each list, which reads each object once either
+ * way, so the lists are walked directly instead of paying for the copy.
+ */
+struct ObjectHotTable {
+    struct Object *obj[OBJECT_POOL_CAPACITY];
+    f32 posX[OBJECT_POOL_CAPACITY];
+    f32 posZ[OBJECT_POOL_CAPACITY];
+    f32 bottom[OBJECT_POOL_CAPACITY]; // oPosY - hitboxDownOffset
+    f32 hitboxRadius[OBJECT_POOL_CAPACITY];
+    f32 hitboxHeight[OBJECT_POOL_CAPACITY];
+};
+
+static struct ObjectHotTable sHot;
+static u16 sHotListStart[NUM_OBJ_LISTS];
+static u16 sHotListEnd[NUM_OBJ_LISTS];
+
+// Every list that takes part in object collision.
+static const u8 sCollisionLists[] = {
+    OBJ_LIST_PLAYER,
+    OBJ_LIST_DESTRUCTIVE,
+    OBJ_LIST_GENACTOR,
+    OBJ_LIST_PUSHABLE,
+    OBJ_LIST_LEVEL,
+    OBJ_LIST_SURFACE,
+    OBJ_LIST_POLELIKE,
+};
+
+static s32 detect_object_hitbox_overlap(s32 a, s32 b) {
+    f32 dya_bottom = sHot.bottom[a];
+    f32 dyb_bottom = sHot.bottom[b];
+    f32 dx = sHot.posX[a] - sHot.posX[b];
+    f32 dz = sHot.posZ[a] - sHot.posZ[b];
+    f32 collisionRadius = sHot.hitboxRadius[a] + sHot.hitboxRadius[b];
+    f32 distance = sqr(dx) + sqr(dz);
+
+    if (sqr(collisionRadius) > distance) {
+        f32 dya_top = sHot.hitboxHeight[a] + dya_bottom;
+        f32 dyb_top = sHot.hitboxHeight[b] + dyb_bottom;
+        struct Object *objA = sHot.obj[a];
+        struct Object *objB = sHot.obj[b];
+
+        if (dya_bottom > dyb_top
+            || dya_top < dyb_bottom
+            || objA->numCollidedObjs >= 4
+            || objB->numCollidedObjs >= 4) {
+            return FALSE;
+        }
+        objA->collidedObjs[objA->numCollidedObjs] = objB;
+        objB->collidedObjs[objB->numCollidedObjs] = objA;
+        objA->collidedObjInteractTypes |= objB->oInteractType;
+        objB->collidedObjInteractTypes |= objA->oInteractType;
+        objA->numCollidedObjs++;
+        objB->numCollidedObjs++;
+        return TRUE;
+    }
+
+    return FALSE;
+}
+
+static s32 detect_object_hurtbox_overlap(s32 a, s32 b) {
+    struct Object *objA = sHot.obj[a];
+    struct Object *objB = sHot.obj[b];
+    f32 dya_bottom = sHot.bottom[a];
+    f32 dyb_bottom = sHot.bottom[b];
+    f32 dx = sHot.posX[a] - sHot.posX[b];
+    f32 dz = sHot.posZ[a] - sHot.posZ[b];
+    f32 collisionRadius = objA->hurtboxRadius + objB->hurtboxRadius;
+    f32 distance = sqr(dx) + sqr(dz);
+    s32 isMario = (objA == gMarioObject);
+
+    if (isMario) {
+        objB->oInteractionSubtype |= INT_SUBTYPE_DELAY_INVINCIBILITY;
+    }
+
+    if (sqr(collisionRadius) > distance) {
+        f32 dya_top = sHot.hitboxHeight[a] + dya_bottom;
+        f32 dyb_top = objB->hurtboxHeight  + dyb_bottom;
+
+        if (dya_bottom > dyb_top || dya_top < dyb_bottom) {
+            return FALSE;
+        }
+        if (isMario) {
+            objB->oInteractionSubtype &= ~INT_SUBTYPE_DELAY_INVINCIBILITY;
+        }
+        return TRUE;
+    }
+
+    return FALSE;
+}
+
+/**
+ * Copies the hot fields of a tangible object into the table.
+ */
+static void hot_table_add_object(struct Object *obj, s32 index) {
+    sHot.obj[index] = obj;
+    sHot.posX[index] = obj->oPosX;
+    sHot.posZ[index] = obj->oPosZ;
+    sHot.bottom[index] = obj->oPosY - obj->hitboxDownOffset;
+    sHot.hitboxRadius[index] = obj->hitboxRadius;
+    sHot.hitboxHeight[index] = obj->hitboxHeight;
+}
+
+/**
+ * Clears the collision state of every collidable object, fills the table from the tangible ones
+ * and returns the number of objects in it.
+ */
+static s32 hot_table_build(void) {
+    s32 index = 0;
+
+    for (u32 i = 0; i < ARRAY_COUNT(sCollisionLists); i++) {
+        struct Object *listHead = (struct Object *) &gObjectLists[sCollisionLists[i]];
+        struct Object *obj = (struct Object *) listHead->header.next;
+
+        sHotListStart[sCollisionLists[i]] = index;
+        while (obj != listHead) {
+            obj->numCollidedObjs = 0;
+            obj->collidedObjInteractTypes = 0;
+            if (obj->oIntangibleTimer > 0) {
+                obj->oIntangibleTimer--;
+            }
+            if (obj->oIntangibleTimer == 0) {
+                hot_table_add_object(obj, index++);
+            }
+            obj = (struct Object *) obj->header.next;
+        }
+        sHotListEnd[sCollisionLists[i]] = index;
+    }
+
+    return index;
+}
+
+static void check_collision_pair(s32 a, s32 b) {
+    PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.object_pairs_tested);
+    if (detect_object_hitbox_overlap(a, b)) {
+        PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.object_pairs_hit);
+        if (sHot.obj[b]->hurtboxRadius != 0.0f) {
+            detect_object_hurtbox_overlap(a, b);
+        }
+    }
+}
+
+/**
+ * The broadphase projects every hitbox onto the X and Z axes, which are each split into
+ * OBJECT_COLLISION_BROADPHASE_SLICES slices. Each slice holds a bitmask of the objects overlapping it,
+ * using their numbers in the hot table. Walking the set bits of a candidate mask in ascending order
+ * visits objects in list order, which keeps the filling of collidedObjs identical to vanilla.
+ */
+#define BROADPHASE_SLICE_SIZE (2 * LEVEL_BOUNDARY_MAX / OBJECT_COLLISION_BROADPHASE_SLICES)
+#define BROADPHASE_MASK_WORDS ((OBJECT_POOL_CAPACITY + 31) / 32)
+
+typedef u32 BroadphaseMask[BROADPHASE_MASK_WORDS];
+
+// Indexed by mask word, then slice, so that the words in use are contiguous and neighboring slices are read together.
+static u32 sBroadphaseSlicesX[BROADPHASE_MASK_WORDS][OBJECT_COLLISION_BROADPHASE_SLICES];
+static u32 sBroadphaseSlicesZ[BROADPHASE_MASK_WORDS][OBJECT_COLLISION_BROADPHASE_SLICES];
+
+static s32 get_broadphase_slice(f32 pos) {
+    s32 slice = ((s32) pos + LEVEL_BOUNDARY_MAX) / BROADPHASE_SLICE_SIZE;
+
+    return CLAMP(slice, 0, (OBJECT_COLLISION_BROADPHASE_SLICES - 1));
+}
+
+static void broadphase_build(s32 count) {
+    s32 numWords = ((count + 31) >> 5);
+
+    // Only the words that hold the objects in the table are ever read.
+    bzero(sBroadphaseSlicesX, numWords * sizeof(sBroadphaseSlicesX[0]));
+    bzero(sBroadphaseSlicesZ, numWords * sizeof(sBroadphaseSlicesZ[0]));
+
+    for (s32 index = 0; index < count; index++) {
+        f32 radius = ABS(sHot.hitboxRadius[index]);
+        s32 minX = get_broadphase_slice(sHot.posX[index] - radius);
+        s32 maxX = get_broadphase_slice(sHot.posX[index] + radius);
+        s32 minZ = get_broadphase_slice(sHot.posZ[index] - radius);
+        s32 maxZ = get_broadphase_slice(sHot.posZ[index] + radius);
+        s32 word = (index >> 5);
+        u32 bit = (1 << (index & 31));
+        s32 i;
+
+        for (i = minX; i <= maxX; i++) {
+            sBroadphaseSlicesX[word][i] |= bit;
+        }
+        for (i = minZ; i <= maxZ; i++) {
+            sBroadphaseSlicesZ[word][i] |= bit;
+        }
+    }
+}
+
+/**
+ * Same as the vanilla list walk, but only runs the narrowphase on objects that share
+ * an X slice and a Z slice with a. Checks a against the objects numbered first to last - 1.
+ */
+static void check_collision_in_range(s32 a, s32 first, s32 last) {
+    BroadphaseMask candidates;
+    f32 radius;
+    s32 minX, maxX, minZ, maxZ;
+    s32 i, word;
+
+    if (first >= last) {
+        return;
+    }
+
+    radius = ABS(sHot.hitboxRadius[a]);
+    minX = get_broadphase_slice(sHot.posX[a] - radius);
+    maxX = get_broadphase_slice(sHot.posX[a] + radius);
+    minZ = get_broadphase_slice(sHot.posZ[a] - radius);
+    maxZ = get_broadphase_slice(sHot.posZ[a] + radius);
+
+    for (word = (first >> 5); word <= ((last - 1) >> 5); word++) {
+        u32 maskX = 0;
+        u32 maskZ = 0;
+
+        for (i = minX; i <= maxX; i++) {
+            maskX |= sBroadphaseSlicesX[word][i];
+        }
+        for (i = minZ; i <= maxZ; i++) {
+            maskZ |= sBroadphaseSlicesZ[word][i];
+        }
+        candidates[word] = (maskX & maskZ);
+    }
+
+    // Strip out everything before first and from last onwards.
+    candidates[first >> 5] &= ~((1U << (first & 31)) - 1);
+    if (last & 31) {
+        candidates[(last - 1) >> 5] &= ((1U << (last & 31)) - 1);
+    }
+
+    for (word = (first >> 5); word <= ((last - 1) >> 5); word++) {
+        u32 bits = candidates[word];
+        s32 b = (word << 5);
+
+        while (bits != 0) {
+            if (bits & 1) {
+                check_collision_pair(a, b);
+            }
+            bits >>= 1;
+            b++;
+        }
+    }
+}
+
+static void check_collision_in_list(s32 a, s32 list) {
+    check_collision_in_range(a, sHotListStart[list], sHotListEnd[list]);
+}
+
+void check_player_object_collision(void) {
+    s32 end = sHotListEnd[OBJ_LIST_PLAYER];
+
+    for (s32 a = sHotListStart[OBJ_LIST_PLAYER]; a < end; a++) {
+        check_collision_in_range(a, a + 1, end);
+        check_collision_in_list(a, OBJ_LIST_POLELIKE);
+        check_collision_in_list(a, OBJ_LIST_LEVEL);
+        check_collision_in_list(a, OBJ_LIST_GENACTOR);
+        check_collision_in_list(a, OBJ_LIST_PUSHABLE);
+        check_collision_in_list(a, OBJ_LIST_SURFACE);
+        check_collision_in_list(a, OBJ_LIST_DESTRUCTIVE);
+    }
+}
+
+void check_pushable_object_collision(void) {
+    s32 end = sHotListEnd[OBJ_LIST_PUSHABLE];
+
+    for (s32 a = sHotListStart[OBJ_LIST_PUSHABLE]; a < end; a++) {
+        check_collision_in_range(a, a + 1, end);
+    }
+}
+
+void check_destructive_object_collision(void) {
+    s32 end = sHotListEnd[OBJ_LIST_DESTRUCTIVE];
+
+    for (s32 a = sHotListStart[OBJ_LIST_DESTRUCTIVE]; a < end; a++) {
+        struct Object *obj = sHot.obj[a];
+
+        if (!(obj->activeFlags & ACTIVE_FLAG_DESTRUCTIVE_OBJ_DONT_DESTROY) && obj->oDistanceToMario < 2000.0f) {
+            check_collision_in_range(a, a + 1, end);
+            check_collision_in_list(a, OBJ_LIST_GENACTOR);
+            check_collision_in_list(a, OBJ_LIST_PUSHABLE);
+            check_collision_in_list(a, OBJ_LIST_SURFACE);
+        }
+    }
+}
+
+#else
+
 s32 detect_object_hitbox_overlap(struct Object *a, struct Object *b) {
     f32 dya_bottom = a->oPosY - a->hitboxDownOffset;
     f32 dyb_bottom = b->oPosY - b->hitboxDownOffset;
@@ -93,14 +390,22 @@ void clear_object_collision(struct Object *a) {
     }
 }
 
+static void check_collision_pair(struct Object *a, struct Object *b) {
+    if (b->oIntangibleTimer == 0) {
+        PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.object_pairs_tested);
+        if (detect_object_hitbox_overlap(a, b)) {
+            PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.object_pairs_hit);
+            if (b->hurtboxRadius != 0.0f) {
+                detect_object_hurtbox_overlap(a, b);
+            }
+        }
+    }
+}
+
 void check_collision_in_list(struct Object *a, struct Object *b, struct Object *c) {
     if (a->oIntangibleTimer == 0) {
         while (b != c) {
-            if (b->oIntangibleTimer == 0) {
-                if (detect_object_hitbox_overlap(a, b) && b->hurtboxRadius != 0.0f) {
-                    detect_object_hurtbox_overlap(a, b);
-                }
-            }
+            check_collision_pair(a, b);
             b = (struct Object *) b->header.next;
         }
     }
@@ -162,7 +467,14 @@ void check_destructive_object_collision(void) {
     }
 }
 
+#endif
+
 void detect_object_collisions(void) {
+    PUPPYPRINT_GET_SNAPSHOT();
+
+#ifdef OBJECT_COLLISION_BROADPHASE
+    broadphase_build(hot_table_build());
+#else
     clear_object_collision((struct Object *) &gObjectLists[OBJ_LIST_POLELIKE]);
     clear_object_collision((struct Object *) &gObjectLists[OBJ_LIST_PLAYER]);
     clear_object_collision((struct Object *) &gObjectLists[OBJ_LIST_PUSHABLE]);
@@ -170,7 +482,9 @@ void detect_object_collisions(void) {
     clear_object_collision((struct Object *) &gObjectLists[OBJ_LIST_LEVEL]);
     clear_object_collision((struct Object *) &gObjectLists[OBJ_LIST_SURFACE]);
     clear_object_collision((struct Object *) &gObjectLists[OBJ_LIST_DESTRUCTIVE]);
+#endif
     check_player_object_collision();
     check_destructive_object_collision();
     check_pushable_object_collision();
+    profiler_collision_update(first);
 }
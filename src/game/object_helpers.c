@@ -198,6 +198,7 @@ void obj_set_held_state(struct Object *obj, const BehaviorScript *heldBehavior)
         }
     } else {
         obj->curBhvCommand = segmented_to_virtual(heldBehavior);
+        obj->curBhvInstr = NULL;
         obj->bhvStackIndex = 0;
     }
 }
@@ -442,7 +443,9 @@ struct Object *spawn_object_relative_with_scale(s16 behaviorParam, s16 relativeP
 }
 
 void cur_obj_move_using_vel(void) {
-    vec3f_add(&o->oPosVec, &o->oVelVec);
+    o->oPosX += o->oVelX * OBJ_UPDATE_FRAMES;
+    o->oPosY += o->oVelY * OBJ_UPDATE_FRAMES;
+    o->oPosZ += o->oVelZ * OBJ_UPDATE_FRAMES;
 }
 
 void obj_copy_graph_y_offset(struct Object *dst, struct Object *src) {
@@ -907,12 +910,12 @@ void obj_become_tangible(struct Object *obj) {
 
 void cur_obj_update_floor_height(void) {
     struct Surface *floor;
-    o->oFloorHeight = find_floor(o->oPosX, o->oPosY, o->oPosZ, &floor);
+    o->oFloorHeight = find_floor_cached(&o->floorCache, o->oPosX, o->oPosY, o->oPosZ, &floor);
 }
 
 struct Surface *cur_obj_update_floor_height_and_get_floor(void) {
     struct Surface *floor;
-    o->oFloorHeight = find_floor(o->oPosX, o->oPosY, o->oPosZ, &floor);
+    o->oFloorHeight = find_floor_cached(&o->floorCache, o->oPosX, o->oPosY, o->oPosZ, &floor);
     return floor;
 }
 
@@ -945,10 +948,10 @@ void cur_obj_apply_drag_xz(f32 dragStrength) {
 static void cur_obj_move_xz(f32 steepSlopeNormalY, s32 careAboutEdgesAndSteepSlopes) {
     struct Surface *intendedFloor;
 
-    f32 intendedX = o->oPosX + o->oVelX;
-    f32 intendedZ = o->oPosZ + o->oVelZ;
+    f32 intendedX = o->oPosX + o->oVelX * OBJ_UPDATE_FRAMES;
+    f32 intendedZ = o->oPosZ + o->oVelZ * OBJ_UPDATE_FRAMES;
 
-    f32 intendedFloorHeight = find_floor(intendedX, o->oPosY, intendedZ, &intendedFloor);
+    f32 intendedFloorHeight = find_floor_cached(&o->floorCache, intendedX, o->oPosY, intendedZ, &intendedFloor);
     f32 deltaFloorHeight = intendedFloorHeight - o->oFloorHeight;
 
     o->oMoveFlags &= ~OBJ_MOVE_HIT_EDGE;
@@ -1052,12 +1055,12 @@ static void cur_obj_move_update_ground_air_flags(UNUSED f32 gravity, f32 bouncin
 }
 
 static f32 cur_obj_move_y_and_get_water_level(f32 gravity, f32 buoyancy) {
-    o->oVelY += gravity + buoyancy;
+    o->oVelY += (gravity + buoyancy) * OBJ_UPDATE_FRAMES;
     if (o->oVelY < -78.0f) {
         o->oVelY = -78.0f;
     }
 
-    o->oPosY += o->oVelY;
+    o->oPosY += o->oVelY * OBJ_UPDATE_FRAMES;
     if (o->activeFlags & ACTIVE_FLAG_IGNORE_ENV_BOXES) {
         return FLOOR_LOWER_LIMIT;
     }
@@ -1128,8 +1131,8 @@ void cur_obj_move_xz_using_fvel_and_yaw(void) {
     o->oVelX = o->oForwardVel * sins(o->oMoveAngleYaw);
     o->oVelZ = o->oForwardVel * coss(o->oMoveAngleYaw);
 
-    o->oPosX += o->oVelX;
-    o->oPosZ += o->oVelZ;
+    o->oPosX += o->oVelX * OBJ_UPDATE_FRAMES;
+    o->oPosZ += o->oVelZ * OBJ_UPDATE_FRAMES;
 }
 
 void cur_obj_move_y_with_terminal_vel(void) {
@@ -1137,7 +1140,7 @@ void cur_obj_move_y_with_terminal_vel(void) {
         o->oVelY = -70.0f;
     }
 
-    o->oPosY += o->oVelY;
+    o->oPosY += o->oVelY * OBJ_UPDATE_FRAMES;
 }
 
 void cur_obj_compute_vel_xz(void) {
@@ -1467,8 +1470,8 @@ UNUSED static s32 cur_obj_within_bounds(f32 bounds) {
 }
 
 void cur_obj_move_using_vel_and_gravity(void) {
-    o->oVelY += o->oGravity; //! No terminal velocity
-    vec3f_add(&o->oPosVec, &o->oVelVec);
+    o->oVelY += o->oGravity * OBJ_UPDATE_FRAMES; //! No terminal velocity
+    cur_obj_move_using_vel();
 }
 
 void cur_obj_move_using_fvel_and_gravity(void) {
@@ -1865,6 +1868,11 @@ void bhv_init_room(void) {
 
 s32 cur_obj_is_mario_in_room(void) {
     if (o->oRoom != -1 && gMarioCurrentRoom != 0) {
+#ifdef ROOM_VISIBILITY
+        if (gCurrentArea->roomVisibility != NULL) {
+            return is_room_visible_from(gMarioCurrentRoom, o->oRoom) ? MARIO_INSIDE_ROOM : MARIO_OUTSIDE_ROOM;
+        }
+#endif
         if (gMarioCurrentRoom == o->oRoom // Object is in Mario's room.
             || gDoorAdjacentRooms[gMarioCurrentRoom].forwardRoom  == o->oRoom // Object is in the transition room's forward  room.
             || gDoorAdjacentRooms[gMarioCurrentRoom].backwardRoom == o->oRoom // Object is in the transition room's backward room.
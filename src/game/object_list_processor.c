@@ -5,6 +5,7 @@
 #include "behavior_data.h"
 #include "camera.h"
 #include "debug.h"
+#include "game_init.h"
 #include "engine/behavior_script.h"
 #include "engine/graph_node.h"
 #include "engine/surface_collision.h"
@@ -109,6 +110,13 @@ struct Object *gCurrentObject;
  */
 const BehaviorScript *gCurBhvCommand;
 
+#ifdef OBJECT_UPDATE_LOD
+/**
+ * How many frames the current object's update covers, more than 1 when OBJECT_UPDATE_LOD throttles it.
+ */
+s32 gObjectUpdateFrames = 1;
+#endif
+
 /**
  * The number of objects that were processed last frame, which may miss some
  * objects that were spawned last frame and all objects that were spawned this
@@ -286,12 +294,82 @@ void bhv_mario_update(void) {
  * Update every object that occurs after firstObj in the given object list,
  * including firstObj itself. Return the number of objects that were updated.
  */
+#ifdef ROOM_VISIBILITY
+/**
+ * Whether obj is in a room that can't be seen from Mario's room. Objects that are active from afar or have collision
+ * are always updated, since they can still affect Mario.
+ */
+static s32 obj_is_in_hidden_room(struct Object *obj) {
+    return obj->oRoom > 0
+        && obj != gMarioObject
+        && obj->collisionData == NULL
+        && !(obj->oFlags & OBJ_FLAG_ACTIVE_FROM_AFAR)
+        && !is_room_visible_from(gMarioCurrentRoom, obj->oRoom);
+}
+#endif
+
+#ifdef OBJECT_UPDATE_LOD
+/**
+ * Returns how many frames apart the object should be updated, based on its distance to Mario as of its last update.
+ */
+static s32 obj_get_update_interval(struct Object *obj) {
+    if (obj == gMarioObject
+        || (obj->oFlags & (OBJ_FLAG_UPDATE_EVERY_FRAME | OBJ_FLAG_ACTIVE_FROM_AFAR | OBJ_FLAG_PLAYER))
+        || !(obj->oFlags & OBJ_FLAG_COMPUTE_DIST_TO_MARIO)
+        || obj->collisionData != NULL
+        || obj->oHeldState != HELD_FREE) {
+        return 1;
+    }
+
+    if (obj->oDistanceToMario > OBJECT_UPDATE_LOD_QUARTER_DIST) {
+        return 4;
+    }
+    if (obj->oDistanceToMario > OBJECT_UPDATE_LOD_HALF_DIST) {
+        return 2;
+    }
+    return 1;
+}
+
+/**
+ * Returns whether the object is skipped this frame. Otherwise sets gObjectUpdateFrames to how many frames its update covers.
+ */
+static s32 obj_skip_update(struct Object *obj) {
+    s32 interval = obj_get_update_interval(obj);
+
+    // Offset by the object's slot, so objects in the same band don't all update on the same frame.
+    if (((gGlobalTimer + (obj - gObjectPool)) & (interval - 1)) != 0) {
+        return TRUE;
+    }
+
+    // Objects that just spawned, or were frozen by time stop, only catch up by the interval at most.
+    u32 framesSinceUpdate = gGlobalTimer - obj->lastUpdateTimer;
+    gObjectUpdateFrames = (framesSinceUpdate == 0) ? 1 : MIN(framesSinceUpdate, (u32) interval);
+    obj->lastUpdateTimer = gGlobalTimer;
+    return FALSE;
+}
+#endif
+
 s32 update_objects_starting_at(struct ObjectNode *objList, struct ObjectNode *firstObj) {
     s32 count = 0;
 
     while (objList != firstObj) {
         gCurrentObject = (struct Object *) firstObj;
 
+#ifdef ROOM_VISIBILITY
+        if (obj_is_in_hidden_room(gCurrentObject)) {
+            cur_obj_disable_rendering_in_room();
+            firstObj = firstObj->next;
+            count++;
+            continue;
+        }
+#endif
+#ifdef OBJECT_UPDATE_LOD
+        if (obj_skip_update(gCurrentObject)) {
+            firstObj = firstObj->next;
+            count++;
+            continue;
+        }
+#endif
         gCurrentObject->header.gfx.node.flags |= GRAPH_RENDER_HAS_ANIMATION;
         cur_obj_update();
 
@@ -299,6 +377,9 @@ s32 update_objects_starting_at(struct ObjectNode *objList, struct ObjectNode *fi
         count++;
     }
 
+#ifdef OBJECT_UPDATE_LOD
+    gObjectUpdateFrames = 1;
+#endif
     return count;
 }
 
@@ -478,7 +559,7 @@ void spawn_objects_from_info(UNUSED s32 unused, struct SpawnInfo *spawnInfo) {
             object->oBehParams2ndByte = GET_BPARAM2(spawnInfo->behaviorArg);
 
             object->behavior = script;
-            object->unused1 = 0;
+            object->curBhvInstr = NULL;
 
             // Record death/collection in the SpawnInfo
             object->respawnInfoType = RESPAWN_INFO_TYPE_NORMAL;
@@ -533,6 +614,9 @@ void clear_objects(void) {
     gObjectLists = gObjectListArray;
 
     clear_dynamic_surfaces();
+#ifdef PREDECODE_BEHAVIORS
+    clear_predecoded_behaviors();
+#endif
 }
 
 /**
@@ -644,6 +728,16 @@ void update_objects(UNUSED s32 unused) {
 
     gObjectLists = gObjectListArray;
 
+#ifdef ROOM_VISIBILITY
+    // Rooms are culled against the room Mario is standing in, so keep it current even in areas without room switches.
+    if (gCurrentArea->roomVisibility != NULL && gMarioObject != NULL) {
+        s32 room = get_room_at_pos(gMarioObject->oPosX, gMarioObject->oPosY, gMarioObject->oPosZ);
+        if (room > 0) {
+            gMarioCurrentRoom = room;
+        }
+    }
+#endif
+
     // If time stop is not active, unload object surfaces
     clear_dynamic_surfaces();
 
@@ -89,6 +89,14 @@ extern struct Object *gCurrentObject;
 #define o gCurrentObject
 
 extern const BehaviorScript *gCurBhvCommand;
+
+#ifdef OBJECT_UPDATE_LOD
+extern s32 gObjectUpdateFrames;
+// How many frames the current object's update covers, for scaling its movement.
+#define OBJ_UPDATE_FRAMES gObjectUpdateFrames
+#else
+#define OBJ_UPDATE_FRAMES 1
+#endif
 extern s16 gPrevFrameObjectCount;
 
 extern s32 gSurfaceNodesAllocated;
@@ -0,0 +1,210 @@
+#include <ultra64.h>
+
+#include "sm64.h"
+#include "game_init.h"
+#include "object_list_processor.h"
+#include "profiler_export.h"
+#include "profiling.h"
+#include "string.h"
+#ifdef UNF
+#include "usb/usb.h"
+#include "usb/debug.h"
+#endif
+
+#ifdef PROFILER_EXPORT
+
+#if !defined(ISVPRINT) && !defined(UNF)
+#error "PROFILER_EXPORT sends its records over ISV/UNF, build with ISVPRINT=1 or UNF=1."
+#endif
+
+struct ProfilerExportCategory {
+    u8 group;
+    const char *name;
+};
+
+static const struct ProfilerExportCategory sProfilerExportCategories[PROFILER_TIME_COUNT] = {
+    [PROFILER_TIME_FPS] = { PROFILER_EXPORT_GROUP_FRAME, "frame" },
+    [PROFILER_TIME_CONTROLLERS] = { PROFILER_EXPORT_GROUP_GAME, "controllers" },
+    [PROFILER_TIME_SPAWNER] = { PROFILER_EXPORT_GROUP_GAME, "spawner" },
+    [PROFILER_TIME_DYNAMIC] = { PROFILER_EXPORT_GROUP_GAME, "dynamic" },
+    [PROFILER_TIME_BEHAVIOR_BEFORE_MARIO] = { PROFILER_EXPORT_GROUP_GAME, "behavior_before_mario" },
+    [PROFILER_TIME_MARIO] = { PROFILER_EXPORT_GROUP_GAME, "mario" },
+    [PROFILER_TIME_BEHAVIOR_AFTER_MARIO] = { PROFILER_EXPORT_GROUP_GAME, "behavior_after_mario" },
+    [PROFILER_TIME_GFX] = { PROFILER_EXPORT_GROUP_GAME, "gfx" },
+    [PROFILER_TIME_COLLISION] = { PROFILER_EXPORT_GROUP_GAME, "collision" },
+    [PROFILER_TIME_CAMERA] = { PROFILER_EXPORT_GROUP_GAME, "camera" },
+#ifdef PUPPYPRINT_DEBUG
+    // Puppyprint's time is taken out of the game thread total.
+    [PROFILER_TIME_PUPPYPRINT1] = { PROFILER_EXPORT_GROUP_FRAME, "puppyprint1" },
+    [PROFILER_TIME_PUPPYPRINT2] = { PROFILER_EXPORT_GROUP_FRAME, "puppyprint2" },
+#endif
+#ifdef AUDIO_PROFILING
+    [PROFILER_TIME_SUB_AUDIO_SEQUENCES] = { PROFILER_EXPORT_GROUP_AUDIO_DETAIL, "audio_sequences" },
+    [PROFILER_TIME_SUB_AUDIO_SEQUENCES_SCRIPT] = { PROFILER_EXPORT_GROUP_AUDIO_DETAIL, "audio_sequences_script" },
+    [PROFILER_TIME_SUB_AUDIO_SEQUENCES_RECLAIM] = { PROFILER_EXPORT_GROUP_AUDIO_DETAIL, "audio_sequences_reclaim" },
+    [PROFILER_TIME_SUB_AUDIO_SEQUENCES_PROCESSING] = { PROFILER_EXPORT_GROUP_AUDIO_DETAIL, "audio_sequences_processing" },
+    [PROFILER_TIME_SUB_AUDIO_SYNTHESIS] = { PROFILER_EXPORT_GROUP_AUDIO_DETAIL, "audio_synthesis" },
+    [PROFILER_TIME_SUB_AUDIO_SYNTHESIS_PROCESSING] = { PROFILER_EXPORT_GROUP_AUDIO_DETAIL, "audio_synthesis_processing" },
+    [PROFILER_TIME_SUB_AUDIO_SYNTHESIS_ENVELOPE_REVERB] = { PROFILER_EXPORT_GROUP_AUDIO_DETAIL, "audio_synthesis_envelope_reverb" },
+    [PROFILER_TIME_SUB_AUDIO_SYNTHESIS_DMA] = { PROFILER_EXPORT_GROUP_AUDIO_DETAIL, "audio_synthesis_dma" },
+    [PROFILER_TIME_SUB_AUDIO_UPDATE] = { PROFILER_EXPORT_GROUP_AUDIO_DETAIL, "audio_update" },
+#endif
+    [PROFILER_TIME_AUDIO] = { PROFILER_EXPORT_GROUP_AUDIO, "audio" },
+    [PROFILER_TIME_TOTAL] = { PROFILER_EXPORT_GROUP_FRAME, "game" },
+    [PROFILER_TIME_RSP_GFX] = { PROFILER_EXPORT_GROUP_RSP, "rsp_gfx" },
+    [PROFILER_TIME_RSP_AUDIO] = { PROFILER_EXPORT_GROUP_RSP_AUDIO, "rsp_audio" },
+    [PROFILER_TIME_TMEM] = { PROFILER_EXPORT_GROUP_RDP, "rdp_tmem" },
+    [PROFILER_TIME_PIPE] = { PROFILER_EXPORT_GROUP_RDP, "rdp_pipe" },
+    [PROFILER_TIME_CMD] = { PROFILER_EXPORT_GROUP_RDP, "rdp_cmd" },
+};
+
+// Enough for the schema header, and a group byte, up to 38 characters of name and its terminator per category.
+#define PROFILER_EXPORT_SCHEMA_SIZE (8 + PROFILER_TIME_COUNT * 40)
+#define PROFILER_EXPORT_FRAME_SIZE (sizeof(struct ProfilerExportFrame) + PROFILER_TIME_COUNT * sizeof(u32))
+#ifdef PROFILER_BEHAVIORS
+// Enough for the chunk header, and the time, count, up to 47 characters of name and its terminator per behavior.
+#define PROFILER_EXPORT_BEHAVIORS_SIZE (sizeof(struct ProfilerExportBehaviors) + PROFILER_BEHAVIOR_MAX * 56)
+#else
+#define PROFILER_EXPORT_BEHAVIORS_SIZE 0
+#endif
+// Bytes of the stream printed per line over ISV.
+#define PROFILER_EXPORT_HEX_LINE_SIZE 32
+
+static u8 sProfilerExportBuffer[PROFILER_EXPORT_SCHEMA_SIZE + PROFILER_EXPORT_BATCH_FRAMES * PROFILER_EXPORT_FRAME_SIZE
+                                + PROFILER_EXPORT_BEHAVIORS_SIZE] ALIGNED8;
+static u32 sProfilerExportSchemaSize = 0;
+static u32 sProfilerExportSize = 0;
+static s32 sProfilerExportNumFrames = 0;
+static s32 sProfilerExportStarted = FALSE;
+
+/**
+ * Writes the schema that starts every batch: the version, then the group and name of each category.
+ */
+static u32 profiler_export_write_schema(u8 *buf) {
+    u8 *pos = buf + 8;
+
+    for (s32 i = 0; i < PROFILER_TIME_COUNT; i++) {
+        const char *name = sProfilerExportCategories[i].name != NULL ? sProfilerExportCategories[i].name : "";
+        u32 length = MIN(strlen(name), 38);
+
+        *pos++ = sProfilerExportCategories[i].group;
+        memcpy(pos, name, length);
+        pos += length;
+        *pos++ = '\0';
+    }
+
+    u32 size = ALIGN(pos - buf, 4);
+    *(u32 *) &buf[0] = PROFILER_EXPORT_MAGIC_SCHEMA;
+    buf[4] = PROFILER_EXPORT_VERSION;
+    buf[5] = PROFILER_TIME_COUNT;
+    *(u16 *) &buf[6] = size;
+    return size;
+}
+
+#ifdef PROFILER_BEHAVIORS
+/**
+ * Writes the average time and count of every behavior updated recently, named after its symbol or else its address.
+ */
+static u32 profiler_export_write_behaviors(u8 *buf) {
+    struct ProfilerExportBehaviors *header = (struct ProfilerExportBehaviors *) buf;
+    u8 *pos = buf + sizeof(struct ProfilerExportBehaviors);
+    char address[9];
+    u16 numBehaviors = 0;
+
+    for (s32 i = 0; i < PROFILER_BEHAVIOR_MAX; i++) {
+        struct ProfilerBehavior *entry = &gProfilerBehaviors[i];
+        const char *name;
+        u32 length;
+
+        if (entry->behavior == NULL || entry->avgCount == 0) {
+            continue;
+        }
+
+        name = profiler_behavior_get_name(entry);
+        if (name == NULL) {
+            sprintf(address, "%08X", (u32) entry->behavior);
+            name = address;
+        }
+        length = MIN(strlen(name), 47);
+
+        *(u32 *) &pos[0] = entry->avgTime;
+        *(u16 *) &pos[4] = MIN(entry->avgCount, 0xFFFF);
+        memcpy(&pos[6], name, length);
+        pos[6 + length] = '\0';
+        pos += ALIGN(6 + length + 1, 4);
+        numBehaviors++;
+    }
+
+    header->magic = PROFILER_EXPORT_MAGIC_BEHAVIORS;
+    header->frame = gGlobalTimer;
+    header->size = pos - buf;
+    header->numBehaviors = numBehaviors;
+    return header->size;
+}
+#endif
+
+static void profiler_export_send(void) {
+#ifdef UNF
+    usb_write(DATATYPE_RAWBINARY, sProfilerExportBuffer, sProfilerExportSize);
+#else
+    char line[4 + PROFILER_EXPORT_HEX_LINE_SIZE * 2 + 1];
+    static const char hexDigits[] = "0123456789ABCDEF";
+
+    for (u32 i = 0; i < sProfilerExportSize; i += PROFILER_EXPORT_HEX_LINE_SIZE) {
+        char *linePos = line;
+        u32 end = MIN(i + PROFILER_EXPORT_HEX_LINE_SIZE, sProfilerExportSize);
+
+        *linePos++ = 'P';
+        *linePos++ = 'R';
+        *linePos++ = 'F';
+        *linePos++ = ' ';
+        for (u32 j = i; j < end; j++) {
+            *linePos++ = hexDigits[sProfilerExportBuffer[j] >> 4];
+            *linePos++ = hexDigits[sProfilerExportBuffer[j] & 0xF];
+        }
+        *linePos = '\0';
+        osSyncPrintf("%s\n", line);
+    }
+#endif
+}
+
+/**
+ * Adds a record of the frame that just ended to the batch, and sends the batch once it's full.
+ * Has to be called before profiler_frame_setup and select_gfx_pool, so the last frame's profiler samples and display list are still current.
+ */
+void profiler_export_frame(void) {
+    struct ProfilerExportFrame *record;
+
+    // Nothing has been profiled before the first frame.
+    if (!sProfilerExportStarted) {
+        sProfilerExportStarted = TRUE;
+        return;
+    }
+
+    if (sProfilerExportSchemaSize == 0) {
+        sProfilerExportSchemaSize = profiler_export_write_schema(sProfilerExportBuffer);
+        sProfilerExportSize = sProfilerExportSchemaSize;
+    }
+
+    record = (struct ProfilerExportFrame *) &sProfilerExportBuffer[sProfilerExportSize];
+    record->magic = PROFILER_EXPORT_MAGIC_FRAME;
+    record->frame = gGlobalTimer;
+    record->numObjects = gObjectCounter;
+    record->pad = 0;
+    record->gfxPoolUsed = ((u8 *) gDisplayListHead - (u8 *) gGfxPool->buffer)
+                        + ((u8 *) (gGfxPool->buffer + GFX_POOL_SIZE) - gGfxPoolEnd);
+    profiler_get_latest_counts(record->counts);
+    sProfilerExportSize += PROFILER_EXPORT_FRAME_SIZE;
+
+    if (++sProfilerExportNumFrames >= PROFILER_EXPORT_BATCH_FRAMES) {
+#ifdef PROFILER_BEHAVIORS
+        sProfilerExportSize += profiler_export_write_behaviors(&sProfilerExportBuffer[sProfilerExportSize]);
+#endif
+        profiler_export_send();
+        // The schema stays at the start of the buffer, so each batch can be decoded on its own.
+        sProfilerExportSize = sProfilerExportSchemaSize;
+        sProfilerExportNumFrames = 0;
+    }
+}
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef PROFILER_EXPORT_H
+#define PROFILER_EXPORT_H
+
+#include <PR/ultratypes.h>
+
+#include "config.h"
+
+#define PROFILER_EXPORT_VERSION 2
+
+// Marks the start of each chunk in the stream, see tools/profiler_export.py for the layout.
+#define PROFILER_EXPORT_MAGIC_SCHEMA    0x50524653 // "PRFS"
+#define PROFILER_EXPORT_MAGIC_FRAME     0x50524652 // "PRFR"
+#define PROFILER_EXPORT_MAGIC_BEHAVIORS 0x50524642 // "PRFB"
+
+// What a category measures, which tells the decoder how to convert and nest it.
+enum ProfilerExportGroup {
+    PROFILER_EXPORT_GROUP_FRAME,        // Whole frame, in CPU counter ticks
+    PROFILER_EXPORT_GROUP_GAME,         // Part of the game thread, in CPU counter ticks
+    PROFILER_EXPORT_GROUP_AUDIO,        // One audio update (two per frame), in CPU counter ticks
+    PROFILER_EXPORT_GROUP_AUDIO_DETAIL, // Part of one audio update, in CPU counter ticks
+    PROFILER_EXPORT_GROUP_RSP,          // One RSP task, in CPU counter ticks
+    PROFILER_EXPORT_GROUP_RSP_AUDIO,    // One RSP audio task (two per frame), in CPU counter ticks
+    PROFILER_EXPORT_GROUP_RDP,          // RDP busy counter, in RDP clocks
+};
+
+struct ProfilerExportFrame {
+    /*0x00*/ u32 magic;
+    /*0x04*/ u32 frame;
+    /*0x08*/ u16 numObjects;
+    /*0x0A*/ u16 pad;
+    /*0x0C*/ u32 gfxPoolUsed;
+    /*0x10*/ u32 counts[];
+};
+
+// Sent at the end of each batch with PROFILER_BEHAVIORS, followed by each behavior's average time, count and name.
+struct ProfilerExportBehaviors {
+    /*0x00*/ u32 magic;
+    /*0x04*/ u32 frame;
+    /*0x08*/ u16 size;
+    /*0x0A*/ u16 numBehaviors;
+};
+
+#ifdef PROFILER_EXPORT
+void profiler_export_frame(void);
+#endif
+
+#endif // PROFILER_EXPORT_H
@@ -1,6 +1,8 @@
 #include <ultra64.h>
 #include <PR/os_internal_reg.h>
 #include "game_init.h"
+#include "behavior_data.h"
+#include "memory.h"
 
 #include "profiling.h"
 #include "fasttext.h"
@@ -229,6 +231,53 @@ u32 profiler_get_rdp_microseconds() {
     return RDP_CYCLE_CONV(rdp_max_cycles / PROFILING_BUFFER_SIZE);
 }
 
+static u32 last_count(enum ProfilerTime which, int next_index) {
+    return all_profiling_data[which].counts[(next_index + PROFILING_BUFFER_SIZE - 1) % PROFILING_BUFFER_SIZE];
+}
+
+/**
+ * Gets the CPU, RSP and RDP time of the last finished frame, rather than the average over the whole buffer.
+ * Has to be called after profiler_frame_setup and before the frame is rendered.
+ */
+void profiler_get_last_frame_microseconds(u32 *cpu, u32 *rsp, u32 *rdp) {
+    u32 cpu_audio_time = last_count(PROFILER_TIME_AUDIO, audio_buffer_index);
+    u32 rsp_graphics_time = last_count(PROFILER_TIME_RSP_GFX, rsp_buffer_indices[PROFILER_RSP_GFX]);
+    u32 rsp_audio_time = last_count(PROFILER_TIME_RSP_AUDIO, rsp_buffer_indices[PROFILER_RSP_AUDIO]);
+    u32 rdp_pipe_cycles = last_count(PROFILER_TIME_PIPE, profile_buffer_index);
+    u32 rdp_tmem_cycles = last_count(PROFILER_TIME_TMEM, profile_buffer_index);
+    u32 rdp_cmd_cycles = last_count(PROFILER_TIME_CMD, profile_buffer_index);
+
+    // Audio runs twice per frame, so count its last update twice like profiler_print_times does.
+    *cpu = OS_CYCLES_TO_USEC(last_count(PROFILER_TIME_TOTAL, profile_buffer_index) + cpu_audio_time * 2);
+    *rsp = OS_CYCLES_TO_USEC(rsp_graphics_time + rsp_audio_time * 2);
+    *rdp = RDP_CYCLE_CONV(MAX(MAX(rdp_pipe_cycles, rdp_tmem_cycles), rdp_cmd_cycles));
+}
+
+/**
+ * Copies the newest sample of every category, which are the times of the frame that just ended when called before profiler_frame_setup.
+ * Audio and RSP samples are the newest finished audio update and RSP task.
+ */
+void profiler_get_latest_counts(u32 counts[PROFILER_TIME_COUNT]) {
+    for (s32 i = 0; i < PROFILER_TIME_COUNT; i++) {
+        int index = profile_buffer_index;
+
+        if (i == PROFILER_TIME_RSP_GFX || i == PROFILER_TIME_RSP_AUDIO) {
+            index = rsp_buffer_indices[i - PROFILER_TIME_RSP_GFX] - 1;
+#ifdef AUDIO_PROFILING
+        } else if (i >= PROFILER_TIME_SUB_AUDIO_START && i <= PROFILER_TIME_AUDIO) {
+#else
+        } else if (i == PROFILER_TIME_AUDIO) {
+#endif
+            index = (int) audio_buffer_index - 1;
+        }
+
+        if (index < 0) {
+            index += PROFILING_BUFFER_SIZE;
+        }
+        counts[i] = all_profiling_data[i].counts[index];
+    }
+}
+
 void profiler_print_times() {
     u32 microseconds[PROFILER_TIME_COUNT];
     char text_buffer[196];
@@ -324,6 +373,213 @@ void profiler_print_times() {
     }
 }
 
+#ifdef PROFILER_ZONES
+struct ProfilerZone gProfilerZones[PROFILER_ZONE_MAX_NODES] = {
+    { .name = "frame", .parent = -1, .firstChild = -1, .nextSibling = -1 },
+};
+s32 gNumProfilerZones = 1;
+
+static s16 zone_stack[PROFILER_ZONE_MAX_DEPTH];
+static u32 zone_start_times[PROFILER_ZONE_MAX_DEPTH];
+static s32 zone_depth = 0;
+// Zones entered past the depth limit or with the tree full. Their time counts towards the zone they're in instead.
+static s32 zone_skipped_depth = 0;
+static u32 zone_frames = 0;
+static u32 zone_skipped_start_time;
+
+/**
+ * Enters the zone with this name under the current zone, adding it to the tree the first time.
+ * Returns where to store the zone's start time.
+ */
+u32 *profiler_zone_push(const char *name) {
+    s32 parent = zone_stack[zone_depth];
+    s32 zone;
+
+    if (zone_skipped_depth > 0 || zone_depth >= PROFILER_ZONE_MAX_DEPTH - 1) {
+        zone_skipped_depth++;
+        return &zone_skipped_start_time;
+    }
+
+    for (zone = gProfilerZones[parent].firstChild; zone != -1; zone = gProfilerZones[zone].nextSibling) {
+        if (gProfilerZones[zone].name == name) {
+            break;
+        }
+    }
+
+    if (zone == -1) {
+        if (gNumProfilerZones >= PROFILER_ZONE_MAX_NODES) {
+            zone_skipped_depth++;
+            return &zone_skipped_start_time;
+        }
+
+        zone = gNumProfilerZones++;
+        bzero(&gProfilerZones[zone], sizeof(struct ProfilerZone));
+        gProfilerZones[zone].name = name;
+        gProfilerZones[zone].parent = parent;
+        gProfilerZones[zone].firstChild = -1;
+        gProfilerZones[zone].nextSibling = gProfilerZones[parent].firstChild;
+        gProfilerZones[parent].firstChild = zone;
+    }
+
+    zone_stack[++zone_depth] = zone;
+    return &zone_start_times[zone_depth];
+}
+
+void profiler_zone_pop(u32 time) {
+    if (zone_skipped_depth > 0) {
+        zone_skipped_depth--;
+        return;
+    }
+    if (zone_depth == 0) {
+        return;
+    }
+
+    struct ProfilerZone *zone = &gProfilerZones[zone_stack[zone_depth]];
+    zone->time += time - zone_start_times[zone_depth];
+    zone->calls++;
+    zone_depth--;
+}
+
+/**
+ * Adds this frame's zone times to the totals, and turns the totals into averages every PROFILING_BUFFER_SIZE frames.
+ */
+static void profiler_zones_frame_end(void) {
+    s32 i, child;
+
+    // Anything still open was not closed properly, start the next frame from the root.
+    zone_depth = 0;
+    zone_skipped_depth = 0;
+
+    for (i = 1; i < gNumProfilerZones; i++) {
+        gProfilerZones[i].totalTime += gProfilerZones[i].time;
+        gProfilerZones[i].totalCalls += gProfilerZones[i].calls;
+        gProfilerZones[i].time = 0;
+        gProfilerZones[i].calls = 0;
+    }
+
+    if (++zone_frames < PROFILING_BUFFER_SIZE) {
+        return;
+    }
+    zone_frames = 0;
+
+    for (i = 1; i < gNumProfilerZones; i++) {
+        gProfilerZones[i].avgTime = gProfilerZones[i].totalTime / PROFILING_BUFFER_SIZE;
+        gProfilerZones[i].avgCalls = gProfilerZones[i].totalCalls / PROFILING_BUFFER_SIZE;
+        gProfilerZones[i].totalTime = 0;
+        gProfilerZones[i].totalCalls = 0;
+    }
+
+    for (i = 1; i < gNumProfilerZones; i++) {
+        u32 childTime = 0;
+        for (child = gProfilerZones[i].firstChild; child != -1; child = gProfilerZones[child].nextSibling) {
+            childTime += gProfilerZones[child].avgTime;
+        }
+        gProfilerZones[i].avgSelfTime = gProfilerZones[i].avgTime - MIN(childTime, gProfilerZones[i].avgTime);
+    }
+}
+#endif
+
+#ifdef PROFILER_BEHAVIORS
+struct ProfilerBehavior gProfilerBehaviors[PROFILER_BEHAVIOR_MAX];
+
+static u32 behavior_frames = 0;
+// The table being rebuilt without the behaviors that weren't updated recently.
+static struct ProfilerBehavior behavior_scratch[PROFILER_BEHAVIOR_MAX];
+
+struct ProfilerBehaviorName {
+    const BehaviorScript *behavior;
+    const char *name;
+};
+
+// Generated from include/behavior_data.h by the Makefile.
+static const struct ProfilerBehaviorName behavior_names[] = {
+#include "src/game/behavior_names.inc.c"
+};
+
+/**
+ * Returns the slot of this behavior in the table, or of the free slot it should go in. Returns NULL if the table is full.
+ */
+static struct ProfilerBehavior *profiler_behavior_find(struct ProfilerBehavior *table, const void *behavior) {
+    u32 slot = ((uintptr_t) behavior >> 2) & (PROFILER_BEHAVIOR_MAX - 1);
+
+    for (s32 i = 0; i < PROFILER_BEHAVIOR_MAX; i++) {
+        struct ProfilerBehavior *entry = &table[slot];
+        if (entry->behavior == behavior || entry->behavior == NULL) {
+            return entry;
+        }
+        slot = (slot + 1) & (PROFILER_BEHAVIOR_MAX - 1);
+    }
+
+    return NULL;
+}
+
+void profiler_behavior_add(const void *behavior, u32 time) {
+    struct ProfilerBehavior *entry = profiler_behavior_find(gProfilerBehaviors, behavior);
+
+    // Behaviors that don't fit are left out until the table is rebuilt.
+    if (entry == NULL) {
+        return;
+    }
+
+    entry->behavior = behavior;
+    entry->time += time;
+    entry->count++;
+}
+
+/**
+ * Returns the name of the behavior from behavior_data.h, or NULL if it's not in there.
+ * Looked up the first time it's needed rather than when the behavior is added, so it isn't counted in the behavior's time.
+ */
+const char *profiler_behavior_get_name(struct ProfilerBehavior *entry) {
+    if (entry->name == NULL) {
+        entry->name = "";
+        for (u32 i = 0; i < ARRAY_COUNT(behavior_names); i++) {
+            if (segmented_to_virtual(behavior_names[i].behavior) == entry->behavior) {
+                entry->name = behavior_names[i].name;
+                break;
+            }
+        }
+    }
+
+    return (entry->name[0] != '\0') ? entry->name : NULL;
+}
+
+/**
+ * Adds this frame's behavior times to the totals, and turns the totals into averages every PROFILING_BUFFER_SIZE frames.
+ * Behaviors that weren't updated during those frames are dropped from the table, so it doesn't fill up across levels.
+ */
+static void profiler_behaviors_frame_end(void) {
+    s32 i;
+
+    for (i = 0; i < PROFILER_BEHAVIOR_MAX; i++) {
+        gProfilerBehaviors[i].totalTime += gProfilerBehaviors[i].time;
+        gProfilerBehaviors[i].totalCount += gProfilerBehaviors[i].count;
+        gProfilerBehaviors[i].time = 0;
+        gProfilerBehaviors[i].count = 0;
+    }
+
+    if (++behavior_frames < PROFILING_BUFFER_SIZE) {
+        return;
+    }
+    behavior_frames = 0;
+
+    bzero(behavior_scratch, sizeof(behavior_scratch));
+    for (i = 0; i < PROFILER_BEHAVIOR_MAX; i++) {
+        struct ProfilerBehavior *entry = &gProfilerBehaviors[i];
+        if (entry->behavior == NULL || entry->totalCount == 0) {
+            continue;
+        }
+
+        struct ProfilerBehavior *newEntry = profiler_behavior_find(behavior_scratch, entry->behavior);
+        newEntry->behavior = entry->behavior;
+        newEntry->name = entry->name;
+        newEntry->avgTime = entry->totalTime / PROFILING_BUFFER_SIZE;
+        newEntry->avgCount = entry->totalCount / PROFILING_BUFFER_SIZE;
+    }
+    bcopy(behavior_scratch, gProfilerBehaviors, sizeof(gProfilerBehaviors));
+}
+#endif
+
 void profiler_frame_setup() {
     profile_buffer_index++;
     preempted_time = 0;
@@ -332,6 +588,13 @@ void profiler_frame_setup() {
         profile_buffer_index = 0;
     }
 
+#ifdef PROFILER_ZONES
+    profiler_zones_frame_end();
+#endif
+#ifdef PROFILER_BEHAVIORS
+    profiler_behaviors_frame_end();
+#endif
+
     prev_time = cur_start = osGetCount();
 }
 
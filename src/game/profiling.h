@@ -110,6 +110,8 @@ u32 profiler_get_delta(enum ProfilerDeltaTime which);
 u32 profiler_get_cpu_microseconds();
 u32 profiler_get_rsp_microseconds();
 u32 profiler_get_rdp_microseconds();
+void profiler_get_last_frame_microseconds(u32 *cpu, u32 *rsp, u32 *rdp);
+void profiler_get_latest_counts(u32 counts[PROFILER_TIME_COUNT]);
 // See profiling.c to see why profiler_rsp_yielded isn't its own function
 static ALWAYS_INLINE void profiler_rsp_yielded() {
     profiler_rsp_resumed();
@@ -135,6 +137,108 @@ static ALWAYS_INLINE void profiler_rsp_yielded() {
 #define profiler_get_cpu_microseconds() 0
 #define profiler_get_rsp_microseconds() 0
 #define profiler_get_rdp_microseconds() 0
+#define profiler_get_last_frame_microseconds(cpu, rsp, rdp)
+#define profiler_get_latest_counts(counts)
+#endif
+
+#ifdef PROFILER_ZONES
+#define PROFILER_ZONE_MAX_NODES 128
+#define PROFILER_ZONE_MAX_DEPTH 16
+
+// A zone at one place in the call tree. The same name under different parents is a different node.
+struct ProfilerZone {
+    const char *name;
+    s16 parent;
+    s16 firstChild;
+    s16 nextSibling;
+    u16 calls;       // Times the zone was entered this frame
+    u32 time;        // Cycles spent in the zone this frame, including its children
+    u32 totalTime;   // Sums over the frames being averaged
+    u32 totalCalls;
+    u32 avgTime;     // Averages per frame over the last PROFILING_BUFFER_SIZE frames
+    u32 avgSelfTime; // avgTime minus the avgTime of the children
+    u32 avgCalls;
+};
+
+extern struct ProfilerZone gProfilerZones[PROFILER_ZONE_MAX_NODES];
+extern s32 gNumProfilerZones;
+
+u32 *profiler_zone_push(const char *name);
+void profiler_zone_pop(u32 time);
+
+// The count is read after the zone is looked up and before it's left, so the lookup isn't counted in the zone itself.
+static ALWAYS_INLINE void profiler_zone_begin(const char *name) {
+    u32 *start = profiler_zone_push(name);
+    OS_GET_COUNT_INLINE(*start);
+}
+
+static ALWAYS_INLINE void profiler_zone_end(void) {
+    u32 time;
+    OS_GET_COUNT_INLINE(time);
+    profiler_zone_pop(time);
+}
+
+static ALWAYS_INLINE void profiler_zone_scope_end(UNUSED u8 *scope) {
+    profiler_zone_end();
+}
+
+/**
+ * Zones must be closed in the order they were opened, on the game thread, and within the frame.
+ * Their time includes any time the game thread spent preempted by the audio thread.
+ */
+#define PROFILER_ZONE_BEGIN(name) profiler_zone_begin(name)
+#define PROFILER_ZONE_END() profiler_zone_end()
+// Times the rest of the enclosing block, ending the zone on any way out of it.
+#define PROFILER_ZONE(name) \
+    __attribute__((cleanup(profiler_zone_scope_end))) u8 GLUE2(profilerZoneScope, __LINE__) = (profiler_zone_begin(name), 0)
+#else
+#define PROFILER_ZONE_BEGIN(name)
+#define PROFILER_ZONE_END()
+#define PROFILER_ZONE(name)
+#endif
+
+#ifdef PROFILER_BEHAVIORS
+// Size of the hash table of behaviors, must be a power of two.
+#define PROFILER_BEHAVIOR_MAX 128
+
+struct ProfilerBehavior {
+    const void *behavior; // The object's behavior pointer, NULL if the slot is free
+    const char *name;     // NULL until looked up by profiler_behavior_get_name
+    u16 count;            // Objects updated with this behavior this frame
+    u32 time;             // Cycles spent in cur_obj_update for this behavior this frame
+    u32 totalTime;        // Sums over the frames being averaged
+    u32 totalCount;
+    u32 avgTime;          // Averages per frame over the last PROFILING_BUFFER_SIZE frames
+    u32 avgCount;
+};
+
+extern struct ProfilerBehavior gProfilerBehaviors[PROFILER_BEHAVIOR_MAX];
+
+void profiler_behavior_add(const void *behavior, u32 time);
+const char *profiler_behavior_get_name(struct ProfilerBehavior *entry);
+
+struct ProfilerBehaviorScope {
+    const void *behavior;
+    u32 start;
+};
+
+static ALWAYS_INLINE struct ProfilerBehaviorScope profiler_behavior_begin(const void *behavior) {
+    struct ProfilerBehaviorScope scope = { behavior, 0 };
+    OS_GET_COUNT_INLINE(scope.start);
+    return scope;
+}
+
+static ALWAYS_INLINE void profiler_behavior_scope_end(struct ProfilerBehaviorScope *scope) {
+    u32 time;
+    OS_GET_COUNT_INLINE(time);
+    profiler_behavior_add(scope->behavior, time - scope->start);
+}
+
+// Times the rest of the enclosing block towards this behavior, which is read when the block is entered.
+#define PROFILER_BEHAVIOR(behavior) \
+    __attribute__((cleanup(profiler_behavior_scope_end))) struct ProfilerBehaviorScope GLUE2(profilerBehaviorScope, __LINE__) = profiler_behavior_begin(behavior)
+#else
+#define PROFILER_BEHAVIOR(behavior)
 #endif
 
 #ifdef AUDIO_PROFILING
@@ -415,6 +415,15 @@ static void print_audio_overview(void) {
             "In <COL_FFFF1FFF>profiling.h<COL_-------->.", PRINT_TEXT_ALIGN_LEFT, PRINT_ALL, FONT_OUTLINE);
 #endif
 
+#ifndef VERSION_SH
+    sprintf(textBytes, "SAMPLE DMA CACHE:\nHits: %d\nMisses: %d\nEvictions: %d",
+            gSampleDmaStats.hits,
+            gSampleDmaStats.misses,
+            gSampleDmaStats.evictions);
+    print_set_envcolour(255, 255, 255, 255);
+    print_small_text_light(SCREEN_WIDTH - x, 6, textBytes, PRINT_TEXT_ALIGN_RIGHT, PRINT_ALL, FONT_OUTLINE);
+#endif
+
     print_audio_ram_overview(x, textBytes);
 }
 
@@ -466,13 +475,34 @@ extern s16 gVisualSurfaceCount;
 #endif
 
 void puppyprint_render_collision(void) {
-    char textBytes[128];
-    sprintf(textBytes, "Static Pool Size: 0x%X\nDynamic Pool Size: 0x%X\nDynamic Pool Used: 0x%X\nSurfaces Allocated: %d\nNodes Allocated: %d", 
+    char textBytes[200];
+    u32 numQueries = gPuppyCallCounter.collision_floor + gPuppyCallCounter.collision_wall + gPuppyCallCounter.collision_ceil
+                   + gPuppyCallCounter.collision_water + gPuppyCallCounter.collision_raycast;
+
+    sprintf(textBytes, "Static Pool Size: 0x%X\nDynamic Pool Size: 0x%X\nDynamic Pool Used: 0x%X\nSurfaces Allocated: %d\nNodes Allocated: %d\n\nSurfaces Visited: %d\nPer Query: %d", 
     gTotalStaticSurfaceData,
     DYNAMIC_SURFACE_POOL_SIZE,
     (uintptr_t)gDynamicSurfacePoolEnd - (uintptr_t)gDynamicSurfacePool,
-    gSurfacesAllocated, gSurfaceNodesAllocated);
+    gSurfacesAllocated, gSurfaceNodesAllocated,
+    gPuppyCallCounter.collision_surfaces_visited,
+    (gPuppyCallCounter.collision_surfaces_visited / MAX(numQueries, 1U)));
     print_small_text_light(SCREEN_WIDTH-16, 60, textBytes, PRINT_TEXT_ALIGN_RIGHT, PRINT_ALL, 1);
+    sprintf(textBytes, "Floor Cache\nHits: %d\nMisses: %d",
+    gPuppyCallCounter.floor_cache_hits,
+    gPuppyCallCounter.floor_cache_misses);
+    print_small_text_light(16, 60, textBytes, PRINT_TEXT_ALIGN_LEFT, PRINT_ALL, 1);
+#ifdef PERSISTENT_DYNAMIC_SURFACES
+    sprintf(textBytes, "Dynamic Objects\nRebuilt: %d\nReused: %d",
+    gPuppyCallCounter.dynamic_surface_objects_rebuilt,
+    gPuppyCallCounter.dynamic_surface_objects_reused);
+    print_small_text_light(16, 100, textBytes, PRINT_TEXT_ALIGN_LEFT, PRINT_ALL, 1);
+#endif
+#ifdef STATIC_SURFACE_BAND_THRESHOLD
+    sprintf(textBytes, "Height Bands\nSurfaces Skipped: %d\nPer Query: %d",
+    gPuppyCallCounter.collision_surfaces_skipped,
+    (gPuppyCallCounter.collision_surfaces_skipped / MAX(numQueries, 1U)));
+    print_small_text_light(16, 140, textBytes, PRINT_TEXT_ALIGN_LEFT, PRINT_ALL, 1);
+#endif
 
 #ifdef VISUAL_DEBUG
     print_small_text_light(160, (SCREEN_HEIGHT - 42), "Use the dpad to toggle visual collision modes", PRINT_TEXT_ALIGN_CENTRE, PRINT_ALL, FONT_OUTLINE);
@@ -488,6 +518,20 @@ void puppyprint_render_collision(void) {
 #endif
 }
 
+void puppyprint_render_rendering(void) {
+    char textBytes[192];
+
+    sprintf(textBytes, "Animation Poses\nHits: %d\nMisses: %d\n\nDisplay List Sorting\nSwitches Saved: %d\nMatrix Loads Saved: %d\n\nStatic Matrices: %d\nLevel DLs Culled: %d\nRooms Culled: %d",
+            gPuppyCallCounter.anim_pose_hits,
+            gPuppyCallCounter.anim_pose_misses,
+            gPuppyCallCounter.dl_switches_saved,
+            gPuppyCallCounter.dl_matrix_loads_saved,
+            gPuppyCallCounter.static_matrices,
+            gPuppyCallCounter.level_dls_culled,
+            gPuppyCallCounter.rooms_culled);
+    print_small_text_light(SCREEN_WIDTH-16, 60, textBytes, PRINT_TEXT_ALIGN_RIGHT, PRINT_ALL, FONT_OUTLINE);
+}
+
 extern void print_fps(s32 x, s32 y);
 
 void print_basic_profiling(void) {
@@ -504,15 +548,17 @@ void print_basic_profiling(void) {
 }
 
 void puppyprint_render_standard(void) {
-    char textBytes[128];
+    char textBytes[192];
 
-    sprintf(textBytes, "Matrix Muls: %d\n\nCollision Checks\nFloors: %d\nWalls: %d\nCeilings: %d\n Water: %d\nRaycasts: %d",
+    sprintf(textBytes, "Matrix Muls: %d\n\nCollision Checks\nFloors: %d\nWalls: %d\nCeilings: %d\n Water: %d\nRaycasts: %d\n\nObject Pairs\nTested: %d\nHit: %d",
             gPuppyCallCounter.matrix,
             gPuppyCallCounter.collision_floor,
             gPuppyCallCounter.collision_wall,
             gPuppyCallCounter.collision_ceil,
             gPuppyCallCounter.collision_water,
-            gPuppyCallCounter.collision_raycast
+            gPuppyCallCounter.collision_raycast,
+            gPuppyCallCounter.object_pairs_tested,
+            gPuppyCallCounter.object_pairs_hit
     );
     print_small_text_light(SCREEN_WIDTH-16, 32, textBytes, PRINT_TEXT_ALIGN_RIGHT, PRINT_ALL, FONT_OUTLINE);
 }
@@ -521,6 +567,121 @@ void puppyprint_render_minimal(void) {
     print_basic_profiling();
 }
 
+#ifdef PROFILER_ZONES
+#define NUM_ZONES_SHOWN 8
+
+/**
+ * Fills zones with the indices of the zones with the highest time, self time if self is set, highest first.
+ */
+static s32 get_top_zones(s16 *zones, s32 self) {
+    s32 numZones = 0;
+
+    for (s32 i = 1; i < gNumProfilerZones; i++) {
+        u32 time = self ? gProfilerZones[i].avgSelfTime : gProfilerZones[i].avgTime;
+        s32 pos = MIN(numZones, NUM_ZONES_SHOWN - 1);
+
+        if (numZones == NUM_ZONES_SHOWN) {
+            struct ProfilerZone *last = &gProfilerZones[zones[pos]];
+            if (time <= (self ? last->avgSelfTime : last->avgTime)) {
+                continue;
+            }
+        } else {
+            numZones++;
+        }
+
+        // Insertion sort, shifting down the zones that took less time.
+        for (; pos > 0; pos--) {
+            struct ProfilerZone *prev = &gProfilerZones[zones[pos - 1]];
+            if (time <= (self ? prev->avgSelfTime : prev->avgTime)) {
+                break;
+            }
+            zones[pos] = zones[pos - 1];
+        }
+        zones[pos] = i;
+    }
+
+    return numZones;
+}
+
+static void print_top_zones(s32 x, const char *title, s32 self) {
+    char textBytes[32];
+    s16 zones[NUM_ZONES_SHOWN];
+    s32 numZones = get_top_zones(zones, self);
+
+    print_small_text_light(x, 48, title, PRINT_TEXT_ALIGN_LEFT, PRINT_ALL, FONT_OUTLINE);
+    for (s32 i = 0; i < numZones; i++) {
+        struct ProfilerZone *zone = &gProfilerZones[zones[i]];
+        sprintf(textBytes, "%s\n %d" PP_CYCLE_STRING " x%d", zone->name,
+                (u32) PP_CYCLE_CONV(self ? zone->avgSelfTime : zone->avgTime), zone->avgCalls);
+        print_small_text_light(x, 64 + (i * 20), textBytes, PRINT_TEXT_ALIGN_LEFT, PRINT_ALL, FONT_OUTLINE);
+    }
+}
+
+void puppyprint_render_zones(void) {
+    print_top_zones(16, "Self", TRUE);
+    print_top_zones(SCREEN_WIDTH / 2, "Inclusive", FALSE);
+}
+#endif
+
+#ifdef PROFILER_BEHAVIORS
+#define NUM_BEHAVIORS_SHOWN 12
+
+/**
+ * Fills entries with the behaviors that took the most time, highest first.
+ */
+static s32 get_top_behaviors(struct ProfilerBehavior **entries) {
+    s32 numEntries = 0;
+
+    for (s32 i = 0; i < PROFILER_BEHAVIOR_MAX; i++) {
+        struct ProfilerBehavior *entry = &gProfilerBehaviors[i];
+        s32 pos = MIN(numEntries, NUM_BEHAVIORS_SHOWN - 1);
+
+        if (entry->behavior == NULL || entry->avgCount == 0) {
+            continue;
+        }
+
+        if (numEntries == NUM_BEHAVIORS_SHOWN) {
+            if (entry->avgTime <= entries[pos]->avgTime) {
+                continue;
+            }
+        } else {
+            numEntries++;
+        }
+
+        // Insertion sort, shifting down the behaviors that took less time.
+        for (; pos > 0 && entry->avgTime > entries[pos - 1]->avgTime; pos--) {
+            entries[pos] = entries[pos - 1];
+        }
+        entries[pos] = entry;
+    }
+
+    return numEntries;
+}
+
+void puppyprint_render_behaviors(void) {
+    char textBytes[64];
+    struct ProfilerBehavior *entries[NUM_BEHAVIORS_SHOWN];
+    s32 numEntries = get_top_behaviors(entries);
+
+    print_small_text_light(16, 48, "Behavior", PRINT_TEXT_ALIGN_LEFT, PRINT_ALL, FONT_OUTLINE);
+    print_small_text_light(SCREEN_WIDTH - 16, 48, "Time  Count  Each", PRINT_TEXT_ALIGN_RIGHT, PRINT_ALL, FONT_OUTLINE);
+    for (s32 i = 0; i < numEntries; i++) {
+        struct ProfilerBehavior *entry = entries[i];
+        const char *name = profiler_behavior_get_name(entry);
+
+        if (name != NULL) {
+            print_small_text_light(16, 64 + (i * 12), name, PRINT_TEXT_ALIGN_LEFT, PRINT_ALL, FONT_OUTLINE);
+        } else {
+            sprintf(textBytes, "%08X", (u32) entry->behavior);
+            print_small_text_light(16, 64 + (i * 12), textBytes, PRINT_TEXT_ALIGN_LEFT, PRINT_ALL, FONT_OUTLINE);
+        }
+        sprintf(textBytes, "%d" PP_CYCLE_STRING "  x%d  %d" PP_CYCLE_STRING, (u32) PP_CYCLE_CONV(entry->avgTime), entry->avgCount,
+                (u32) PP_CYCLE_CONV(entry->avgTime / MAX(entry->avgCount, 1U)));
+        print_small_text_light(SCREEN_WIDTH - 16, 64 + (i * 12), textBytes, PRINT_TEXT_ALIGN_RIGHT, PRINT_ALL, FONT_OUTLINE);
+    }
+}
+#endif
+
 void render_coverage_map(void) {
     Gfx *tempGfxHead = gDisplayListHead;
 
@@ -1032,11 +1193,18 @@ struct PuppyPrintPage ppPages[] = {
 #ifdef USE_PROFILER
     [PUPPYPRINT_PAGE_PROFILER]      = {&puppyprint_render_standard,     "Profiler"},
     [PUPPYPRINT_PAGE_MINIMAL]       = {&puppyprint_render_minimal,      "Minimal"},
+#endif
+#ifdef PROFILER_ZONES
+    [PUPPYPRINT_PAGE_ZONES]         = {&puppyprint_render_zones,        "Zones"},
+#endif
+#ifdef PROFILER_BEHAVIORS
+    [PUPPYPRINT_PAGE_BEHAVIORS]     = {&puppyprint_render_behaviors,    "Behaviors"},
 #endif
     [PUPPYPRINT_PAGE_GENERAL]       = {&puppyprint_render_general_vars, "General"},
     [PUPPYPRINT_PAGE_AUDIO]         = {&print_audio_overview,           "Audio"},
     [PUPPYPRINT_PAGE_RAM]           = {&print_ram_overview,             "Segments"},
     [PUPPYPRINT_PAGE_COLLISION]     = {&puppyprint_render_collision,    "Collision"},
+    [PUPPYPRINT_PAGE_RENDERING]     = {&puppyprint_render_rendering,    "Rendering"},
     [PUPPYPRINT_PAGE_LOG]           = {&print_console_log,              "Log"},
     [PUPPYPRINT_PAGE_LEVEL_SELECT]  = {&puppyprint_level_select_menu,   "Level Select"},
     [PUPPYPRINT_PAGE_COVERAGE]      = {&render_coverage_map,            "Coverage"},
@@ -50,6 +50,21 @@ struct CallCounter {
     u16 collision_water;
     u16 collision_raycast;
     u16 matrix;
+    u16 object_pairs_tested;
+    u16 object_pairs_hit;
+    u32 collision_surfaces_visited;
+    u32 collision_surfaces_skipped;
+    u16 floor_cache_hits;
+    u16 floor_cache_misses;
+    u16 anim_pose_hits;
+    u16 anim_pose_misses;
+    u16 dl_switches_saved;
+    u16 dl_matrix_loads_saved;
+    u16 static_matrices;
+    u16 level_dls_culled;
+    u16 rooms_culled;
+    u16 dynamic_surface_objects_rebuilt;
+    u16 dynamic_surface_objects_reused;
 };
 
 struct PuppyPrintPage{
@@ -87,11 +102,18 @@ enum PPPages {
 #ifdef USE_PROFILER
     PUPPYPRINT_PAGE_PROFILER,
     PUPPYPRINT_PAGE_MINIMAL,
+#endif
+#ifdef PROFILER_ZONES
+    PUPPYPRINT_PAGE_ZONES,
+#endif
+#ifdef PROFILER_BEHAVIORS
+    PUPPYPRINT_PAGE_BEHAVIORS,
 #endif
     PUPPYPRINT_PAGE_GENERAL,
     PUPPYPRINT_PAGE_AUDIO,
     PUPPYPRINT_PAGE_RAM,
     PUPPYPRINT_PAGE_COLLISION,
+    PUPPYPRINT_PAGE_RENDERING,
     PUPPYPRINT_PAGE_LOG,
     PUPPYPRINT_PAGE_LEVEL_SELECT,
     PUPPYPRINT_PAGE_COVERAGE,
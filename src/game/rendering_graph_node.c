@@ -6,6 +6,7 @@
 #include "gfx_dimensions.h"
 #include "main.h"
 #include "memory.h"
+#include "object_list_processor.h"
 #include "print.h"
 #include "rendering_graph_node.h"
 #include "shadow.h"
@@ -64,6 +65,9 @@ struct GeoAnimState {
     /*0x04*/ f32 translationMultiplier;
     /*0x08*/ u16 *attribute;
     /*0x0C*/ s16 *data;
+#ifdef ANIMATION_POSE_CACHE
+    /*0x10*/ struct AnimPose *pose;
+#endif
 };
 
 // For some reason, this is a GeoAnimState struct, but the current state consists
@@ -79,6 +83,127 @@ s16 *gCurrAnimData;
 
 struct AllocOnlyPool *gDisplayListHeap;
 
+#ifdef ANIMATION_POSE_CACHE
+/**
+ * A decoded animation frame, shared by every object that plays the same animation on the
+ * same frame. Joints are decoded lazily in the order the animated parts are drawn, so a pose
+ * never reads further into the index table than the uncached path would.
+ */
+struct AnimPose {
+    /*0x00*/ struct AnimPose *next;
+    /*0x04*/ struct Animation *anim;
+    /*0x08*/ u16 *attribute;
+    /*0x0C*/ s16 frame;
+    /*0x0E*/ s16 numJoints;
+    /*0x10*/ s16 numDecoded;
+    /*0x12*/ Vec3s translation;
+    /*0x18*/ Vec3f joints[][3];
+};
+
+#define ANIM_POSE_CACHE_BUCKETS   32
+#define ANIM_POSE_CACHE_MAX_JOINTS 64
+
+// Cleared at the start of every geo_process_root, since the poses live in gDisplayListHeap.
+static struct AnimPose *sAnimPoseBuckets[ANIM_POSE_CACHE_BUCKETS];
+struct AnimPose *gCurrAnimPose;
+
+/**
+ * Find the cached pose for the given animation and frame, or allocate a new one.
+ * Called after geo_set_animation_globals, once the object is known to be drawn.
+ * Returns NULL if the animation doesn't report a usable joint count or the heap is full.
+ */
+static struct AnimPose *geo_get_animation_pose(struct Animation *anim, s16 frame, u16 *attribute, s16 *data) {
+    if (gCurrAnimType == ANIM_TYPE_NONE) {
+        return NULL;
+    }
+
+    s32 numJoints = anim->unusedBoneCount;
+
+    if (numJoints <= 0 || numJoints > ANIM_POSE_CACHE_MAX_JOINTS) {
+        return NULL;
+    }
+
+    u32 bucket = ((((uintptr_t) anim >> 2) ^ (u16) frame) % ANIM_POSE_CACHE_BUCKETS);
+    struct AnimPose *pose;
+
+    for (pose = sAnimPoseBuckets[bucket]; pose != NULL; pose = pose->next) {
+        if (pose->anim == anim && pose->frame == frame && pose->attribute == attribute) {
+            PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.anim_pose_hits);
+            return pose;
+        }
+    }
+
+    pose = alloc_only_pool_alloc(gDisplayListHeap, sizeof(struct AnimPose) + (numJoints * sizeof(pose->joints[0])));
+    if (pose == NULL) {
+        return NULL;
+    }
+    PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.anim_pose_misses);
+
+    pose->anim = anim;
+    pose->attribute = attribute;
+    pose->frame = frame;
+    pose->numJoints = numJoints;
+    pose->numDecoded = 0;
+    pose->translation[0] = data[retrieve_animation_index(frame, &attribute)];
+    pose->translation[1] = data[retrieve_animation_index(frame, &attribute)];
+    pose->translation[2] = data[retrieve_animation_index(frame, &attribute)];
+    pose->next = sAnimPoseBuckets[bucket];
+    sAnimPoseBuckets[bucket] = pose;
+
+    return pose;
+}
+
+/**
+ * Cached equivalent of geo_process_animated_part's decoding. gCurrAnimAttribute is still advanced
+ * so geo_process_shadow and any uncached parts stay in sync.
+ * Returns FALSE if this joint isn't covered by the pose, in which case nothing has been consumed.
+ */
+static s32 geo_process_animated_part_cached(Vec3f translation) {
+    struct AnimPose *pose = gCurrAnimPose;
+    s32 root = (gCurrAnimType != ANIM_TYPE_ROTATION);
+    s32 joint = ((gCurrAnimAttribute - pose->attribute) / 6) - 1 + root;
+    Vec3s rotation;
+
+    if (joint < 0 || joint > pose->numDecoded || joint >= pose->numJoints) {
+        return FALSE;
+    }
+
+    if (root) {
+        f32 mul = gCurrAnimTranslationMultiplier;
+        switch (gCurrAnimType) {
+            case ANIM_TYPE_TRANSLATION:
+                translation[0] += pose->translation[0] * mul;
+                translation[1] += pose->translation[1] * mul;
+                translation[2] += pose->translation[2] * mul;
+                break;
+            case ANIM_TYPE_LATERAL_TRANSLATION:
+                translation[0] += pose->translation[0] * mul;
+                translation[2] += pose->translation[2] * mul;
+                break;
+            case ANIM_TYPE_VERTICAL_TRANSLATION:
+                translation[1] += pose->translation[1] * mul;
+                break;
+        }
+        gCurrAnimAttribute += 6;
+        gCurrAnimType = ANIM_TYPE_ROTATION;
+    }
+
+    if (joint == pose->numDecoded) {
+        rotation[0] = gCurrAnimData[retrieve_animation_index(gCurrAnimFrame, &gCurrAnimAttribute)];
+        rotation[1] = gCurrAnimData[retrieve_animation_index(gCurrAnimFrame, &gCurrAnimAttribute)];
+        rotation[2] = gCurrAnimData[retrieve_animation_index(gCurrAnimFrame, &gCurrAnimAttribute)];
+        mtxf_rotate_xyz_rows(pose->joints[joint], rotation);
+        pose->numDecoded++;
+    } else {
+        gCurrAnimAttribute += 6;
+    }
+
+    mtxf_rows_translate_and_mul(pose->joints[joint], translation, gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex]);
+
+    return TRUE;
+}
+#endif
+
 /* Rendermode settings for cycle 1 for all 8 or 13 layers. */
 struct RenderModeContainer renderModeTable_1Cycle[2] = { 
     [RENDER_NO_ZB] = { {
@@ -248,6 +373,107 @@ Mtx identityMatrixWorldScale = {{
      0x00000000,                            LOWER_FIXED(1.0f)               <<  0}
 }};
 
+#ifdef SORT_DISPLAY_LISTS
+/**
+ * Returns whether a layer's draw order can be changed without affecting the image.
+ * Only layers that write to the z-buffer and don't blend qualify.
+ */
+static s32 is_layer_sortable(s32 layer) {
+    return (layer == LAYER_OPAQUE || layer == LAYER_OPAQUE_INTER || layer == LAYER_ALPHA);
+}
+
+#ifdef PUPPYPRINT_DEBUG
+/**
+ * Counts how many times the display list changes between consecutive nodes.
+ */
+static s32 count_display_list_switches(struct DisplayListNode *list) {
+    s32 switches = 0;
+    void *prevDL = NULL;
+
+    for (; list != NULL; list = list->next) {
+        if (list->displayList != prevDL) {
+            prevDL = list->displayList;
+            switches++;
+        }
+    }
+
+    return switches;
+}
+#endif
+
+/**
+ * Stable merge sort of a DisplayListNode list by display list, so nodes with the same
+ * display list end up adjacent while keeping their traversal order.
+ */
+static struct DisplayListNode *sort_display_list_nodes(struct DisplayListNode *list) {
+    if (list == NULL || list->next == NULL) {
+        return list;
+    }
+
+    // Split the list in half.
+    struct DisplayListNode *slow = list;
+    struct DisplayListNode *fast = list->next;
+    while (fast != NULL && fast->next != NULL) {
+        slow = slow->next;
+        fast = fast->next->next;
+    }
+    struct DisplayListNode *right = slow->next;
+    slow->next = NULL;
+
+    struct DisplayListNode *left = sort_display_list_nodes(list);
+    right = sort_display_list_nodes(right);
+
+    // Merge, taking from the left half on ties to keep the sort stable.
+    struct DisplayListNode head;
+    struct DisplayListNode *tail = &head;
+    while (left != NULL && right != NULL) {
+        if ((uintptr_t) right->displayList < (uintptr_t) left->displayList) {
+            tail->next = right;
+            right = right->next;
+        } else {
+            tail->next = left;
+            left = left->next;
+        }
+        tail = tail->next;
+    }
+    tail->next = (left != NULL) ? left : right;
+
+    return head.next;
+}
+
+/**
+ * Sort every sortable layer of a master list before it is emitted.
+ */
+static void sort_master_list_layers(struct GraphNodeMasterList *node) {
+    s32 layer;
+
+    for (layer = LAYER_FIRST; layer < LAYER_COUNT; layer++) {
+        struct DisplayListNode *list = node->listHeads[layer];
+
+        if (!is_layer_sortable(layer) || list == NULL || list->next == NULL) {
+            continue;
+        }
+#ifdef PUPPYPRINT_DEBUG
+        s32 switchesBefore = count_display_list_switches(list);
+#endif
+        list = sort_display_list_nodes(list);
+        node->listHeads[layer] = list;
+#ifdef PUPPYPRINT_DEBUG
+        gPuppyCallCounter.dl_switches_saved += (switchesBefore - count_display_list_switches(list));
+#endif
+        // Collapse nodes that draw the same display list with the same matrix, and find the new tail.
+        while (list->next != NULL) {
+            if (list->next->displayList == list->displayList && list->next->transform == list->transform) {
+                list->next = list->next->next;
+            } else {
+                list = list->next;
+            }
+        }
+        node->listTails[layer] = list;
+    }
+}
+#endif
+
 /**
  * Process a master list node. This has been modified, so now it runs twice, for each microcode.
  * It iterates through the first 5 layers of if the first index using F3DLX2.Rej, then it switches
@@ -267,6 +493,13 @@ void geo_process_master_list_sub(struct GraphNodeMasterList *node) {
     struct RenderModeContainer *mode1List = &renderModeTable_1Cycle[enableZBuffer];
     struct RenderModeContainer *mode2List = &renderModeTable_2Cycle[enableZBuffer];
     Gfx *tempGfxHead = gDisplayListHead;
+#ifdef SORT_DISPLAY_LISTS
+    Mtx *prevTransform;
+
+    if (enableZBuffer) {
+        sort_master_list_layers(node);
+    }
+#endif
 
     // Loop through the render phases
     for (phaseIndex = RENDER_PHASE_FIRST; phaseIndex < finalPhase; phaseIndex++) {
@@ -301,12 +534,26 @@ void geo_process_master_list_sub(struct GraphNodeMasterList *node) {
                 gDPSetRenderMode(tempGfxHead++, mode1List->modes[currLayer],
                                                      mode2List->modes[currLayer]);
             }
+#endif
+#ifdef SORT_DISPLAY_LISTS
+            prevTransform = NULL;
 #endif
             // Iterate through all the displaylists on the current layer.
             while (currList != NULL) {
+#ifdef SORT_DISPLAY_LISTS
+                // Sorted layers can reuse the previous node's matrix if it's the same one.
+                if (enableZBuffer && is_layer_sortable(currLayer) && currList->transform == prevTransform) {
+                    PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.dl_matrix_loads_saved);
+                } else {
+                    prevTransform = currList->transform;
+                    gSPMatrix(tempGfxHead++, VIRTUAL_TO_PHYSICAL(currList->transform),
+                              (G_MTX_MODELVIEW | G_MTX_LOAD | G_MTX_NOPUSH));
+                }
+#else
                 // Add the display list's transformation to the master list.
                 gSPMatrix(tempGfxHead++, VIRTUAL_TO_PHYSICAL(currList->transform),
                           (G_MTX_MODELVIEW | G_MTX_LOAD | G_MTX_NOPUSH));
+#endif
 #if SILHOUETTE
                 if (phaseIndex == RENDER_PHASE_SILHOUETTE) {
                     // Add the current display list to the master list, with silhouette F3D.
@@ -614,6 +861,25 @@ void geo_process_camera(struct GraphNodeCamera *node) {
     }
 }
 
+#ifdef STATIC_GEO_MATRICES
+/**
+ * Push a transform node's precomputed matrix onto both matrix stacks, if it has one.
+ * Static matrices are relative to the camera node, so they're ignored inside objects.
+ */
+static s32 geo_push_static_matrix(struct StaticMatrix *staticMatrix) {
+    if (staticMatrix == NULL || gCurGraphNodeObject != NULL) {
+        return FALSE;
+    }
+
+    gMatStackIndex++;
+    mtxf_copy(gMatStack[gMatStackIndex], staticMatrix->mtxf);
+    gMatStackFixed[gMatStackIndex] = &staticMatrix->mtx;
+    PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.static_matrices);
+
+    return TRUE;
+}
+#endif
+
 /**
  * Process a translation / rotation node. A transformation matrix based
  * on the node's translation and rotation is created and pushed on both
@@ -623,6 +889,13 @@ void geo_process_camera(struct GraphNodeCamera *node) {
 void geo_process_translation_rotation(struct GraphNodeTranslationRotation *node) {
     Vec3f translation;
 
+#ifdef STATIC_GEO_MATRICES
+    if (geo_push_static_matrix(node->staticMatrix)) {
+        append_dl_and_return((struct GraphNodeDisplayList *)node);
+        return;
+    }
+#endif
+
     vec3s_to_vec3f(translation, node->translation);
     mtxf_rotate_zxy_and_translate_and_mul(node->rotation, translation, gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex]);
 
@@ -638,6 +911,13 @@ void geo_process_translation_rotation(struct GraphNodeTranslationRotation *node)
 void geo_process_translation(struct GraphNodeTranslation *node) {
     Vec3f translation;
 
+#ifdef STATIC_GEO_MATRICES
+    if (geo_push_static_matrix(node->staticMatrix)) {
+        append_dl_and_return((struct GraphNodeDisplayList *)node);
+        return;
+    }
+#endif
+
     vec3s_to_vec3f(translation, node->translation);
     mtxf_rotate_zxy_and_translate_and_mul(gVec3sZero, translation, gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex]);
 
@@ -651,6 +931,12 @@ void geo_process_translation(struct GraphNodeTranslation *node) {
  * For the rest it acts as a normal display list node.
  */
 void geo_process_rotation(struct GraphNodeRotation *node) {
+#ifdef STATIC_GEO_MATRICES
+    if (geo_push_static_matrix(node->staticMatrix)) {
+        append_dl_and_return((struct GraphNodeDisplayList *)node);
+        return;
+    }
+#endif
     mtxf_rotate_zxy_and_translate_and_mul(node->rotation, gVec3fZero, gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex]);
 
     inc_mat_stack();
@@ -665,6 +951,13 @@ void geo_process_rotation(struct GraphNodeRotation *node) {
 void geo_process_scale(struct GraphNodeScale *node) {
     Vec3f scaleVec;
 
+#ifdef STATIC_GEO_MATRICES
+    if (geo_push_static_matrix(node->staticMatrix)) {
+        append_dl_and_return((struct GraphNodeDisplayList *)node);
+        return;
+    }
+#endif
+
     vec3f_set(scaleVec, node->scale, node->scale, node->scale);
     mtxf_scale_vec3f(gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex], scaleVec);
 
@@ -696,12 +989,71 @@ void geo_process_billboard(struct GraphNodeBillboard *node) {
     append_dl_and_return((struct GraphNodeDisplayList *)node);
 }
 
+#define NO_CULLING_EMULATOR_BLACKLIST (EMU_CONSOLE | EMU_WIIVC | EMU_ARES | EMU_SIMPLE64 | EMU_CEN64)
+
+#ifdef LEVEL_GEOMETRY_CULLING
+/**
+ * Check whether a level display list node's bounding sphere, computed when the geo layout
+ * was loaded, is inside the view frustum. Nodes without bounds, or inside objects, always pass.
+ */
+static s32 display_list_is_in_view(struct GraphNodeDisplayList *node) {
+    if (node->cullingRadius == 0 || gCurGraphNodeObject != NULL || gCurGraphNodeCamFrustum == NULL) {
+        return TRUE;
+    }
+
+#ifndef CULLING_ON_EMULATOR
+    // If an emulator is detected, skip culling.
+    if (!(gEmulator & NO_CULLING_EMULATOR_BLACKLIST)) {
+        return TRUE;
+    }
+#endif
+
+    Vec3f center, worldPos, viewPos;
+    vec3s_to_vec3f(center, node->cullingCenter);
+    linear_mtxf_mul_vec3f_and_translate(gMatStack[gMatStackIndex], worldPos, center);
+    linear_mtxf_mul_vec3f_and_translate(gCameraTransform, viewPos, worldPos);
+
+    // Scale the radius by the largest axis scale of the current transform.
+    f32 scaleSq = MAX(MAX(vec3_sumsq(gMatStack[gMatStackIndex][0]), vec3_sumsq(gMatStack[gMatStackIndex][1])),
+                      vec3_sumsq(gMatStack[gMatStackIndex][2]));
+    f32 radius = node->cullingRadius * sqrtf(scaleSq);
+    f32 depth = -viewPos[2];
+
+    if (depth < -radius || depth > gCurGraphNodeCamFrustum->far + radius) {
+        return FALSE;
+    }
+
+    // Distance from the centre to a side plane, measured along x, is scaled by 1/cos(halfFov).
+    f32 halfFov = gCurGraphNodeCamFrustum->halfFovHorizontal;
+    if (absf(viewPos[0]) > (depth * halfFov) + (radius * sqrtf(1.0f + sqr(halfFov)))) {
+        return FALSE;
+    }
+#ifdef VERTICAL_CULLING
+    halfFov = gCurGraphNodeCamFrustum->halfFovVertical;
+    if (absf(viewPos[1]) > (depth * halfFov) + (radius * sqrtf(1.0f + sqr(halfFov)))) {
+        return FALSE;
+    }
+#endif
+
+    return TRUE;
+}
+#endif
+
 /**
  * Process a display list node. It draws a display list without first pushing
  * a transformation on the stack, so all transformations are inherited from the
  * parent node. It processes its children if it has them.
  */
 void geo_process_display_list(struct GraphNodeDisplayList *node) {
+#ifdef LEVEL_GEOMETRY_CULLING
+    if (!display_list_is_in_view(node)) {
+        PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.level_dls_culled);
+        if (node->node.children != NULL) {
+            geo_process_node_and_siblings(node->node.children);
+        }
+        return;
+    }
+#endif
     append_dl_and_return((struct GraphNodeDisplayList *)node);
 
     gMatStackIndex++;
@@ -770,6 +1122,15 @@ void geo_process_animated_part(struct GraphNodeAnimatedPart *node) {
     Vec3s rotation = { 0, 0, 0 };
     Vec3f translation = { node->translation[0], node->translation[1], node->translation[2] };
 
+#ifdef ANIMATION_POSE_CACHE
+    if (gCurrAnimPose != NULL && gCurrAnimType != ANIM_TYPE_NONE
+        && geo_process_animated_part_cached(translation)) {
+        inc_mat_stack();
+        append_dl_and_return(((struct GraphNodeDisplayList *)node));
+        return;
+    }
+#endif
+
     if (gCurrAnimType == ANIM_TYPE_TRANSLATION) {
         translation[0] += gCurrAnimData[retrieve_animation_index(gCurrAnimFrame, &gCurrAnimAttribute)]
                           * gCurrAnimTranslationMultiplier;
@@ -950,8 +1311,6 @@ void geo_process_shadow(struct GraphNodeShadow *node) {
  * Since (0,0,0) is unaffected by rotation, columns 0, 1 and 2 are ignored.
  */
 
-#define NO_CULLING_EMULATOR_BLACKLIST (EMU_CONSOLE | EMU_WIIVC | EMU_ARES | EMU_SIMPLE64 | EMU_CEN64)
-
 s32 obj_is_in_view(struct GraphNodeObject *node) {
     struct GraphNode *geo = node->sharedChild;
 
@@ -1036,6 +1395,7 @@ void visualise_object_hitbox(struct Object *node) {
  * Process an object node.
  */
 void geo_process_object(struct Object *node) {
+    PROFILER_ZONE("geo_process_object");
     if (node->header.gfx.areaIndex == gCurGraphNodeRoot->areaIndex) {
         s32 isInvisible = (node->header.gfx.node.flags & GRAPH_RENDER_INVISIBLE);
         s32 noThrowMatrix = (node->header.gfx.throwMatrix == NULL);
@@ -1071,6 +1431,9 @@ void geo_process_object(struct Object *node) {
         if (!isInvisible && obj_is_in_view(&node->header.gfx)) {
             gMatStackIndex--;
             inc_mat_stack();
+#ifdef ANIMATION_POSE_CACHE
+            gCurrAnimPose = geo_get_animation_pose(node->header.gfx.animInfo.curAnim, gCurrAnimFrame, gCurrAnimAttribute, gCurrAnimData);
+#endif
 
             if (node->header.gfx.sharedChild != NULL) {
 #ifdef VISUAL_DEBUG
@@ -1145,11 +1508,17 @@ void geo_process_held_object(struct GraphNodeHeldObject *node) {
         gGeoTempState.translationMultiplier = gCurrAnimTranslationMultiplier;
         gGeoTempState.attribute = gCurrAnimAttribute;
         gGeoTempState.data = gCurrAnimData;
+#ifdef ANIMATION_POSE_CACHE
+        gGeoTempState.pose = gCurrAnimPose;
+#endif
         gCurrAnimType = ANIM_TYPE_NONE;
         gCurGraphNodeHeldObject = (void *) node;
         if (node->objNode->header.gfx.animInfo.curAnim != NULL) {
             geo_set_animation_globals(&node->objNode->header.gfx.animInfo, (node->objNode->header.gfx.node.flags & GRAPH_RENDER_HAS_ANIMATION) != 0);
         }
+#ifdef ANIMATION_POSE_CACHE
+        gCurrAnimPose = geo_get_animation_pose(node->objNode->header.gfx.animInfo.curAnim, gCurrAnimFrame, gCurrAnimAttribute, gCurrAnimData);
+#endif
 
         geo_process_node_and_siblings(node->objNode->header.gfx.sharedChild);
         gCurGraphNodeHeldObject = NULL;
@@ -1159,6 +1528,9 @@ void geo_process_held_object(struct GraphNodeHeldObject *node) {
         gCurrAnimTranslationMultiplier = gGeoTempState.translationMultiplier;
         gCurrAnimAttribute = gGeoTempState.attribute;
         gCurrAnimData = gGeoTempState.data;
+#ifdef ANIMATION_POSE_CACHE
+        gCurrAnimPose = gGeoTempState.pose;
+#endif
         gMatStackIndex--;
     }
 
@@ -1176,6 +1548,20 @@ void geo_try_process_children(struct GraphNode *node) {
     }
 }
 
+#ifdef ROOM_VISIBILITY
+/**
+ * Process a start node, skipping its children if they belong to a room that can't be seen from Mario's room.
+ */
+void geo_process_start(struct GraphNodeStart *node) {
+    if (node->room > 0 && !is_room_visible_from(gMarioCurrentRoom, node->room)) {
+        PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.rooms_culled);
+        return;
+    }
+
+    geo_try_process_children(&node->node);
+}
+#endif
+
 typedef void (*GeoProcessFunc)();
 
 // See enum 'GraphNodeTypes' in 'graph_node.h'.
@@ -1201,7 +1587,11 @@ static GeoProcessFunc GeoProcessJumpTable[] = {
     [GRAPH_NODE_TYPE_HELD_OBJ            ] = geo_process_held_object,
     [GRAPH_NODE_TYPE_CULLING_RADIUS      ] = geo_try_process_children,
     [GRAPH_NODE_TYPE_ROOT                ] = geo_try_process_children,
+#ifdef ROOM_VISIBILITY
+    [GRAPH_NODE_TYPE_START               ] = geo_process_start,
+#else
     [GRAPH_NODE_TYPE_START               ] = geo_try_process_children,
+#endif
 };
 
 /**
@@ -1241,6 +1631,7 @@ void geo_process_node_and_siblings(struct GraphNode *firstNode) {
  * to set up the projection and draw display lists.
  */
 void geo_process_root(struct GraphNodeRoot *node, Vp *b, Vp *c, s32 clearColor) {
+    PROFILER_ZONE("geo_process_root");
     if (node->node.flags & GRAPH_RENDER_ACTIVE) {
         Mtx *initialMatrix;
         Vp *viewport = alloc_display_list(sizeof(*viewport));
@@ -1252,6 +1643,10 @@ void geo_process_root(struct GraphNodeRoot *node, Vp *b, Vp *c, s32 clearColor)
 
         gMatStackIndex = 0;
         gCurrAnimType = ANIM_TYPE_NONE;
+#ifdef ANIMATION_POSE_CACHE
+        gCurrAnimPose = NULL;
+        bzero(sAnimPoseBuckets, sizeof(sAnimPoseBuckets));
+#endif
         vec3s_set(viewport->vp.vtrans, node->x * 4, node->y * 4, 511);
         vec3s_set(viewport->vp.vscale, node->width * 4, node->height * 4, 511);
 
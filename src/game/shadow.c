@@ -215,7 +215,7 @@ Gfx *create_shadow_below_xyz(Vec3f pos, s16 shadowScale, u8 shadowSolidity, s8 s
     } else {
         // The object has no referenced floor, so find a new one.
         // gCollisionFlags |= COLLISION_FLAG_RETURN_FIRST;
-        floorHeight = find_floor(x, y, z, &floor);
+        floorHeight = find_floor_cached(&obj->floorCache, x, y, z, &floor);
 
         // No shadow if the position is OOB.
         if (floor == NULL) {
@@ -5,6 +5,7 @@
 #include "engine/graph_node.h"
 #include "engine/math_util.h"
 #include "engine/surface_collision.h"
+#include "game_init.h"
 #include "level_table.h"
 #include "object_constants.h"
 #include "object_fields.h"
@@ -158,7 +159,7 @@ struct Object *allocate_object(struct ObjectNode *objList) {
     }
 #endif
 
-    obj->unused1 = 0;
+    obj->curBhvInstr = NULL;
     obj->bhvStackIndex = 0;
     obj->bhvDelayTimer = 0;
 
@@ -167,7 +168,7 @@ struct Object *allocate_object(struct ObjectNode *objList) {
     obj->hurtboxRadius = 0.0f;
     obj->hurtboxHeight = 0.0f;
     obj->hitboxDownOffset = 0.0f;
-    obj->unused2 = 0;
+    obj->lastUpdateTimer = gGlobalTimer;
 
     obj->platform = NULL;
     obj->collisionData = NULL;
@@ -72,3 +72,55 @@ expand_gzip(char *in, char *outbuf, unsigned int inLength, unsigned int outbufLe
     return d_stream.total_out;
 
 }
+
+/*
+ * Streaming version of expand_gzip. Instead of taking the whole compressed buffer, readFunc
+ * is called whenever inflate has used up its input, and returns the next block of compressed
+ * data (setting its length), or NULL if there is none left. Each block is only read from
+ * until readFunc is called again, so the caller may reuse the previous block's memory then.
+ *
+ * Returns -ve value for error, or number of output bytes for success
+ */
+int
+expand_gzip_stream(unsigned char *(*readFunc)(unsigned int *length), char *outbuf, unsigned int outbufLength)
+{
+    int err;
+    z_stream d_stream; /* decompression stream */
+
+    d_stream.zalloc = (alloc_func) myalloc;
+    d_stream.zfree = (free_func) myfree;
+    d_stream.opaque = (voidpf)0;
+
+    d_stream.next_in  = Z_NULL;
+    d_stream.avail_in = 0;
+    d_stream.next_out = outbuf;
+    d_stream.avail_out = outbufLength;
+
+    err = inflateInit2(&d_stream, -MAX_WBITS);
+    if (err != Z_OK) {
+        return err;
+    }
+
+    do {
+        if (d_stream.avail_in == 0) {
+            d_stream.next_in = readFunc(&d_stream.avail_in);
+            if (d_stream.next_in == Z_NULL) {
+                inflateEnd(&d_stream);
+                return Z_BUF_ERROR;
+            }
+        }
+
+        err = inflate(&d_stream, Z_NO_FLUSH);
+        if (err != Z_OK && err != Z_STREAM_END) {
+            inflateEnd(&d_stream);
+            return err;
+        }
+    } while (err != Z_STREAM_END);
+
+    err = inflateEnd(&d_stream);
+    if (err != Z_OK) {
+        return err;
+    }
+
+    return d_stream.total_out;
+}
@@ -0,0 +1,447 @@
+// Host benchmark and regression test for the BETTER_REVERB filter kernels.
+//
+// Runs the block kernels from src/audio/better_reverb_kernel.h and the original per-sample
+// kernels side by side on the same input, checks that their outputs and delay lines stay
+// bit-identical, and reports the time each takes per preset.
+//
+// Presets that BETTER_REVERB_RSP runs on the RSP are also run through a model of the aReverb
+// command in rsp/audio.s, lane by lane with the vector unit's multiply-accumulate arithmetic,
+// in stereo and in mono, and checked against the reference in the same way.
+//
+// Build and run from the repository root:
+//   gcc -O2 -o better_reverb_bench tools/better_reverb_bench.c && ./better_reverb_bench
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+typedef int16_t s16;
+typedef uint16_t u16;
+typedef int32_t s32;
+typedef uint32_t u32;
+typedef uint8_t u8;
+typedef int64_t s64;
+
+#define MIN(a, b) ((a) <= (b) ? (a) : (b))
+#define CLAMP(x, low, high) (((x) > (high)) ? (high) : (((x) < (low)) ? (low) : (x)))
+#define CLAMP_S16(x) CLAMP((x), -0x8000, 0x7FFF)
+
+// Must match src/audio/synthesis.h.
+#define NUM_ALLPASS 12
+#define BETTER_REVERB_FILTER_COUNT_LIGHT 2
+#define BETTER_REVERB_GAIN_INDEX_LIGHT 0xA0
+#define BETTER_REVERB_REVERB_INDEX_LIGHT 0x30
+
+#include "../src/audio/better_reverb_kernel.h"
+
+// Must match sReverbDelaysArr and sReverbMultsArr in src/audio/data.c.
+static u32 sReverbDelaysArr[][NUM_ALLPASS] = {
+    { 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4 },
+    { 1080, 1352, 1200, 1200, 1232, 1432, 1384, 1048, 1352,  928, 1504, 1512 },
+    { 1384, 1352, 1048,  928, 1512, 1504, 1080, 1200, 1352, 1200, 1432, 1232 },
+};
+static u8 sReverbMultsArr[][NUM_ALLPASS / 3] = {
+    { 0x00, 0x00, 0x00, 0x00 },
+    { 0xD7, 0x6F, 0x36, 0x22 },
+    { 0xCF, 0x73, 0x38, 0x1F },
+};
+
+struct Preset {
+    const char *name;
+    s32 lightweight;
+    s32 downsampleRate;
+    s32 filterCount;
+    s32 gainIndex;
+    s32 reverbIndex;
+    s32 delays;
+    s32 mults;
+};
+
+// The BETTER_REVERB presets in src/audio/data.c, followed by a sweep over the other settings.
+static const struct Preset sPresets[] = {
+    { "Preset 1 (console)",        1, 2,  3, 0xA0, 0x30, 1, 1 },
+    { "Preset 2 (emulator)",       0, 1, 12, 0xA0, 0x40, 1, 1 },
+    { "Debug preset A/B",          0, 2,  3, 0xA0, 0x30, 1, 1 },
+    { "Heavy, 6 filters, rate 2",  0, 2,  6, 0xA0, 0x30, 2, 2 },
+    { "Heavy, 9 filters, rate 3",  0, 3,  9, 0xB0, 0x50, 2, 2 },
+    { "Heavy, 12 filters, rate 2", 0, 2, 12, 0xA0, 0x40, 1, 2 },
+    { "Heavy, tiny delays",        0, 1, 12, 0xA0, 0x40, 0, 1 },
+    { "Heavy, 6 filters, rate 1",  0, 1,  6, 0xB0, 0x50, 2, 2 },
+    { "Heavy, 9 filters, loud",    0, 1,  9, 0xFF, 0xFF, 1, 2 },
+    { "Heavy, 6 filters, boosted", 0, 1,  6, 0x120, 0x110, 2, 2 },
+    { "Light, rate 1",             1, 1,  3, 0xA0, 0x30, 2, 2 },
+    { "Light, tiny delays",        1, 1,  3, 0xA0, 0x30, 0, 0 },
+};
+
+#define NUM_FRAMES 600
+#define FRAME_SAMPLES 0x140
+
+struct ReverbState {
+    s16 *delayBufs[NUM_ALLPASS];
+    s32 allpassIdx[NUM_ALLPASS];
+    s32 delays[NUM_ALLPASS];
+    s32 reverbMults[NUM_ALLPASS / 3];
+    s32 historySampleLight;
+};
+
+// The per-sample kernels as they were in src/audio/synthesis.c, used as the reference.
+static void reference_reverb_samples(s16 *start, s16 *end, s16 *downsampleBuffer, s32 downsampleIncrement,
+                                     struct ReverbState *state, s32 lastFilterIndex, s32 revIndex, s32 gainIndex) {
+    s16 *curDelaySample;
+    s32 historySample;
+    s32 tmpCarryover;
+    s32 outSampleTotal;
+    s32 i;
+    s32 j;
+    s32 k;
+
+    s32 *delaysLocal = state->delays;
+    s32 *reverbMultsLocal = state->reverbMults;
+    s32 *allpassIdxLocal = state->allpassIdx;
+    s16 **delayBufsLocal = state->delayBufs;
+
+    j = 0;
+
+    for (; start < end; start++, downsampleBuffer += downsampleIncrement) {
+        tmpCarryover = ((delayBufsLocal[lastFilterIndex][allpassIdxLocal[lastFilterIndex]] * revIndex) >> 8) + *downsampleBuffer;
+        outSampleTotal = 0;
+        i = 0;
+        k = 0;
+
+        for (; i <= lastFilterIndex; ++i, ++j) {
+            curDelaySample = &delayBufsLocal[i][allpassIdxLocal[i]];
+            historySample = *curDelaySample;
+
+            if (j == 2) {
+                j = -1;
+                outSampleTotal += ((historySample * reverbMultsLocal[k++]) >> 8);
+                *curDelaySample = CLAMP_S16(tmpCarryover);
+                if (i != lastFilterIndex)
+                    tmpCarryover = ((historySample * revIndex) >> 8);
+            } else {
+                tmpCarryover += (historySample * (-gainIndex)) >> 8;
+                *curDelaySample = CLAMP_S16(tmpCarryover);
+                tmpCarryover = ((tmpCarryover * gainIndex) >> 8) + historySample;
+            }
+
+            if (++allpassIdxLocal[i] == delaysLocal[i]) allpassIdxLocal[i] = 0;
+        }
+
+        *start = CLAMP_S16(outSampleTotal);
+    }
+}
+
+static void reference_reverb_samples_light(s16 *start, s16 *end, s16 *downsampleBuffer, s32 downsampleIncrement,
+                                           struct ReverbState *state) {
+    s16 *curDelaySample;
+    s32 historySample;
+    s32 tmpCarryover;
+    s32 i;
+
+    s32 *delaysLocal = state->delays;
+    s32 *allpassIdxLocal = state->allpassIdx;
+    s16 **delayBufsLocal = state->delayBufs;
+
+    tmpCarryover = state->historySampleLight;
+
+    for (; start < end; start++, downsampleBuffer += downsampleIncrement) {
+        tmpCarryover = ((tmpCarryover * BETTER_REVERB_REVERB_INDEX_LIGHT) >> 8) + *downsampleBuffer;
+
+        for (i = 0; i < BETTER_REVERB_FILTER_COUNT_LIGHT; ++i) {
+            curDelaySample = &delayBufsLocal[i][allpassIdxLocal[i]];
+            historySample = *curDelaySample;
+
+            tmpCarryover += ((historySample * (-BETTER_REVERB_GAIN_INDEX_LIGHT)) >> 8);
+            *curDelaySample = CLAMP_S16(tmpCarryover);
+            tmpCarryover = ((tmpCarryover * BETTER_REVERB_GAIN_INDEX_LIGHT) >> 8) + historySample;
+
+            if (++allpassIdxLocal[i] == delaysLocal[i]) allpassIdxLocal[i] = 0;
+        }
+
+        *start = CLAMP_S16(tmpCarryover);
+    }
+
+    state->historySampleLight = tmpCarryover;
+}
+
+static void init_state(struct ReverbState *state, const struct Preset *preset) {
+    s32 filterCount = preset->lightweight ? BETTER_REVERB_FILTER_COUNT_LIGHT : preset->filterCount;
+
+    memset(state, 0, sizeof(*state));
+    for (s32 i = 0; i < filterCount; i++) {
+        state->delays[i] = sReverbDelaysArr[preset->delays][i] / preset->downsampleRate;
+        state->delayBufs[i] = calloc(state->delays[i], sizeof(s16));
+    }
+    for (s32 i = 0; i < NUM_ALLPASS / 3; i++) {
+        state->reverbMults[i] = sReverbMultsArr[preset->mults][i];
+    }
+}
+
+static void free_state(struct ReverbState *state) {
+    for (s32 i = 0; i < NUM_ALLPASS; i++) {
+        free(state->delayBufs[i]);
+    }
+}
+
+static s32 states_match(struct ReverbState *a, struct ReverbState *b, s32 filterCount) {
+    if (a->historySampleLight != b->historySampleLight) {
+        return 0;
+    }
+    for (s32 i = 0; i < filterCount; i++) {
+        if (a->allpassIdx[i] != b->allpassIdx[i]
+            || memcmp(a->delayBufs[i], b->delayBufs[i], a->delays[i] * sizeof(s16)) != 0) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Loud noise bursts over a quieter sweep, to exercise both clamping and the quiet tails.
+static s16 *make_input(s32 numSamples) {
+    s16 *input = malloc(numSamples * sizeof(s16));
+    u32 seed = 0x12345678;
+
+    for (s32 i = 0; i < numSamples; i++) {
+        seed = seed * 1664525 + 1013904223;
+        s32 noise = (s32) (seed >> 16) - 0x8000;
+        s32 sweep = ((i * (i >> 6)) & 0x3FFF) - 0x2000;
+        input[i] = ((i / 4096) % 3 == 0) ? noise : sweep;
+    }
+    return input;
+}
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Must match REVERB_BLOCK_SIZE in rsp/audio.s.
+#define RSP_BLOCK_SIZE 64
+#define RSP_VECTOR_SIZE 8
+
+// The vector multiplies used by the aReverb command, on one lane of the 48 bit accumulator.
+// None of the sums in the command come close to overflowing it.
+static s64 rsp_mudm(s16 a, u16 b) { return (s64) a * b; } // VMUDM/VMADM: signed * unsigned
+static s64 rsp_mudn(u16 a, s16 b) { return (s64) a * b; } // VMUDN/VMADN: unsigned * signed
+static s64 rsp_mudh(s16 a, s16 b) { return (s64) a * b * 0x10000; } // VMUDH/VMADH: signed * signed, into the high half
+static s16 rsp_result(s64 acc) { return CLAMP_S16(acc >> 16); } // The clamped middle of the accumulator
+
+static s32 rsp_supports_preset(const struct Preset *preset) {
+    if (preset->lightweight || preset->downsampleRate != 1) {
+        return 0;
+    }
+    // The command takes both indices as 8 bit fractions, anything else stays on the CPU.
+    if (preset->gainIndex < 1 || preset->gainIndex > 0xFF || preset->reverbIndex < 0 || preset->reverbIndex > 0xFF) {
+        return 0;
+    }
+    for (s32 i = 0; i < preset->filterCount; i++) {
+        u32 delay = sReverbDelaysArr[preset->delays][i];
+        if ((delay % 4) != 0 || delay <= RSP_BLOCK_SIZE) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * Model of the aReverb command, with the same coefficients that synthesis.c passes it. Samples are processed in place,
+ * with the right channel mixed into them first when mono. The delay lines are read and written in blocks like the DMAs do,
+ * and each vector of 8 samples goes through every filter, first to work out the terms that don't depend on the carry,
+ * then to run the carry down the chain in the accumulator.
+ */
+static void rsp_reverb_samples(s16 *samples, s32 count, const s16 *right, struct ReverbState *state,
+                               s32 filterCount, s32 revIndex, s32 gainIndex) {
+    u16 gainCoef = (0x100 - gainIndex) << 8;
+    s16 gainHalf = gainIndex << 7;
+    u16 revCoef = revIndex << 8;
+    u16 multCoefs[NUM_ALLPASS / 3];
+    s16 terms[NUM_ALLPASS];
+    s16 history[NUM_ALLPASS];
+    s32 blockSize;
+
+    for (s32 k = 0; k < NUM_ALLPASS / 3; k++) {
+        multCoefs[k] = (k < filterCount / 3) ? (state->reverbMults[k] << 8) : 0;
+    }
+
+    for (s32 block = 0; block < count; block += blockSize) {
+        blockSize = MIN(count - block, RSP_BLOCK_SIZE);
+
+        for (s32 n = block; n < block + blockSize; n += RSP_VECTOR_SIZE) {
+            for (s32 lane = n; lane < n + RSP_VECTOR_SIZE; lane++) {
+                s32 offset = lane - block;
+                s16 input = samples[lane];
+                s64 acc;
+
+                if (right != NULL) {
+                    input = rsp_result(rsp_mudm(samples[lane], 0x8000) + rsp_mudm(right[lane], 0x8000));
+                }
+
+                for (s32 i = 0; i < filterCount; i++) {
+                    history[i] = state->delayBufs[i][(state->allpassIdx[i] + offset) % state->delays[i]];
+                    if (i % 3 == 2) {
+                        terms[i] = history[i];
+                    } else {
+                        terms[i] = rsp_result(rsp_mudm(history[i], gainCoef) + rsp_mudh(history[i], -1));
+                    }
+                }
+
+                acc = 0;
+                for (s32 k = 0; k < NUM_ALLPASS / 3; k++) {
+                    acc += rsp_mudh(rsp_result(rsp_mudm((k < filterCount / 3) ? terms[k * 3 + 2] : 0, multCoefs[k])), 1);
+                }
+                samples[lane] = rsp_result(acc);
+
+                acc = rsp_mudm(history[filterCount - 1], revCoef) + rsp_mudh(input, 1);
+                for (s32 i = 0; i < filterCount; i++) {
+                    s16 *delaySample = &state->delayBufs[i][(state->allpassIdx[i] + offset) % state->delays[i]];
+
+                    if (i % 3 == 2) {
+                        *delaySample = rsp_result(acc);
+                        acc = rsp_mudm(history[i], revCoef);
+                    } else {
+                        u16 mid;
+                        s16 high;
+
+                        acc += rsp_mudh(terms[i], 1);
+                        *delaySample = rsp_result(acc);
+                        mid = (u16) (acc >> 16);
+                        high = (s16) (acc >> 32);
+                        acc = rsp_mudn(mid, gainHalf) * 2 + rsp_mudh(high, gainHalf) * 2 + rsp_mudh(history[i], 1);
+                    }
+                }
+            }
+        }
+
+        for (s32 i = 0; i < filterCount; i++) {
+            state->allpassIdx[i] = (state->allpassIdx[i] + blockSize) % state->delays[i];
+        }
+    }
+}
+
+static s32 run_rsp_preset(const struct Preset *preset, const s16 *input, s32 mono) {
+    struct ReverbState refState, rspState;
+    s32 filterCount = preset->filterCount;
+    s16 refIn[FRAME_SAMPLES], refOut[FRAME_SAMPLES];
+    s16 rspSamples[FRAME_SAMPLES];
+    s32 ok = 1;
+
+    init_state(&refState, preset);
+    init_state(&rspState, preset);
+
+    for (s32 frame = 0; frame < NUM_FRAMES && ok; frame++) {
+        const s16 *frameInput = &input[frame * FRAME_SAMPLES];
+        // Mono mixes in the right channel, taken from further along the input.
+        const s16 *rightInput = &input[((frame + NUM_FRAMES / 2) % NUM_FRAMES) * FRAME_SAMPLES];
+
+        for (s32 n = 0; n < FRAME_SAMPLES; n++) {
+            refIn[n] = mono ? ((s32) frameInput[n] + (s32) rightInput[n]) >> 1 : frameInput[n];
+        }
+        reference_reverb_samples(refOut, &refOut[FRAME_SAMPLES], refIn, 1, &refState,
+                                 filterCount - 1, preset->reverbIndex, preset->gainIndex);
+
+        memcpy(rspSamples, frameInput, sizeof(rspSamples));
+        rsp_reverb_samples(rspSamples, FRAME_SAMPLES, mono ? rightInput : NULL, &rspState,
+                           filterCount, preset->reverbIndex, preset->gainIndex);
+
+        if (memcmp(refOut, rspSamples, sizeof(refOut)) != 0 || !states_match(&refState, &rspState, filterCount)) {
+            printf("%-28s RSP model MISMATCH in frame %d (%s)\n", preset->name, frame, mono ? "mono" : "stereo");
+            ok = 0;
+        }
+    }
+
+    if (ok) {
+        printf("%-28s RSP model matches (%s)\n", preset->name, mono ? "mono" : "stereo");
+    }
+
+    free_state(&refState);
+    free_state(&rspState);
+    return ok;
+}
+
+static s32 run_preset(const struct Preset *preset, const s16 *input) {
+    struct ReverbState refState, blockState;
+    s32 filterCount = preset->lightweight ? BETTER_REVERB_FILTER_COUNT_LIGHT : preset->filterCount;
+    s32 lastFilterIndex = filterCount - 1;
+    s32 rate = preset->downsampleRate;
+    s32 frameLen = FRAME_SAMPLES / rate;
+    s16 refIn[FRAME_SAMPLES], blockIn[FRAME_SAMPLES];
+    s16 refOut[FRAME_SAMPLES], blockOut[FRAME_SAMPLES];
+    double refTime = 0.0, blockTime = 0.0, t;
+    s32 ok = 1;
+
+    init_state(&refState, preset);
+    init_state(&blockState, preset);
+
+    for (s32 frame = 0; frame < NUM_FRAMES && ok; frame++) {
+        // Split each frame in two like the ring buffer wrapping around does, at a different point every frame.
+        s32 split = (frame * 37) % (frameLen + 1);
+        const s16 *frameInput = &input[frame * FRAME_SAMPLES];
+
+        memcpy(refIn, frameInput, sizeof(refIn));
+        memcpy(blockIn, frameInput, sizeof(blockIn));
+
+        t = now();
+        for (s32 part = 0; part < 2; part++) {
+            s32 first = part ? split : 0;
+            s32 last = part ? frameLen : split;
+            if (preset->lightweight) {
+                reference_reverb_samples_light(&refOut[first], &refOut[last], &refIn[first * rate], rate, &refState);
+            } else {
+                reference_reverb_samples(&refOut[first], &refOut[last], &refIn[first * rate], rate, &refState,
+                                         lastFilterIndex, preset->reverbIndex, preset->gainIndex);
+            }
+        }
+        refTime += now() - t;
+
+        t = now();
+        for (s32 part = 0; part < 2; part++) {
+            s32 first = part ? split : 0;
+            s32 last = part ? frameLen : split;
+            if (preset->lightweight) {
+                blockState.historySampleLight = reverb_samples_light_block(&blockOut[first], &blockOut[last], &blockIn[first * rate], rate,
+                                                                           blockState.delayBufs, blockState.allpassIdx, blockState.delays,
+                                                                           blockState.historySampleLight);
+            } else {
+                reverb_samples_block(&blockOut[first], &blockOut[last], &blockIn[first * rate], rate,
+                                     blockState.delayBufs, blockState.allpassIdx, blockState.delays, blockState.reverbMults,
+                                     lastFilterIndex, preset->reverbIndex, preset->gainIndex);
+            }
+        }
+        blockTime += now() - t;
+
+        if (memcmp(refOut, blockOut, frameLen * sizeof(s16)) != 0 || !states_match(&refState, &blockState, filterCount)) {
+            printf("%-28s MISMATCH in frame %d\n", preset->name, frame);
+            ok = 0;
+        }
+    }
+
+    if (ok) {
+        printf("%-28s reference %8.1f us/frame, block %8.1f us/frame (%.2fx)\n", preset->name,
+               refTime * 1e6 / NUM_FRAMES, blockTime * 1e6 / NUM_FRAMES, refTime / blockTime);
+    }
+
+    free_state(&refState);
+    free_state(&blockState);
+    return ok;
+}
+
+int main(void) {
+    s16 *input = make_input(NUM_FRAMES * FRAME_SAMPLES);
+    s32 failures = 0;
+
+    for (size_t i = 0; i < sizeof(sPresets) / sizeof(sPresets[0]); i++) {
+        failures += !run_preset(&sPresets[i], input);
+    }
+
+    for (size_t i = 0; i < sizeof(sPresets) / sizeof(sPresets[0]); i++) {
+        if (rsp_supports_preset(&sPresets[i])) {
+            failures += !run_rsp_preset(&sPresets[i], input, 0);
+            failures += !run_rsp_preset(&sPresets[i], input, 1);
+        }
+    }
+
+    free(input);
+    return failures != 0;
+}
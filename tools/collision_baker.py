@@ -0,0 +1,327 @@
+#!/usr/bin/env python3
+# Bakes the static collision of an area into a relocatable surface + spatial partition image.
+#
+# The output mirrors what load_area_terrain builds at runtime from the COL_* data: every surface
+# has its normal, originOffset and lowerY/upperY precomputed, and every cell list is already sorted
+# the same way add_surface_to_cell sorts them. The output is compiled on its own and linked into the
+# bakedCollision segment, which is only in ROM: the loader DMAs the surfaces straight into the static
+# surface pool and links the nodes after them. Special objects and water boxes are still read from the
+# original collision data, which also remains the fallback if the image doesn't match the build.
+import sys
+import re
+import struct
+
+BAKED_COLLISION_VERSION = 1
+
+BAKED_COLLISION_FLAG_NEEDS_SURFACE_FORCE = (1 << 0)
+BAKED_COLLISION_FLAG_HAS_DEGENERATE_TRIS = (1 << 1)
+
+SURFACE_VERTICAL_BUFFER = 5
+
+SPATIAL_PARTITION_FLOORS = 0
+SPATIAL_PARTITION_CEILS  = 1
+SPATIAL_PARTITION_WALLS  = 2
+SPATIAL_PARTITION_WATER  = 3
+
+# Must match surface_has_force and surf_has_no_cam_collision in surface_load.c.
+FORCE_SURFACES = [
+    "SURFACE_0004",
+    "SURFACE_FLOWING_WATER",
+    "SURFACE_DEEP_MOVING_QUICKSAND",
+    "SURFACE_SHALLOW_MOVING_QUICKSAND",
+    "SURFACE_MOVING_QUICKSAND",
+    "SURFACE_HORIZONTAL_WIND",
+    "SURFACE_INSTANT_MOVING_QUICKSAND",
+]
+NO_CAM_COLLISION_SURFACES = [
+    "SURFACE_NO_CAM_COLLISION",
+    "SURFACE_NO_CAM_COLLISION_77",
+    "SURFACE_NO_CAM_COL_VERY_SLIPPERY",
+    "SURFACE_SWITCH",
+]
+NEW_WATER_SURFACES = [
+    "SURFACE_NEW_WATER",
+    "SURFACE_NEW_WATER_BOTTOM",
+]
+
+# LEVEL_BOUNDARY_MAX, CELL_SIZE for each EXTENDED_BOUNDS_MODE in config_world.h.
+EXTENDED_BOUNDS = {
+    0: (0x2000, 0x400),
+    1: (0x4000, 0x400),
+    2: (0x2000, 0x200),
+    3: (0x8000, 0x400),
+}
+
+
+def f32(x):
+    return struct.unpack("f", struct.pack("f", x))[0]
+
+
+def s32(x):
+    return ((x + 0x80000000) & 0xFFFFFFFF) - 0x80000000
+
+
+def strip_comments(text):
+    text = re.sub(r"/\*[\w\W]*?\*/", "", text)
+    return re.sub(r"//[^\n]*", "", text)
+
+
+def read_surface_types(path):
+    """Reads the SurfaceTypes enum so that surface types can be given by name or by value."""
+    with open(path, "r") as file:
+        text = strip_comments(file.read())
+
+    body = re.search(r"enum\s+SurfaceTypes\s*{([\w\W]*?)}", text).group(1)
+    types = {}
+    value = -1
+    for entry in body.split(","):
+        entry = entry.strip()
+        if not entry:
+            continue
+        if "=" in entry:
+            name, expr = [s.strip() for s in entry.split("=")]
+            value = int(expr, 0)
+        else:
+            name = entry
+            value += 1
+        types[name] = value
+    return types
+
+
+def read_extended_bounds_mode(path):
+    with open(path, "r") as file:
+        text = strip_comments(file.read())
+    return int(re.search(r"#\s*define\s+EXTENDED_BOUNDS_MODE\s+(\d+)", text).group(1))
+
+
+def read_collision_arrays(path):
+    """Returns every `const Collision name[] = { ... };` in the file as (name, [(macro, [args])])."""
+    with open(path, "r") as file:
+        text = strip_comments(file.read())
+
+    arrays = []
+    for match in re.finditer(r"Collision\s+(\w+)\s*\[\s*\]\s*=\s*{([\w\W]*?)}\s*;", text):
+        commands = []
+        for cmd in re.finditer(r"(\w+)\s*\(([^()]*)\)", match.group(2)):
+            args = [a.strip() for a in cmd.group(2).split(",") if a.strip()]
+            commands.append((cmd.group(1), args))
+        arrays.append((match.group(1), commands))
+    return arrays
+
+
+class Surface:
+    pass
+
+
+def read_surface(verts, indices):
+    v = [verts[i] for i in indices]
+
+    # find_vector_perpendicular_to_plane, done in integer math then converted to f32.
+    a, b, c = v
+    n = [
+        f32(s32((b[1] - a[1]) * (c[2] - b[2]) - (c[1] - b[1]) * (b[2] - a[2]))),
+        f32(s32((b[2] - a[2]) * (c[0] - b[0]) - (c[2] - b[2]) * (b[0] - a[0]))),
+        f32(s32((b[0] - a[0]) * (c[1] - b[1]) - (c[0] - b[0]) * (b[1] - a[1]))),
+    ]
+
+    mag = f32(f32(f32(n[0] * n[0]) + f32(n[1] * n[1])) + f32(n[2] * n[2]))
+    if mag == 0.0:
+        return None
+    mag = f32(1.0 / f32(mag ** 0.5))
+    n = [f32(x * mag) for x in n]
+
+    surf = Surface()
+    surf.vertices = v
+    surf.normal = n
+    surf.originOffset = -f32(f32(f32(n[0] * v[0][0]) + f32(n[1] * v[0][1])) + f32(n[2] * v[0][2]))
+    surf.lowerY = min(p[1] for p in v) - SURFACE_VERTICAL_BUFFER
+    surf.upperY = max(p[1] for p in v) + SURFACE_VERTICAL_BUFFER
+    return surf
+
+
+def bake(commands, surfaceTypes):
+    verts = []
+    surfaces = []
+    flags = 0
+    numTris = 0
+    typeName = None
+
+    for macro, args in commands:
+        if macro == "COL_VERTEX":
+            verts.append([int(a, 0) for a in args])
+        elif macro == "COL_TRI_INIT":
+            typeName = args[0]
+            if typeName not in surfaceTypes:
+                # Given as a raw value, use the enum name if there is one so the output stays readable.
+                value = int(typeName, 0)
+                typeName = next((k for k, v in surfaceTypes.items() if v == value), typeName)
+        elif macro in ("COL_TRI", "COL_TRI_SPECIAL"):
+            isSpecial = (macro == "COL_TRI_SPECIAL")
+            hasForce = typeName in FORCE_SURFACES
+            # Without ALL_SURFACES_HAVE_FORCE the runtime reads a force parameter only for force types,
+            # so any other combination only loads correctly with it enabled.
+            if isSpecial != hasForce:
+                flags |= BAKED_COLLISION_FLAG_NEEDS_SURFACE_FORCE
+
+            surf = read_surface(verts, [int(a, 0) for a in args[:3]])
+            numTris += 1
+            if surf is None:
+                flags |= BAKED_COLLISION_FLAG_HAS_DEGENERATE_TRIS
+                continue
+
+            surf.tri = numTris - 1
+            surf.typeName = typeName
+            surf.force = args[3] if isSpecial else "0"
+            surf.flags = "SURFACE_FLAG_NO_CAM_COLLISION" if typeName in NO_CAM_COLLISION_SURFACES else "SURFACE_FLAGS_NONE"
+            surfaces.append(surf)
+        elif macro == "COL_END":
+            break
+
+    return surfaces, numTris, flags
+
+
+def partition_surfaces(surfaces, levelBoundaryMax, cellSize):
+    numCells = 2 * levelBoundaryMax // cellSize
+    floorThreshold = f32(0.01)
+    cells = {}
+
+    def cell_index(coord):
+        return max(0, coord + levelBoundaryMax) // cellSize
+
+    for index, surf in enumerate(surfaces):
+        if surf.typeName in NEW_WATER_SURFACES:
+            partition, sortDir = SPATIAL_PARTITION_WATER, 1
+        elif surf.normal[1] > floorThreshold:
+            partition, sortDir = SPATIAL_PARTITION_FLOORS, 1
+        elif surf.normal[1] < -floorThreshold:
+            partition, sortDir = SPATIAL_PARTITION_CEILS, -1
+        else:
+            partition, sortDir = SPATIAL_PARTITION_WALLS, 0
+
+        xs = [p[0] for p in surf.vertices]
+        zs = [p[2] for p in surf.vertices]
+        minCellX = cell_index(min(xs))
+        maxCellX = min(numCells - 1, cell_index(max(xs)))
+        minCellZ = cell_index(min(zs))
+        maxCellZ = min(numCells - 1, cell_index(max(zs)))
+
+        for cellZ in range(minCellZ, maxCellZ + 1):
+            for cellX in range(minCellX, maxCellX + 1):
+                cells.setdefault((cellZ, cellX, partition), []).append((surf.upperY * sortDir, index))
+
+    lists = []
+    for key in sorted(cells):
+        # add_surface_to_cell inserts after every surface of equal or higher priority,
+        # which is a stable sort from highest to lowest priority.
+        nodes = [index for priority, index in sorted(cells[key], key=lambda node: -node[0])]
+        lists.append((key, nodes))
+    return numCells, lists
+
+
+def format_float(x):
+    return re.sub(r"\.?0+p", "p", x.hex()) + "f"
+
+
+def emit(name, source, surfaces, numTris, flags, numCells, cellSize, lists):
+    out = []
+    out.append("// Generated by tools/collision_baker.py from %s, do not edit." % source)
+    out.append("#include <ultra64.h>")
+    out.append("#include \"sm64.h\"")
+    out.append("")
+    out.append("#ifdef BAKED_STATIC_COLLISION")
+    # Every array is DMA'd on its own, and dma_read transfers whole 16 byte blocks.
+
+    out.append("static const struct Surface %s_baked_surfaces[] ALIGNED16 = {" % name)
+    for s in surfaces:
+        out.append("    { %s, %s, %s, 0, %d, %d, { %s }, { %s }, { %s }, { %s }, %s, NULL }," % (
+            s.typeName, s.force, s.flags, s.lowerY, s.upperY,
+            ", ".join(str(c) for c in s.vertices[0]),
+            ", ".join(str(c) for c in s.vertices[1]),
+            ", ".join(str(c) for c in s.vertices[2]),
+            ", ".join(format_float(c) for c in s.normal),
+            format_float(s.originOffset)))
+    out.append("};")
+
+    out.append("static const u16 %s_baked_surface_tris[] ALIGNED16 = {" % name)
+    for i in range(0, len(surfaces), 16):
+        out.append("    " + " ".join("%d," % s.tri for s in surfaces[i:i + 16]))
+    out.append("};")
+
+    numNodes = 0
+    out.append("static const struct BakedSurfaceList %s_baked_lists[] ALIGNED16 = {" % name)
+    for (cellZ, cellX, partition), nodes in lists:
+        out.append("    { %d, %d, %d, %d, %d }," % (cellX, cellZ, partition, len(nodes), numNodes))
+        numNodes += len(nodes)
+    out.append("};")
+
+    out.append("static const u16 %s_baked_nodes[] ALIGNED16 = {" % name)
+    for key, nodes in lists:
+        for i in range(0, len(nodes), 16):
+            out.append("    " + " ".join("%d," % n for n in nodes[i:i + 16]))
+    out.append("};")
+
+    out.append("const struct BakedCollision %s_baked ALIGNED16 = {" % name)
+    out.append("    /*version    */ %d," % BAKED_COLLISION_VERSION)
+    out.append("    /*flags      */ 0x%X," % flags)
+    out.append("    /*cellSize   */ %d," % cellSize)
+    out.append("    /*numCells   */ %d," % numCells)
+    out.append("    /*numTris    */ %d," % numTris)
+    out.append("    /*numSurfaces*/ %d," % len(surfaces))
+    out.append("    /*numLists   */ %d," % len(lists))
+    out.append("    /*numNodes   */ %d," % numNodes)
+    out.append("    /*surfaces   */ %s_baked_surfaces," % name)
+    out.append("    /*surfaceTris*/ %s_baked_surface_tris," % name)
+    out.append("    /*lists      */ %s_baked_lists," % name)
+    out.append("    /*nodes      */ %s_baked_nodes," % name)
+    out.append("};")
+    out.append("#endif")
+    return "\n".join(out) + "\n"
+
+
+def main():
+    need_help = False
+    prog_args = []
+    arrayName = None
+    boundsMode = None
+    args = iter(sys.argv[1:])
+    for a in args:
+        if a == "--help" or a == "-h":
+            need_help = True
+        elif a == "--array":
+            arrayName = next(args)
+        elif a == "--bounds-mode":
+            boundsMode = int(next(args))
+        else:
+            prog_args.append(a)
+
+    if len(prog_args) < 2 or need_help:
+        print("Usage: {} <collision.inc.c> <collision.baked.c> [--array <name>] [--bounds-mode <0-3>]".format(sys.argv[0]))
+        print("Bakes the first collision array in the file unless --array is given.")
+        print("The extended bounds mode is read from include/config/config_world.h unless --bounds-mode is given.")
+        sys.exit(0 if need_help else 1)
+
+    if boundsMode is None:
+        boundsMode = read_extended_bounds_mode("include/config/config_world.h")
+    levelBoundaryMax, cellSize = EXTENDED_BOUNDS[boundsMode]
+    surfaceTypes = read_surface_types("include/surface_terrains.h")
+
+    arrays = read_collision_arrays(prog_args[0])
+    if arrayName is not None:
+        arrays = [a for a in arrays if a[0] == arrayName]
+    if len(arrays) == 0:
+        print("{}: no collision array found in {}".format(sys.argv[0], prog_args[0]), file=sys.stderr)
+        sys.exit(1)
+    name, commands = arrays[0]
+
+    surfaces, numTris, flags = bake(commands, surfaceTypes)
+    if numTris > 0xFFFF:
+        print("{}: {} has too many surfaces to bake".format(sys.argv[0], name), file=sys.stderr)
+        sys.exit(1)
+    numCells, lists = partition_surfaces(surfaces, levelBoundaryMax, cellSize)
+
+    with open(prog_args[1], "w") as file:
+        file.write(emit(name, prog_args[0], surfaces, numTris, flags, numCells, cellSize, lists))
+
+
+if __name__ == "__main__":
+    main()
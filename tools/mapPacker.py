@@ -1,17 +1,26 @@
 import sys, struct, subprocess
 
+# Packs the text symbols of an ELF for the crash screen's stack trace.
+#
+# addr.bin:   one 8 byte entry per symbol, sorted by address: (address, offset of its name in name.bin)
+# name.bin:   the null terminated names
+# bucket.bin: base address and bucket count, followed by the index of the first symbol at or above
+#             each (1 << MAP_BUCKET_SHIFT) byte bucket from the base (plus one past the last bucket), so a
+#             lookup only has to binary search the symbols of a single bucket
+
+MAP_BUCKET_SHIFT = 12 # Must match map_parser.c
+
 class MapEntry():
 	def __init__(self, nm, addr):
 		self.name = nm
 		self.addr = addr
-		self.strlen = (len(nm) + 4) & (~3)
 	def __str__(self):
-		return "%s %s %d" % (self.addr, self.name, self.strlen)
+		return "%s %s" % (self.addr, self.name)
 	def __repr__(self):
-		return "%s %s %d" % (self.addr, self.name, self.strlen)
+		return "%s %s" % (self.addr, self.name)
 
 
-structDef = ">LLLL"
+structDef = ">LL"
 
 symNames = []
 
@@ -33,18 +42,32 @@ for line in symbols:
 
 f1 = open(sys.argv[2], "wb+")
 f2 = open(sys.argv[3], "wb+")
+f3 = open(sys.argv[4], "wb+")
 
 symNames.sort(key=lambda x: x.addr)
 
 off = 0
 for x in symNames:
-	f1.write(struct.pack(structDef, x.addr, off, len(x.name), 0))
-	f2.write(struct.pack(">%ds" % x.strlen, bytes(x.name, encoding="ascii")))
-	off += x.strlen
+	name = bytes(x.name, encoding="ascii") + b"\0"
+	f1.write(struct.pack(structDef, x.addr, off))
+	f2.write(name)
+	off += len(name)
+
+if len(symNames) > 0xFFFF:
+	sys.exit("mapPacker.py: too many symbols for the bucket index")
+
+base = (symNames[0].addr >> MAP_BUCKET_SHIFT) << MAP_BUCKET_SHIFT if symNames else 0
+numBuckets = ((symNames[-1].addr - base) >> MAP_BUCKET_SHIFT) + 1 if symNames else 0
+f3.write(struct.pack(">LL", base, numBuckets))
+i = 0
+for bucket in range(numBuckets + 1):
+	while i < len(symNames) and symNames[i].addr < base + (bucket << MAP_BUCKET_SHIFT):
+		i += 1
+	f3.write(struct.pack(">H", i))
 
 
 f1.close()
 f2.close()
+f3.close()
 
 # print('\n'.join([str(hex(x.addr)) + " " + x.name for x in symNames]))
-
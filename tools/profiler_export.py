@@ -0,0 +1,207 @@
+#!/usr/bin/env python3
+# Decodes the profiler stream sent by PROFILER_EXPORT into CSV and flamegraph folded stacks.
+#
+# Takes either the raw binaries UNFLoader saves from UNF builds, or emulator logs from ISVPRINT
+# builds, where the stream is printed as hex on lines starting with "PRF ". Everything is big
+# endian. A batch starts with a schema chunk:
+#   u32 "PRFS", u8 version, u8 category count, u16 chunk size, then for each category a u8 group
+#   and a null terminated name, padded to 4 bytes.
+# followed by one chunk per frame:
+#   u32 "PRFR", u32 frame, u16 object count, u16 pad, u32 gfx pool bytes used, u32 count per category.
+# and, in builds with PROFILER_BEHAVIORS, a behavior chunk at the end of the batch:
+#   u32 "PRFB", u32 frame, u16 chunk size, u16 behavior count, then for each behavior a u32 average
+#   CPU counter ticks per frame, a u16 average count per frame and a null terminated name, padded
+#   to 4 bytes. The averages are over the last 64 frames.
+import sys
+import struct
+
+SUPPORTED_VERSIONS = (1, 2)
+
+MAGIC_SCHEMA = 0x50524653
+MAGIC_FRAME = 0x50524652
+MAGIC_BEHAVIORS = 0x50524642
+
+# Must match enum ProfilerExportGroup in src/game/profiler_export.h.
+GROUP_FRAME = 0
+GROUP_GAME = 1
+GROUP_AUDIO = 2
+GROUP_AUDIO_DETAIL = 3
+GROUP_RSP = 4
+GROUP_RSP_AUDIO = 5
+GROUP_RDP = 6
+
+CPU_COUNTER_TICKS_PER_US = 46.875
+RDP_CLOCKS_PER_US = 62.5
+
+
+class Category:
+    def __init__(self, group, name):
+        self.group = group
+        self.name = name
+
+    def to_microseconds(self, count):
+        return count / (RDP_CLOCKS_PER_US if self.group == GROUP_RDP else CPU_COUNTER_TICKS_PER_US)
+
+
+def read_stream(path):
+    """Returns the bytes of the stream in a file, from either a raw binary or a text log."""
+    with open(path, "rb") as file:
+        data = file.read()
+
+    if b"PRF " not in data:
+        return data
+
+    out = bytearray()
+    for line in data.decode("ascii", "replace").splitlines():
+        pos = line.find("PRF ")
+        if pos >= 0:
+            out += bytes.fromhex(line[pos + 4:].strip())
+    return bytes(out)
+
+
+def decode(data):
+    """Returns a list of (categories, frame, objects, gfxPoolUsed, counts) for every frame in the stream,
+    and a list of (frame, name, ticks, count) for every behavior sample."""
+    frames = []
+    behaviors = []
+    categories = None
+    pos = 0
+    while pos + 4 <= len(data):
+        magic, = struct.unpack_from(">I", data, pos)
+        if magic == MAGIC_SCHEMA:
+            version, count, size = struct.unpack_from(">BBH", data, pos + 4)
+            if version not in SUPPORTED_VERSIONS:
+                raise ValueError("unsupported profiler export version %d" % version)
+            categories = []
+            namePos = pos + 8
+            for _ in range(count):
+                end = data.index(b"\0", namePos + 1)
+                categories.append(Category(data[namePos], data[namePos + 1:end].decode("ascii")))
+                namePos = end + 1
+            pos += size
+        elif magic == MAGIC_FRAME and categories is not None:
+            frame, objects, _, gfxPoolUsed = struct.unpack_from(">IHHI", data, pos + 4)
+            counts = struct.unpack_from(">%dI" % len(categories), data, pos + 16)
+            frames.append((categories, frame, objects, gfxPoolUsed, counts))
+            pos += 16 + 4 * len(categories)
+        elif magic == MAGIC_BEHAVIORS:
+            frame, size, count = struct.unpack_from(">IHH", data, pos + 4)
+            entryPos = pos + 12
+            for _ in range(count):
+                ticks, instances = struct.unpack_from(">IH", data, entryPos)
+                end = data.index(b"\0", entryPos + 6)
+                behaviors.append((frame, data[entryPos + 6:end].decode("ascii"), ticks, instances))
+                entryPos = pos + ((end + 1 - pos + 3) & ~3)
+            pos += size
+        else:
+            # Lost sync, for example after a dropped line; skip ahead to the next chunk.
+            pos += 4
+
+    return frames, behaviors
+
+
+def category_names(categories):
+    return [c.name if c.name else "category%d" % i for i, c in enumerate(categories)]
+
+
+def write_csv(file, frames):
+    header = None
+    for categories, frame, objects, gfxPoolUsed, counts in frames:
+        names = category_names(categories)
+        if names != header:
+            header = names
+            file.write(",".join(["frame", "objects", "gfx_pool_bytes"] + [n + "_us" for n in names]) + "\n")
+        values = ["%.1f" % c.to_microseconds(v) for c, v in zip(categories, counts)]
+        file.write(",".join([str(frame), str(objects), str(gfxPoolUsed)] + values) + "\n")
+
+
+def write_folded(file, frames):
+    """Writes microseconds summed over all frames as folded stacks, for flamegraph.pl or speedscope."""
+    totals = {}
+
+    def add(stack, us):
+        if us > 0:
+            totals[stack] = totals.get(stack, 0.0) + us
+
+    for categories, frame, objects, gfxPoolUsed, counts in frames:
+        names = category_names(categories)
+        gameTotal = 0.0
+        gameParts = 0.0
+        for c, name, v in zip(categories, names, counts):
+            us = c.to_microseconds(v)
+            if c.group == GROUP_GAME:
+                add("cpu;game;" + name, us)
+                gameParts += us
+            elif c.group == GROUP_AUDIO:
+                add("cpu;" + name, us * 2)
+            elif c.group == GROUP_RSP:
+                add("rsp;" + name, us)
+            elif c.group == GROUP_RSP_AUDIO:
+                add("rsp;" + name, us * 2)
+            elif c.group == GROUP_FRAME and name == "game":
+                gameTotal = us
+        add("cpu;game;other", gameTotal - gameParts)
+
+    for stack in sorted(totals):
+        file.write("%s %d\n" % (stack, round(totals[stack])))
+
+
+def write_behaviors(file, behaviors):
+    """Writes one row per behavior per batch, slowest first."""
+    file.write("frame,behavior,us,count,us_each\n")
+    for frame, name, ticks, count in sorted(behaviors, key=lambda b: (b[0], -b[2])):
+        us = ticks / CPU_COUNTER_TICKS_PER_US
+        file.write("%d,%s,%.1f,%d,%.1f\n" % (frame, name, us, count, us / max(count, 1)))
+
+
+def main():
+    need_help = False
+    prog_args = []
+    csvPath = None
+    foldedPath = None
+    behaviorsPath = None
+    args = iter(sys.argv[1:])
+    for a in args:
+        if a == "--help" or a == "-h":
+            need_help = True
+        elif a == "--csv":
+            csvPath = next(args)
+        elif a == "--folded":
+            foldedPath = next(args)
+        elif a == "--behaviors":
+            behaviorsPath = next(args)
+        else:
+            prog_args.append(a)
+
+    if len(prog_args) < 1 or need_help:
+        print("Usage: {} <capture>... [--csv <out.csv>] [--folded <out.folded>] [--behaviors <out.csv>]".format(sys.argv[0]))
+        print("Captures are UNFLoader binaries or ISV logs, decoded in the order given.")
+        print("Writes one CSV row per frame, in microseconds, to --csv or stdout. Audio and RSP audio")
+        print("columns are a single update, which runs twice per frame. --folded writes the time of")
+        print("all frames as folded stacks for flamegraph.pl. --behaviors writes the average time and")
+        print("count of each behavior sent by PROFILER_BEHAVIORS builds, per batch.")
+        sys.exit(0 if need_help else 1)
+
+    data = b"".join(read_stream(path) for path in prog_args)
+    frames, behaviors = decode(data)
+    if len(frames) == 0:
+        print("{}: no profiler records found".format(sys.argv[0]), file=sys.stderr)
+        sys.exit(1)
+
+    if csvPath is None:
+        write_csv(sys.stdout, frames)
+    else:
+        with open(csvPath, "w") as file:
+            write_csv(file, frames)
+
+    if foldedPath is not None:
+        with open(foldedPath, "w") as file:
+            write_folded(file, frames)
+
+    if behaviorsPath is not None:
+        with open(behaviorsPath, "w") as file:
+            write_behaviors(file, behaviors)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,278 @@
+#!/usr/bin/env python3
+# Generates the potentially visible set of a roomed area from its collision and surface rooms.
+#
+# Every room gets a handful of eye points above its floors and target points in front of its
+# surfaces. Room B is visible from room A when any segment between an eye point of A and a point
+# of B isn't blocked by the area's collision. Rooms sharing a vertex can always see each other,
+# and the result is grown by --dilate steps through those neighbors, so that geometry without
+# collision (windows, railings) or a camera a bit outside of Mario's room doesn't pop rooms in.
+import sys
+import re
+import os
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from collision_baker import strip_comments, read_collision_arrays, read_surface_types, bake
+
+EYE_HEIGHT = 160
+TARGET_OFFSET = 8
+GRID_CELL_SIZE = 256
+FLOOR_NORMAL_Y = 0.5
+EPSILON = 1e-4
+
+
+def read_rooms(path, arrayName=None):
+    """Returns (name, [room]) for the first `RoomData name[] = { ... };` in the file, or the one named arrayName."""
+    with open(path, "r") as file:
+        text = strip_comments(file.read())
+
+    for match in re.finditer(r"RoomData\s+(\w+)\s*\[\s*\]\s*=\s*{([\w\W]*?)}\s*;", text):
+        if arrayName is None or match.group(1) == arrayName:
+            return match.group(1), [int(v, 0) for v in match.group(2).split(",") if v.strip()]
+    return None, None
+
+
+def sub(a, b):
+    return (a[0] - b[0], a[1] - b[1], a[2] - b[2])
+
+
+def cross(a, b):
+    return (a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0])
+
+
+def dot(a, b):
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2]
+
+
+def centroid(verts, weights=(1, 1, 1)):
+    total = sum(weights)
+    return tuple(sum(v[i] * w for v, w in zip(verts, weights)) / total for i in range(3))
+
+
+def spread_points(points, count):
+    """Picks up to count points that are spread out over the set, by farthest point sampling."""
+    if len(points) <= count:
+        return points
+    picked = [points[0]]
+    dists = [dot(sub(p, points[0]), sub(p, points[0])) for p in points]
+    while len(picked) < count:
+        i = max(range(len(points)), key=lambda j: dists[j])
+        picked.append(points[i])
+        for j, p in enumerate(points):
+            d = sub(p, points[i])
+            dists[j] = min(dists[j], dot(d, d))
+    return picked
+
+
+class Occluders:
+    """The area's triangles, bucketed into a uniform grid for segment queries."""
+
+    def __init__(self, surfaces):
+        self.tris = [tuple(tuple(float(c) for c in v) for v in s.vertices) for s in surfaces]
+        self.cells = {}
+        for i, tri in enumerate(self.tris):
+            lo = [int(min(v[k] for v in tri) // GRID_CELL_SIZE) for k in range(3)]
+            hi = [int(max(v[k] for v in tri) // GRID_CELL_SIZE) for k in range(3)]
+            for x in range(lo[0], hi[0] + 1):
+                for y in range(lo[1], hi[1] + 1):
+                    for z in range(lo[2], hi[2] + 1):
+                        self.cells.setdefault((x, y, z), []).append(i)
+
+    def segment_cells(self, a, b):
+        """Walks the grid cells crossed by the segment from a to b (3D DDA)."""
+        d = sub(b, a)
+        cell = [int(a[k] // GRID_CELL_SIZE) for k in range(3)]
+        end = [int(b[k] // GRID_CELL_SIZE) for k in range(3)]
+        step, tMax, tDelta = [0] * 3, [float("inf")] * 3, [float("inf")] * 3
+        for k in range(3):
+            if d[k] > 0:
+                step[k] = 1
+                tMax[k] = ((cell[k] + 1) * GRID_CELL_SIZE - a[k]) / d[k]
+                tDelta[k] = GRID_CELL_SIZE / d[k]
+            elif d[k] < 0:
+                step[k] = -1
+                tMax[k] = (cell[k] * GRID_CELL_SIZE - a[k]) / d[k]
+                tDelta[k] = -GRID_CELL_SIZE / d[k]
+
+        yield tuple(cell)
+        while cell != end:
+            k = min(range(3), key=lambda i: tMax[i])
+            if tMax[k] > 1.0:
+                break
+            cell[k] += step[k]
+            tMax[k] += tDelta[k]
+            yield tuple(cell)
+
+    def blocked(self, a, b):
+        d = sub(b, a)
+        tested = set()
+        for cell in self.segment_cells(a, b):
+            for i in self.cells.get(cell, ()):
+                if i in tested:
+                    continue
+                tested.add(i)
+                if self.segment_hits(a, d, self.tris[i]):
+                    return True
+        return False
+
+    @staticmethod
+    def segment_hits(origin, d, tri):
+        # Moller-Trumbore, only counting hits strictly between the end points.
+        e1 = sub(tri[1], tri[0])
+        e2 = sub(tri[2], tri[0])
+        p = cross(d, e2)
+        det = dot(e1, p)
+        if abs(det) < EPSILON:
+            return False
+        inv = 1.0 / det
+        s = sub(origin, tri[0])
+        u = dot(s, p) * inv
+        if u < 0.0 or u > 1.0:
+            return False
+        q = cross(s, e1)
+        v = dot(d, q) * inv
+        if v < 0.0 or u + v > 1.0:
+            return False
+        t = dot(e2, q) * inv
+        return EPSILON < t < 1.0 - EPSILON
+
+
+def room_points(surfaces, rooms, numSamples):
+    """Returns the eye points and target points of every room."""
+    eyes, targets = {}, {}
+    for s in surfaces:
+        room = rooms[s.tri] if s.tri < len(rooms) else 0
+        if room <= 0:
+            continue
+        v = s.vertices
+        n = s.normal
+        for w in ((1, 1, 1), (4, 1, 1), (1, 4, 1), (1, 1, 4)):
+            c = centroid(v, w)
+            targets.setdefault(room, []).append(tuple(c[k] + n[k] * TARGET_OFFSET for k in range(3)))
+            if n[1] >= FLOOR_NORMAL_Y:
+                eyes.setdefault(room, []).append((c[0], c[1] + EYE_HEIGHT, c[2]))
+
+    for room in targets:
+        # Rooms without floors are seen from in front of their surfaces instead.
+        eyes[room] = spread_points(eyes.get(room, targets[room]), numSamples)
+        targets[room] = spread_points(targets[room] + eyes[room], numSamples)
+    return eyes, targets
+
+
+def adjacent_rooms(surfaces, rooms):
+    """Returns the rooms that share a vertex with each room."""
+    vertexRooms = {}
+    for s in surfaces:
+        room = rooms[s.tri] if s.tri < len(rooms) else 0
+        if room > 0:
+            for v in s.vertices:
+                vertexRooms.setdefault(tuple(v), set()).add(room)
+
+    adjacency = {}
+    for shared in vertexRooms.values():
+        for room in shared:
+            adjacency.setdefault(room, set()).update(shared)
+    return adjacency
+
+
+def compute_visibility(surfaces, rooms, numSamples, dilate):
+    occluders = Occluders(surfaces)
+    eyes, targets = room_points(surfaces, rooms, numSamples)
+    adjacency = adjacent_rooms(surfaces, rooms)
+    roomIds = sorted(targets)
+
+    visible = {room: set([room]) | adjacency.get(room, set()) for room in roomIds}
+    for i, a in enumerate(roomIds):
+        for b in roomIds[i + 1:]:
+            if b in visible[a]:
+                continue
+            if any(not occluders.blocked(e, t) for e in eyes[a] for t in targets[b]) \
+               or any(not occluders.blocked(e, t) for e in eyes[b] for t in targets[a]):
+                visible[a].add(b)
+                visible[b].add(a)
+
+    for _ in range(dilate):
+        # The camera can be in a room next to the one it's looking from, so a room also sees everything its
+        # neighbors see. Seeing is mutual, so whatever a room gains also sees the room back.
+        dilated = {room: set().union(*(visible.get(n, set()) for n in adjacency.get(room, set()) | set([room])))
+                   for room in visible}
+        for a in list(dilated):
+            for b in list(dilated[a]):
+                dilated.setdefault(b, set([b])).add(a)
+        visible = dilated
+    return visible
+
+
+def emit(name, source, numRooms, visible):
+    wordsPerRoom = (numRooms + 1 + 31) // 32
+    out = []
+    out.append("// Generated by tools/room_pvs.py from %s, do not edit." % source)
+    out.append("#ifdef ROOM_VISIBILITY")
+    # Room 0 (surfaces without a room) sees and is seen from everything, like in is_room_visible_from.
+    rows = [set(range(numRooms + 1)) if room == 0 else visible.get(room, set([room])) | set([0])
+            for room in range(numRooms + 1)]
+    assert all(a in rows[b] for a in range(numRooms + 1) for b in rows[a]), "room visibility is not symmetric"
+
+    out.append("static const u32 %s_visibility_masks[] = {" % name)
+    for room, seen in enumerate(rows):
+        words = [0] * wordsPerRoom
+        for r in seen:
+            words[r >> 5] |= 1 << (r & 0x1F)
+        out.append("    %s // %d" % (" ".join("0x%08X," % w for w in words), room))
+    out.append("};")
+
+    out.append("const struct RoomVisibility %s_visibility = {" % name)
+    out.append("    /*numRooms    */ %d," % numRooms)
+    out.append("    /*wordsPerRoom*/ %d," % wordsPerRoom)
+    out.append("    /*masks       */ %s_visibility_masks," % name)
+    out.append("};")
+    out.append("#endif")
+    return "\n".join(out) + "\n"
+
+
+def main():
+    need_help = False
+    prog_args = []
+    arrayName = None
+    roomsName = None
+    numSamples = 12
+    dilate = 1
+    args = iter(sys.argv[1:])
+    for a in args:
+        if a == "--help" or a == "-h":
+            need_help = True
+        elif a == "--array":
+            arrayName = next(args)
+        elif a == "--rooms":
+            roomsName = next(args)
+        elif a == "--samples":
+            numSamples = int(next(args))
+        elif a == "--dilate":
+            dilate = int(next(args))
+        else:
+            prog_args.append(a)
+
+    if len(prog_args) < 3 or need_help:
+        print("Usage: {} <collision.inc.c> <room.inc.c> <room.pvs.inc.c> [--array <name>] [--rooms <name>] [--samples <n>] [--dilate <n>]".format(sys.argv[0]))
+        print("Uses the first collision and room arrays in the files unless --array or --rooms is given.")
+        print("Each room is sampled at up to --samples points (default 12), and visibility is grown through")
+        print("neighboring rooms --dilate times (default 1).")
+        sys.exit(0 if need_help else 1)
+
+    arrays = read_collision_arrays(prog_args[0])
+    if arrayName is not None:
+        arrays = [a for a in arrays if a[0] == arrayName]
+    name, rooms = read_rooms(prog_args[1], roomsName)
+    if len(arrays) == 0 or rooms is None:
+        print("{}: no collision or room array found in {} and {}".format(sys.argv[0], prog_args[0], prog_args[1]), file=sys.stderr)
+        sys.exit(1)
+
+    surfaces, numTris, flags = bake(arrays[0][1], read_surface_types("include/surface_terrains.h"))
+    numRooms = max(rooms + [0])
+    visible = compute_visibility(surfaces, rooms, numSamples, dilate)
+
+    with open(prog_args[2], "w") as file:
+        file.write(emit(name, prog_args[1], numRooms, visible))
+
+
+if __name__ == "__main__":
+    main()